@@ -0,0 +1,13 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("third-party/libzip-1.4.0")
+subdirs("logger")
+subdirs("piel")
+subdirs("commands")
+subdirs("pie")
+subdirs("depman")
+subdirs("tests")
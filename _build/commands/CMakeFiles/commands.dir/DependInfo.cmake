@@ -0,0 +1,41 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/commands/checkout.cpp" "commands/CMakeFiles/commands.dir/checkout.cpp.o" "gcc" "commands/CMakeFiles/commands.dir/checkout.cpp.o.d"
+  "/root/repo/commands/clean.cpp" "commands/CMakeFiles/commands.dir/clean.cpp.o" "gcc" "commands/CMakeFiles/commands.dir/clean.cpp.o.d"
+  "/root/repo/commands/command.cpp" "commands/CMakeFiles/commands.dir/command.cpp.o" "gcc" "commands/CMakeFiles/commands.dir/command.cpp.o.d"
+  "/root/repo/commands/commit.cpp" "commands/CMakeFiles/commands.dir/commit.cpp.o" "gcc" "commands/CMakeFiles/commands.dir/commit.cpp.o.d"
+  "/root/repo/commands/create.cpp" "commands/CMakeFiles/commands.dir/create.cpp.o" "gcc" "commands/CMakeFiles/commands.dir/create.cpp.o.d"
+  "/root/repo/commands/destroy.cpp" "commands/CMakeFiles/commands.dir/destroy.cpp.o" "gcc" "commands/CMakeFiles/commands.dir/destroy.cpp.o.d"
+  "/root/repo/commands/diff.cpp" "commands/CMakeFiles/commands.dir/diff.cpp.o" "gcc" "commands/CMakeFiles/commands.dir/diff.cpp.o.d"
+  "/root/repo/commands/gavc.cpp" "commands/CMakeFiles/commands.dir/gavc.cpp.o" "gcc" "commands/CMakeFiles/commands.dir/gavc.cpp.o.d"
+  "/root/repo/commands/gavccache.cpp" "commands/CMakeFiles/commands.dir/gavccache.cpp.o" "gcc" "commands/CMakeFiles/commands.dir/gavccache.cpp.o.d"
+  "/root/repo/commands/gavccacheclean.cpp" "commands/CMakeFiles/commands.dir/gavccacheclean.cpp.o" "gcc" "commands/CMakeFiles/commands.dir/gavccacheclean.cpp.o.d"
+  "/root/repo/commands/gavccacheinit.cpp" "commands/CMakeFiles/commands.dir/gavccacheinit.cpp.o" "gcc" "commands/CMakeFiles/commands.dir/gavccacheinit.cpp.o.d"
+  "/root/repo/commands/gavcconstants.cpp" "commands/CMakeFiles/commands.dir/gavcconstants.cpp.o" "gcc" "commands/CMakeFiles/commands.dir/gavcconstants.cpp.o.d"
+  "/root/repo/commands/iobjectsstoragecommand.cpp" "commands/CMakeFiles/commands.dir/iobjectsstoragecommand.cpp.o" "gcc" "commands/CMakeFiles/commands.dir/iobjectsstoragecommand.cpp.o.d"
+  "/root/repo/commands/log.cpp" "commands/CMakeFiles/commands.dir/log.cpp.o" "gcc" "commands/CMakeFiles/commands.dir/log.cpp.o.d"
+  "/root/repo/commands/pull.cpp" "commands/CMakeFiles/commands.dir/pull.cpp.o" "gcc" "commands/CMakeFiles/commands.dir/pull.cpp.o.d"
+  "/root/repo/commands/push.cpp" "commands/CMakeFiles/commands.dir/push.cpp.o" "gcc" "commands/CMakeFiles/commands.dir/push.cpp.o.d"
+  "/root/repo/commands/reset.cpp" "commands/CMakeFiles/commands.dir/reset.cpp.o" "gcc" "commands/CMakeFiles/commands.dir/reset.cpp.o.d"
+  "/root/repo/commands/setconfig.cpp" "commands/CMakeFiles/commands.dir/setconfig.cpp.o" "gcc" "commands/CMakeFiles/commands.dir/setconfig.cpp.o.d"
+  "/root/repo/commands/status.cpp" "commands/CMakeFiles/commands.dir/status.cpp.o" "gcc" "commands/CMakeFiles/commands.dir/status.cpp.o.d"
+  "/root/repo/commands/tree.cpp" "commands/CMakeFiles/commands.dir/tree.cpp.o" "gcc" "commands/CMakeFiles/commands.dir/tree.cpp.o.d"
+  "/root/repo/commands/upload.cpp" "commands/CMakeFiles/commands.dir/upload.cpp.o" "gcc" "commands/CMakeFiles/commands.dir/upload.cpp.o.d"
+  "/root/repo/commands/workingcopycommand.cpp" "commands/CMakeFiles/commands.dir/workingcopycommand.cpp.o" "gcc" "commands/CMakeFiles/commands.dir/workingcopycommand.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_build/piel/CMakeFiles/piel.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
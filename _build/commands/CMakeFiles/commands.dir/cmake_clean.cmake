@@ -0,0 +1,53 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/commands.dir/checkout.cpp.o"
+  "CMakeFiles/commands.dir/checkout.cpp.o.d"
+  "CMakeFiles/commands.dir/clean.cpp.o"
+  "CMakeFiles/commands.dir/clean.cpp.o.d"
+  "CMakeFiles/commands.dir/command.cpp.o"
+  "CMakeFiles/commands.dir/command.cpp.o.d"
+  "CMakeFiles/commands.dir/commit.cpp.o"
+  "CMakeFiles/commands.dir/commit.cpp.o.d"
+  "CMakeFiles/commands.dir/create.cpp.o"
+  "CMakeFiles/commands.dir/create.cpp.o.d"
+  "CMakeFiles/commands.dir/destroy.cpp.o"
+  "CMakeFiles/commands.dir/destroy.cpp.o.d"
+  "CMakeFiles/commands.dir/diff.cpp.o"
+  "CMakeFiles/commands.dir/diff.cpp.o.d"
+  "CMakeFiles/commands.dir/gavc.cpp.o"
+  "CMakeFiles/commands.dir/gavc.cpp.o.d"
+  "CMakeFiles/commands.dir/gavccache.cpp.o"
+  "CMakeFiles/commands.dir/gavccache.cpp.o.d"
+  "CMakeFiles/commands.dir/gavccacheclean.cpp.o"
+  "CMakeFiles/commands.dir/gavccacheclean.cpp.o.d"
+  "CMakeFiles/commands.dir/gavccacheinit.cpp.o"
+  "CMakeFiles/commands.dir/gavccacheinit.cpp.o.d"
+  "CMakeFiles/commands.dir/gavcconstants.cpp.o"
+  "CMakeFiles/commands.dir/gavcconstants.cpp.o.d"
+  "CMakeFiles/commands.dir/iobjectsstoragecommand.cpp.o"
+  "CMakeFiles/commands.dir/iobjectsstoragecommand.cpp.o.d"
+  "CMakeFiles/commands.dir/log.cpp.o"
+  "CMakeFiles/commands.dir/log.cpp.o.d"
+  "CMakeFiles/commands.dir/pull.cpp.o"
+  "CMakeFiles/commands.dir/pull.cpp.o.d"
+  "CMakeFiles/commands.dir/push.cpp.o"
+  "CMakeFiles/commands.dir/push.cpp.o.d"
+  "CMakeFiles/commands.dir/reset.cpp.o"
+  "CMakeFiles/commands.dir/reset.cpp.o.d"
+  "CMakeFiles/commands.dir/setconfig.cpp.o"
+  "CMakeFiles/commands.dir/setconfig.cpp.o.d"
+  "CMakeFiles/commands.dir/status.cpp.o"
+  "CMakeFiles/commands.dir/status.cpp.o.d"
+  "CMakeFiles/commands.dir/tree.cpp.o"
+  "CMakeFiles/commands.dir/tree.cpp.o.d"
+  "CMakeFiles/commands.dir/upload.cpp.o"
+  "CMakeFiles/commands.dir/upload.cpp.o.d"
+  "CMakeFiles/commands.dir/workingcopycommand.cpp.o"
+  "CMakeFiles/commands.dir/workingcopycommand.cpp.o.d"
+  "libcommands.a"
+  "libcommands.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/commands.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/depman.dir/main.cpp.o"
+  "CMakeFiles/depman.dir/main.cpp.o.d"
+  "depman"
+  "depman.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/depman.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
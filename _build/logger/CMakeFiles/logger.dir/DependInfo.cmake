@@ -0,0 +1,31 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/logger/logger/app/logapp.cpp" "logger/CMakeFiles/logger.dir/logger/app/logapp.cpp.o" "gcc" "logger/CMakeFiles/logger.dir/logger/app/logapp.cpp.o.d"
+  "/root/repo/logger/logger/app/logging.cpp" "logger/CMakeFiles/logger.dir/logger/app/logging.cpp.o" "gcc" "logger/CMakeFiles/logger.dir/logger/app/logging.cpp.o.d"
+  "/root/repo/logger/logger/dispatcher/logdispatcher.cpp" "logger/CMakeFiles/logger.dir/logger/dispatcher/logdispatcher.cpp.o" "gcc" "logger/CMakeFiles/logger.dir/logger/dispatcher/logdispatcher.cpp.o.d"
+  "/root/repo/logger/logger/logbase.cpp" "logger/CMakeFiles/logger.dir/logger/logbase.cpp.o" "gcc" "logger/CMakeFiles/logger.dir/logger/logbase.cpp.o.d"
+  "/root/repo/logger/logger/out/baselogger.cpp" "logger/CMakeFiles/logger.dir/logger/out/baselogger.cpp.o" "gcc" "logger/CMakeFiles/logger.dir/logger/out/baselogger.cpp.o.d"
+  "/root/repo/logger/logger/out/commonlogger.cpp" "logger/CMakeFiles/logger.dir/logger/out/commonlogger.cpp.o" "gcc" "logger/CMakeFiles/logger.dir/logger/out/commonlogger.cpp.o.d"
+  "/root/repo/logger/logger/out/consolelogger.cpp" "logger/CMakeFiles/logger.dir/logger/out/consolelogger.cpp.o" "gcc" "logger/CMakeFiles/logger.dir/logger/out/consolelogger.cpp.o.d"
+  "/root/repo/logger/logger/out/filelogger.cpp" "logger/CMakeFiles/logger.dir/logger/out/filelogger.cpp.o" "gcc" "logger/CMakeFiles/logger.dir/logger/out/filelogger.cpp.o.d"
+  "/root/repo/logger/logger/out/loggerout.cpp" "logger/CMakeFiles/logger.dir/logger/out/loggerout.cpp.o" "gcc" "logger/CMakeFiles/logger.dir/logger/out/loggerout.cpp.o.d"
+  "/root/repo/logger/logger/out/logmessagequeue.cpp" "logger/CMakeFiles/logger.dir/logger/out/logmessagequeue.cpp.o" "gcc" "logger/CMakeFiles/logger.dir/logger/out/logmessagequeue.cpp.o.d"
+  "/root/repo/logger/logger/out/nulllogger.cpp" "logger/CMakeFiles/logger.dir/logger/out/nulllogger.cpp.o" "gcc" "logger/CMakeFiles/logger.dir/logger/out/nulllogger.cpp.o.d"
+  "/root/repo/logger/logger/utils.cpp" "logger/CMakeFiles/logger.dir/logger/utils.cpp.o" "gcc" "logger/CMakeFiles/logger.dir/logger/utils.cpp.o.d"
+  "/root/repo/logger/logging.cpp" "logger/CMakeFiles/logger.dir/logging.cpp.o" "gcc" "logger/CMakeFiles/logger.dir/logging.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,35 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/logger.dir/logger/app/logapp.cpp.o"
+  "CMakeFiles/logger.dir/logger/app/logapp.cpp.o.d"
+  "CMakeFiles/logger.dir/logger/app/logging.cpp.o"
+  "CMakeFiles/logger.dir/logger/app/logging.cpp.o.d"
+  "CMakeFiles/logger.dir/logger/dispatcher/logdispatcher.cpp.o"
+  "CMakeFiles/logger.dir/logger/dispatcher/logdispatcher.cpp.o.d"
+  "CMakeFiles/logger.dir/logger/logbase.cpp.o"
+  "CMakeFiles/logger.dir/logger/logbase.cpp.o.d"
+  "CMakeFiles/logger.dir/logger/out/baselogger.cpp.o"
+  "CMakeFiles/logger.dir/logger/out/baselogger.cpp.o.d"
+  "CMakeFiles/logger.dir/logger/out/commonlogger.cpp.o"
+  "CMakeFiles/logger.dir/logger/out/commonlogger.cpp.o.d"
+  "CMakeFiles/logger.dir/logger/out/consolelogger.cpp.o"
+  "CMakeFiles/logger.dir/logger/out/consolelogger.cpp.o.d"
+  "CMakeFiles/logger.dir/logger/out/filelogger.cpp.o"
+  "CMakeFiles/logger.dir/logger/out/filelogger.cpp.o.d"
+  "CMakeFiles/logger.dir/logger/out/loggerout.cpp.o"
+  "CMakeFiles/logger.dir/logger/out/loggerout.cpp.o.d"
+  "CMakeFiles/logger.dir/logger/out/logmessagequeue.cpp.o"
+  "CMakeFiles/logger.dir/logger/out/logmessagequeue.cpp.o.d"
+  "CMakeFiles/logger.dir/logger/out/nulllogger.cpp.o"
+  "CMakeFiles/logger.dir/logger/out/nulllogger.cpp.o.d"
+  "CMakeFiles/logger.dir/logger/utils.cpp.o"
+  "CMakeFiles/logger.dir/logger/utils.cpp.o.d"
+  "CMakeFiles/logger.dir/logging.cpp.o"
+  "CMakeFiles/logger.dir/logging.cpp.o.d"
+  "liblogger.a"
+  "liblogger.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/logger.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,41 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/pie/application.cpp" "pie/CMakeFiles/pie.dir/application.cpp.o" "gcc" "pie/CMakeFiles/pie.dir/application.cpp.o.d"
+  "/root/repo/pie/checkoutcommand.cpp" "pie/CMakeFiles/pie.dir/checkoutcommand.cpp.o" "gcc" "pie/CMakeFiles/pie.dir/checkoutcommand.cpp.o.d"
+  "/root/repo/pie/commitcommand.cpp" "pie/CMakeFiles/pie.dir/commitcommand.cpp.o" "gcc" "pie/CMakeFiles/pie.dir/commitcommand.cpp.o.d"
+  "/root/repo/pie/configcommand.cpp" "pie/CMakeFiles/pie.dir/configcommand.cpp.o" "gcc" "pie/CMakeFiles/pie.dir/configcommand.cpp.o.d"
+  "/root/repo/pie/createcommand.cpp" "pie/CMakeFiles/pie.dir/createcommand.cpp.o" "gcc" "pie/CMakeFiles/pie.dir/createcommand.cpp.o.d"
+  "/root/repo/pie/destroycommand.cpp" "pie/CMakeFiles/pie.dir/destroycommand.cpp.o" "gcc" "pie/CMakeFiles/pie.dir/destroycommand.cpp.o.d"
+  "/root/repo/pie/diffcommand.cpp" "pie/CMakeFiles/pie.dir/diffcommand.cpp.o" "gcc" "pie/CMakeFiles/pie.dir/diffcommand.cpp.o.d"
+  "/root/repo/pie/gavccachecleancommand.cpp" "pie/CMakeFiles/pie.dir/gavccachecleancommand.cpp.o" "gcc" "pie/CMakeFiles/pie.dir/gavccachecleancommand.cpp.o.d"
+  "/root/repo/pie/gavccacheinitcommand.cpp" "pie/CMakeFiles/pie.dir/gavccacheinitcommand.cpp.o" "gcc" "pie/CMakeFiles/pie.dir/gavccacheinitcommand.cpp.o.d"
+  "/root/repo/pie/gavccommand.cpp" "pie/CMakeFiles/pie.dir/gavccommand.cpp.o" "gcc" "pie/CMakeFiles/pie.dir/gavccommand.cpp.o.d"
+  "/root/repo/pie/initworkingcopycommand.cpp" "pie/CMakeFiles/pie.dir/initworkingcopycommand.cpp.o" "gcc" "pie/CMakeFiles/pie.dir/initworkingcopycommand.cpp.o.d"
+  "/root/repo/pie/logcommand.cpp" "pie/CMakeFiles/pie.dir/logcommand.cpp.o" "gcc" "pie/CMakeFiles/pie.dir/logcommand.cpp.o.d"
+  "/root/repo/pie/main.cpp" "pie/CMakeFiles/pie.dir/main.cpp.o" "gcc" "pie/CMakeFiles/pie.dir/main.cpp.o.d"
+  "/root/repo/pie/pullcommand.cpp" "pie/CMakeFiles/pie.dir/pullcommand.cpp.o" "gcc" "pie/CMakeFiles/pie.dir/pullcommand.cpp.o.d"
+  "/root/repo/pie/pushcommand.cpp" "pie/CMakeFiles/pie.dir/pushcommand.cpp.o" "gcc" "pie/CMakeFiles/pie.dir/pushcommand.cpp.o.d"
+  "/root/repo/pie/resetcommand.cpp" "pie/CMakeFiles/pie.dir/resetcommand.cpp.o" "gcc" "pie/CMakeFiles/pie.dir/resetcommand.cpp.o.d"
+  "/root/repo/pie/statuscommand.cpp" "pie/CMakeFiles/pie.dir/statuscommand.cpp.o" "gcc" "pie/CMakeFiles/pie.dir/statuscommand.cpp.o.d"
+  "/root/repo/pie/treecommand.cpp" "pie/CMakeFiles/pie.dir/treecommand.cpp.o" "gcc" "pie/CMakeFiles/pie.dir/treecommand.cpp.o.d"
+  "/root/repo/pie/uploadcommand.cpp" "pie/CMakeFiles/pie.dir/uploadcommand.cpp.o" "gcc" "pie/CMakeFiles/pie.dir/uploadcommand.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_build/commands/CMakeFiles/commands.dir/DependInfo.cmake"
+  "/root/repo/_build/piel/CMakeFiles/piel.dir/DependInfo.cmake"
+  "/root/repo/_build/logger/CMakeFiles/logger.dir/DependInfo.cmake"
+  "/root/repo/_build/third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,47 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/pie.dir/application.cpp.o"
+  "CMakeFiles/pie.dir/application.cpp.o.d"
+  "CMakeFiles/pie.dir/checkoutcommand.cpp.o"
+  "CMakeFiles/pie.dir/checkoutcommand.cpp.o.d"
+  "CMakeFiles/pie.dir/commitcommand.cpp.o"
+  "CMakeFiles/pie.dir/commitcommand.cpp.o.d"
+  "CMakeFiles/pie.dir/configcommand.cpp.o"
+  "CMakeFiles/pie.dir/configcommand.cpp.o.d"
+  "CMakeFiles/pie.dir/createcommand.cpp.o"
+  "CMakeFiles/pie.dir/createcommand.cpp.o.d"
+  "CMakeFiles/pie.dir/destroycommand.cpp.o"
+  "CMakeFiles/pie.dir/destroycommand.cpp.o.d"
+  "CMakeFiles/pie.dir/diffcommand.cpp.o"
+  "CMakeFiles/pie.dir/diffcommand.cpp.o.d"
+  "CMakeFiles/pie.dir/gavccachecleancommand.cpp.o"
+  "CMakeFiles/pie.dir/gavccachecleancommand.cpp.o.d"
+  "CMakeFiles/pie.dir/gavccacheinitcommand.cpp.o"
+  "CMakeFiles/pie.dir/gavccacheinitcommand.cpp.o.d"
+  "CMakeFiles/pie.dir/gavccommand.cpp.o"
+  "CMakeFiles/pie.dir/gavccommand.cpp.o.d"
+  "CMakeFiles/pie.dir/initworkingcopycommand.cpp.o"
+  "CMakeFiles/pie.dir/initworkingcopycommand.cpp.o.d"
+  "CMakeFiles/pie.dir/logcommand.cpp.o"
+  "CMakeFiles/pie.dir/logcommand.cpp.o.d"
+  "CMakeFiles/pie.dir/main.cpp.o"
+  "CMakeFiles/pie.dir/main.cpp.o.d"
+  "CMakeFiles/pie.dir/pullcommand.cpp.o"
+  "CMakeFiles/pie.dir/pullcommand.cpp.o.d"
+  "CMakeFiles/pie.dir/pushcommand.cpp.o"
+  "CMakeFiles/pie.dir/pushcommand.cpp.o.d"
+  "CMakeFiles/pie.dir/resetcommand.cpp.o"
+  "CMakeFiles/pie.dir/resetcommand.cpp.o.d"
+  "CMakeFiles/pie.dir/statuscommand.cpp.o"
+  "CMakeFiles/pie.dir/statuscommand.cpp.o.d"
+  "CMakeFiles/pie.dir/treecommand.cpp.o"
+  "CMakeFiles/pie.dir/treecommand.cpp.o.d"
+  "CMakeFiles/pie.dir/uploadcommand.cpp.o"
+  "CMakeFiles/pie.dir/uploadcommand.cpp.o.d"
+  "pie"
+  "pie.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pie.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
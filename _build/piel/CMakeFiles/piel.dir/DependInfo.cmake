@@ -0,0 +1,72 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/piel/artbaseapihandlers.cpp" "piel/CMakeFiles/piel.dir/artbaseapihandlers.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/artbaseapihandlers.cpp.o.d"
+  "/root/repo/piel/artbaseconstants.cpp" "piel/CMakeFiles/piel.dir/artbaseconstants.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/artbaseconstants.cpp.o.d"
+  "/root/repo/piel/artbasedeployartifactshandlers.cpp" "piel/CMakeFiles/piel.dir/artbasedeployartifactshandlers.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/artbasedeployartifactshandlers.cpp.o.d"
+  "/root/repo/piel/artbasedownloadhandlers.cpp" "piel/CMakeFiles/piel.dir/artbasedownloadhandlers.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/artbasedownloadhandlers.cpp.o.d"
+  "/root/repo/piel/artcreatedirectoryhandlers.cpp" "piel/CMakeFiles/piel.dir/artcreatedirectoryhandlers.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/artcreatedirectoryhandlers.cpp.o.d"
+  "/root/repo/piel/artdeployartifactbychecksumhandlers.cpp" "piel/CMakeFiles/piel.dir/artdeployartifactbychecksumhandlers.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/artdeployartifactbychecksumhandlers.cpp.o.d"
+  "/root/repo/piel/artdeployartifactchecksumhandlers.cpp" "piel/CMakeFiles/piel.dir/artdeployartifactchecksumhandlers.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/artdeployartifactchecksumhandlers.cpp.o.d"
+  "/root/repo/piel/artdeployartifacthandlers.cpp" "piel/CMakeFiles/piel.dir/artdeployartifacthandlers.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/artdeployartifacthandlers.cpp.o.d"
+  "/root/repo/piel/artdeployartifactstreamhandlers.cpp" "piel/CMakeFiles/piel.dir/artdeployartifactstreamhandlers.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/artdeployartifactstreamhandlers.cpp.o.d"
+  "/root/repo/piel/artgavchandlers.cpp" "piel/CMakeFiles/piel.dir/artgavchandlers.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/artgavchandlers.cpp.o.d"
+  "/root/repo/piel/artstreamuploadhandlers.cpp" "piel/CMakeFiles/piel.dir/artstreamuploadhandlers.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/artstreamuploadhandlers.cpp.o.d"
+  "/root/repo/piel/asset.cpp" "piel/CMakeFiles/piel.dir/asset.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/asset.cpp.o.d"
+  "/root/repo/piel/assetid.cpp" "piel/CMakeFiles/piel.dir/assetid.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/assetid.cpp.o.d"
+  "/root/repo/piel/assetsextractor.cpp" "piel/CMakeFiles/piel.dir/assetsextractor.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/assetsextractor.cpp.o.d"
+  "/root/repo/piel/blake3.cpp" "piel/CMakeFiles/piel.dir/blake3.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/blake3.cpp.o.d"
+  "/root/repo/piel/checksumsdigestbuilder.cpp" "piel/CMakeFiles/piel.dir/checksumsdigestbuilder.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/checksumsdigestbuilder.cpp.o.d"
+  "/root/repo/piel/commonconstants.cpp" "piel/CMakeFiles/piel.dir/commonconstants.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/commonconstants.cpp.o.d"
+  "/root/repo/piel/curleasyclient.cpp" "piel/CMakeFiles/piel.dir/curleasyclient.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/curleasyclient.cpp.o.d"
+  "/root/repo/piel/datasequencecutter.cpp" "piel/CMakeFiles/piel.dir/datasequencecutter.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/datasequencecutter.cpp.o.d"
+  "/root/repo/piel/downloadfilehandlers.cpp" "piel/CMakeFiles/piel.dir/downloadfilehandlers.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/downloadfilehandlers.cpp.o.d"
+  "/root/repo/piel/fsindexer.cpp" "piel/CMakeFiles/piel.dir/fsindexer.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/fsindexer.cpp.o.d"
+  "/root/repo/piel/gavcconstants.cpp" "piel/CMakeFiles/piel.dir/gavcconstants.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/gavcconstants.cpp.o.d"
+  "/root/repo/piel/gavcquery.cpp" "piel/CMakeFiles/piel.dir/gavcquery.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/gavcquery.cpp.o.d"
+  "/root/repo/piel/gavcversionscomparator.cpp" "piel/CMakeFiles/piel.dir/gavcversionscomparator.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/gavcversionscomparator.cpp.o.d"
+  "/root/repo/piel/gavcversionsfilter.cpp" "piel/CMakeFiles/piel.dir/gavcversionsfilter.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/gavcversionsfilter.cpp.o.d"
+  "/root/repo/piel/gavcversionsmatcher.cpp" "piel/CMakeFiles/piel.dir/gavcversionsmatcher.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/gavcversionsmatcher.cpp.o.d"
+  "/root/repo/piel/hexcodec.cpp" "piel/CMakeFiles/piel.dir/hexcodec.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/hexcodec.cpp.o.d"
+  "/root/repo/piel/indexesdiff.cpp" "piel/CMakeFiles/piel.dir/indexesdiff.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/indexesdiff.cpp.o.d"
+  "/root/repo/piel/iobjectsstorage.cpp" "piel/CMakeFiles/piel.dir/iobjectsstorage.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/iobjectsstorage.cpp.o.d"
+  "/root/repo/piel/iostreamsholder.cpp" "piel/CMakeFiles/piel.dir/iostreamsholder.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/iostreamsholder.cpp.o.d"
+  "/root/repo/piel/layeredstorage.cpp" "piel/CMakeFiles/piel.dir/layeredstorage.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/layeredstorage.cpp.o.d"
+  "/root/repo/piel/localdirectorystorage.cpp" "piel/CMakeFiles/piel.dir/localdirectorystorage.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/localdirectorystorage.cpp.o.d"
+  "/root/repo/piel/mavenmetadata.cpp" "piel/CMakeFiles/piel.dir/mavenmetadata.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/mavenmetadata.cpp.o.d"
+  "/root/repo/piel/mavenpom.cpp" "piel/CMakeFiles/piel.dir/mavenpom.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/mavenpom.cpp.o.d"
+  "/root/repo/piel/memoryobjectsstorage.cpp" "piel/CMakeFiles/piel.dir/memoryobjectsstorage.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/memoryobjectsstorage.cpp.o.d"
+  "/root/repo/piel/merkletree.cpp" "piel/CMakeFiles/piel.dir/merkletree.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/merkletree.cpp.o.d"
+  "/root/repo/piel/objectchunks.cpp" "piel/CMakeFiles/piel.dir/objectchunks.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/objectchunks.cpp.o.d"
+  "/root/repo/piel/objectcompression.cpp" "piel/CMakeFiles/piel.dir/objectcompression.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/objectcompression.cpp.o.d"
+  "/root/repo/piel/objectssync.cpp" "piel/CMakeFiles/piel.dir/objectssync.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/objectssync.cpp.o.d"
+  "/root/repo/piel/packeddirectorystorage.cpp" "piel/CMakeFiles/piel.dir/packeddirectorystorage.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/packeddirectorystorage.cpp.o.d"
+  "/root/repo/piel/properties.cpp" "piel/CMakeFiles/piel.dir/properties.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/properties.cpp.o.d"
+  "/root/repo/piel/rangeparser.cpp" "piel/CMakeFiles/piel.dir/rangeparser.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/rangeparser.cpp.o.d"
+  "/root/repo/piel/remoteobjectsstorage.cpp" "piel/CMakeFiles/piel.dir/remoteobjectsstorage.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/remoteobjectsstorage.cpp.o.d"
+  "/root/repo/piel/statcache.cpp" "piel/CMakeFiles/piel.dir/statcache.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/statcache.cpp.o.d"
+  "/root/repo/piel/streampipe.cpp" "piel/CMakeFiles/piel.dir/streampipe.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/streampipe.cpp.o.d"
+  "/root/repo/piel/treeenumerator.cpp" "piel/CMakeFiles/piel.dir/treeenumerator.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/treeenumerator.cpp.o.d"
+  "/root/repo/piel/treeindex.cpp" "piel/CMakeFiles/piel.dir/treeindex.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/treeindex.cpp.o.d"
+  "/root/repo/piel/treeindexenumerator.cpp" "piel/CMakeFiles/piel.dir/treeindexenumerator.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/treeindexenumerator.cpp.o.d"
+  "/root/repo/piel/uploadfilesspec.cpp" "piel/CMakeFiles/piel.dir/uploadfilesspec.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/uploadfilesspec.cpp.o.d"
+  "/root/repo/piel/workingcopy.cpp" "piel/CMakeFiles/piel.dir/workingcopy.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/workingcopy.cpp.o.d"
+  "/root/repo/piel/zipfile.cpp" "piel/CMakeFiles/piel.dir/zipfile.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/zipfile.cpp.o.d"
+  "/root/repo/piel/zipimporter.cpp" "piel/CMakeFiles/piel.dir/zipimporter.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/zipimporter.cpp.o.d"
+  "/root/repo/piel/zipindexer.cpp" "piel/CMakeFiles/piel.dir/zipindexer.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/zipindexer.cpp.o.d"
+  "/root/repo/piel/zipwriter.cpp" "piel/CMakeFiles/piel.dir/zipwriter.cpp.o" "gcc" "piel/CMakeFiles/piel.dir/zipwriter.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
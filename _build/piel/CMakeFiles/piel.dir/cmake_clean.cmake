@@ -0,0 +1,117 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/piel.dir/artbaseapihandlers.cpp.o"
+  "CMakeFiles/piel.dir/artbaseapihandlers.cpp.o.d"
+  "CMakeFiles/piel.dir/artbaseconstants.cpp.o"
+  "CMakeFiles/piel.dir/artbaseconstants.cpp.o.d"
+  "CMakeFiles/piel.dir/artbasedeployartifactshandlers.cpp.o"
+  "CMakeFiles/piel.dir/artbasedeployartifactshandlers.cpp.o.d"
+  "CMakeFiles/piel.dir/artbasedownloadhandlers.cpp.o"
+  "CMakeFiles/piel.dir/artbasedownloadhandlers.cpp.o.d"
+  "CMakeFiles/piel.dir/artcreatedirectoryhandlers.cpp.o"
+  "CMakeFiles/piel.dir/artcreatedirectoryhandlers.cpp.o.d"
+  "CMakeFiles/piel.dir/artdeployartifactbychecksumhandlers.cpp.o"
+  "CMakeFiles/piel.dir/artdeployartifactbychecksumhandlers.cpp.o.d"
+  "CMakeFiles/piel.dir/artdeployartifactchecksumhandlers.cpp.o"
+  "CMakeFiles/piel.dir/artdeployartifactchecksumhandlers.cpp.o.d"
+  "CMakeFiles/piel.dir/artdeployartifacthandlers.cpp.o"
+  "CMakeFiles/piel.dir/artdeployartifacthandlers.cpp.o.d"
+  "CMakeFiles/piel.dir/artdeployartifactstreamhandlers.cpp.o"
+  "CMakeFiles/piel.dir/artdeployartifactstreamhandlers.cpp.o.d"
+  "CMakeFiles/piel.dir/artgavchandlers.cpp.o"
+  "CMakeFiles/piel.dir/artgavchandlers.cpp.o.d"
+  "CMakeFiles/piel.dir/artstreamuploadhandlers.cpp.o"
+  "CMakeFiles/piel.dir/artstreamuploadhandlers.cpp.o.d"
+  "CMakeFiles/piel.dir/asset.cpp.o"
+  "CMakeFiles/piel.dir/asset.cpp.o.d"
+  "CMakeFiles/piel.dir/assetid.cpp.o"
+  "CMakeFiles/piel.dir/assetid.cpp.o.d"
+  "CMakeFiles/piel.dir/assetsextractor.cpp.o"
+  "CMakeFiles/piel.dir/assetsextractor.cpp.o.d"
+  "CMakeFiles/piel.dir/blake3.cpp.o"
+  "CMakeFiles/piel.dir/blake3.cpp.o.d"
+  "CMakeFiles/piel.dir/checksumsdigestbuilder.cpp.o"
+  "CMakeFiles/piel.dir/checksumsdigestbuilder.cpp.o.d"
+  "CMakeFiles/piel.dir/commonconstants.cpp.o"
+  "CMakeFiles/piel.dir/commonconstants.cpp.o.d"
+  "CMakeFiles/piel.dir/curleasyclient.cpp.o"
+  "CMakeFiles/piel.dir/curleasyclient.cpp.o.d"
+  "CMakeFiles/piel.dir/datasequencecutter.cpp.o"
+  "CMakeFiles/piel.dir/datasequencecutter.cpp.o.d"
+  "CMakeFiles/piel.dir/downloadfilehandlers.cpp.o"
+  "CMakeFiles/piel.dir/downloadfilehandlers.cpp.o.d"
+  "CMakeFiles/piel.dir/fsindexer.cpp.o"
+  "CMakeFiles/piel.dir/fsindexer.cpp.o.d"
+  "CMakeFiles/piel.dir/gavcconstants.cpp.o"
+  "CMakeFiles/piel.dir/gavcconstants.cpp.o.d"
+  "CMakeFiles/piel.dir/gavcquery.cpp.o"
+  "CMakeFiles/piel.dir/gavcquery.cpp.o.d"
+  "CMakeFiles/piel.dir/gavcversionscomparator.cpp.o"
+  "CMakeFiles/piel.dir/gavcversionscomparator.cpp.o.d"
+  "CMakeFiles/piel.dir/gavcversionsfilter.cpp.o"
+  "CMakeFiles/piel.dir/gavcversionsfilter.cpp.o.d"
+  "CMakeFiles/piel.dir/gavcversionsmatcher.cpp.o"
+  "CMakeFiles/piel.dir/gavcversionsmatcher.cpp.o.d"
+  "CMakeFiles/piel.dir/hexcodec.cpp.o"
+  "CMakeFiles/piel.dir/hexcodec.cpp.o.d"
+  "CMakeFiles/piel.dir/indexesdiff.cpp.o"
+  "CMakeFiles/piel.dir/indexesdiff.cpp.o.d"
+  "CMakeFiles/piel.dir/iobjectsstorage.cpp.o"
+  "CMakeFiles/piel.dir/iobjectsstorage.cpp.o.d"
+  "CMakeFiles/piel.dir/iostreamsholder.cpp.o"
+  "CMakeFiles/piel.dir/iostreamsholder.cpp.o.d"
+  "CMakeFiles/piel.dir/layeredstorage.cpp.o"
+  "CMakeFiles/piel.dir/layeredstorage.cpp.o.d"
+  "CMakeFiles/piel.dir/localdirectorystorage.cpp.o"
+  "CMakeFiles/piel.dir/localdirectorystorage.cpp.o.d"
+  "CMakeFiles/piel.dir/mavenmetadata.cpp.o"
+  "CMakeFiles/piel.dir/mavenmetadata.cpp.o.d"
+  "CMakeFiles/piel.dir/mavenpom.cpp.o"
+  "CMakeFiles/piel.dir/mavenpom.cpp.o.d"
+  "CMakeFiles/piel.dir/memoryobjectsstorage.cpp.o"
+  "CMakeFiles/piel.dir/memoryobjectsstorage.cpp.o.d"
+  "CMakeFiles/piel.dir/merkletree.cpp.o"
+  "CMakeFiles/piel.dir/merkletree.cpp.o.d"
+  "CMakeFiles/piel.dir/objectchunks.cpp.o"
+  "CMakeFiles/piel.dir/objectchunks.cpp.o.d"
+  "CMakeFiles/piel.dir/objectcompression.cpp.o"
+  "CMakeFiles/piel.dir/objectcompression.cpp.o.d"
+  "CMakeFiles/piel.dir/objectssync.cpp.o"
+  "CMakeFiles/piel.dir/objectssync.cpp.o.d"
+  "CMakeFiles/piel.dir/packeddirectorystorage.cpp.o"
+  "CMakeFiles/piel.dir/packeddirectorystorage.cpp.o.d"
+  "CMakeFiles/piel.dir/properties.cpp.o"
+  "CMakeFiles/piel.dir/properties.cpp.o.d"
+  "CMakeFiles/piel.dir/rangeparser.cpp.o"
+  "CMakeFiles/piel.dir/rangeparser.cpp.o.d"
+  "CMakeFiles/piel.dir/remoteobjectsstorage.cpp.o"
+  "CMakeFiles/piel.dir/remoteobjectsstorage.cpp.o.d"
+  "CMakeFiles/piel.dir/statcache.cpp.o"
+  "CMakeFiles/piel.dir/statcache.cpp.o.d"
+  "CMakeFiles/piel.dir/streampipe.cpp.o"
+  "CMakeFiles/piel.dir/streampipe.cpp.o.d"
+  "CMakeFiles/piel.dir/treeenumerator.cpp.o"
+  "CMakeFiles/piel.dir/treeenumerator.cpp.o.d"
+  "CMakeFiles/piel.dir/treeindex.cpp.o"
+  "CMakeFiles/piel.dir/treeindex.cpp.o.d"
+  "CMakeFiles/piel.dir/treeindexenumerator.cpp.o"
+  "CMakeFiles/piel.dir/treeindexenumerator.cpp.o.d"
+  "CMakeFiles/piel.dir/uploadfilesspec.cpp.o"
+  "CMakeFiles/piel.dir/uploadfilesspec.cpp.o.d"
+  "CMakeFiles/piel.dir/workingcopy.cpp.o"
+  "CMakeFiles/piel.dir/workingcopy.cpp.o.d"
+  "CMakeFiles/piel.dir/zipfile.cpp.o"
+  "CMakeFiles/piel.dir/zipfile.cpp.o.d"
+  "CMakeFiles/piel.dir/zipimporter.cpp.o"
+  "CMakeFiles/piel.dir/zipimporter.cpp.o.d"
+  "CMakeFiles/piel.dir/zipindexer.cpp.o"
+  "CMakeFiles/piel.dir/zipindexer.cpp.o.d"
+  "CMakeFiles/piel.dir/zipwriter.cpp.o"
+  "CMakeFiles/piel.dir/zipwriter.cpp.o.d"
+  "libpiel.a"
+  "libpiel.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/piel.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/art_test.dir/art_test.cpp.o"
+  "CMakeFiles/art_test.dir/art_test.cpp.o.d"
+  "art_test"
+  "art_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/art_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/assets_tests.dir/assets_tests.cpp.o"
+  "CMakeFiles/assets_tests.dir/assets_tests.cpp.o.d"
+  "assets_tests"
+  "assets_tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/assets_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
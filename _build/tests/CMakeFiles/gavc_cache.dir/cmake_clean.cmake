@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/gavc_cache.dir/gavc_cache.cpp.o"
+  "CMakeFiles/gavc_cache.dir/gavc_cache.cpp.o.d"
+  "gavc_cache"
+  "gavc_cache.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/gavc_cache.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tests/gavc_query_parsing.cpp" "tests/CMakeFiles/gavc_query_parsing.dir/gavc_query_parsing.cpp.o" "gcc" "tests/CMakeFiles/gavc_query_parsing.dir/gavc_query_parsing.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_build/commands/CMakeFiles/commands.dir/DependInfo.cmake"
+  "/root/repo/_build/piel/CMakeFiles/piel.dir/DependInfo.cmake"
+  "/root/repo/_build/logger/CMakeFiles/logger.dir/DependInfo.cmake"
+  "/root/repo/_build/third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/gavc_query_parsing.dir/gavc_query_parsing.cpp.o"
+  "CMakeFiles/gavc_query_parsing.dir/gavc_query_parsing.cpp.o.d"
+  "gavc_query_parsing"
+  "gavc_query_parsing.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/gavc_query_parsing.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
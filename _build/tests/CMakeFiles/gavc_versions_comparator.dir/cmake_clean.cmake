@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/gavc_versions_comparator.dir/gavc_versions_comparator.cpp.o"
+  "CMakeFiles/gavc_versions_comparator.dir/gavc_versions_comparator.cpp.o.d"
+  "gavc_versions_comparator"
+  "gavc_versions_comparator.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/gavc_versions_comparator.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
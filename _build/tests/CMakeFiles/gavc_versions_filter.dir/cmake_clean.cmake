@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/gavc_versions_filter.dir/gavc_versions_filter.cpp.o"
+  "CMakeFiles/gavc_versions_filter.dir/gavc_versions_filter.cpp.o.d"
+  "gavc_versions_filter"
+  "gavc_versions_filter.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/gavc_versions_filter.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
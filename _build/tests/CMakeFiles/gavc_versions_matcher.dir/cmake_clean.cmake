@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/gavc_versions_matcher.dir/gavc_versions_matcher.cpp.o"
+  "CMakeFiles/gavc_versions_matcher.dir/gavc_versions_matcher.cpp.o.d"
+  "gavc_versions_matcher"
+  "gavc_versions_matcher.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/gavc_versions_matcher.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
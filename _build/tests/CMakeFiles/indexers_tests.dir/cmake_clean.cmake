@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/indexers_tests.dir/indexers_tests.cpp.o"
+  "CMakeFiles/indexers_tests.dir/indexers_tests.cpp.o.d"
+  "indexers_tests"
+  "indexers_tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/indexers_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/logging_tests.dir/logging_tests.cpp.o"
+  "CMakeFiles/logging_tests.dir/logging_tests.cpp.o.d"
+  "logging_tests"
+  "logging_tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/logging_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
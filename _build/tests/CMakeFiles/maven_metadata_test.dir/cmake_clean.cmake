@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/maven_metadata_test.dir/maven_metadata_test.cpp.o"
+  "CMakeFiles/maven_metadata_test.dir/maven_metadata_test.cpp.o.d"
+  "maven_metadata_test"
+  "maven_metadata_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/maven_metadata_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
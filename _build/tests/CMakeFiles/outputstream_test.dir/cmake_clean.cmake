@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/outputstream_test.dir/outputstream_test.cpp.o"
+  "CMakeFiles/outputstream_test.dir/outputstream_test.cpp.o.d"
+  "outputstream_test"
+  "outputstream_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/outputstream_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
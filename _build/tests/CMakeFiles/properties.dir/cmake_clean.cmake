@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/properties.dir/properties.cpp.o"
+  "CMakeFiles/properties.dir/properties.cpp.o.d"
+  "properties"
+  "properties.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/properties.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/push_test.dir/push_tests.cpp.o"
+  "CMakeFiles/push_test.dir/push_tests.cpp.o.d"
+  "push_test"
+  "push_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/push_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
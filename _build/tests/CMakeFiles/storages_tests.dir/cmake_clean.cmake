@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/storages_tests.dir/storages_tests.cpp.o"
+  "CMakeFiles/storages_tests.dir/storages_tests.cpp.o.d"
+  "storages_tests"
+  "storages_tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/storages_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
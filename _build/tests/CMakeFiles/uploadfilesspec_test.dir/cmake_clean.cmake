@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/uploadfilesspec_test.dir/uploadfilesspec_test.cpp.o"
+  "CMakeFiles/uploadfilesspec_test.dir/uploadfilesspec_test.cpp.o.d"
+  "uploadfilesspec_test"
+  "uploadfilesspec_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/uploadfilesspec_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/working_copy_tests.dir/working_copy_tests.cpp.o"
+  "CMakeFiles/working_copy_tests.dir/working_copy_tests.cpp.o.d"
+  "working_copy_tests"
+  "working_copy_tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/working_copy_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
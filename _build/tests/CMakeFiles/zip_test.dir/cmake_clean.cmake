@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/zip_test.dir/zip_tests.cpp.o"
+  "CMakeFiles/zip_test.dir/zip_tests.cpp.o.d"
+  "zip_test"
+  "zip_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/zip_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
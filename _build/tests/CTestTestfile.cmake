@@ -0,0 +1,36 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests
+# Build directory: /root/repo/_build/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(ZipTest "/root/repo/_build/tests/zip_test")
+set_tests_properties(ZipTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(UploadFilesSpecTest "/root/repo/_build/tests/uploadfilesspec_test")
+set_tests_properties(UploadFilesSpecTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;19;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(OutputStreamTests "/root/repo/_build/tests/outputstream_test")
+set_tests_properties(OutputStreamTests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;24;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(Properties "/root/repo/_build/tests/properties")
+set_tests_properties(Properties PROPERTIES  ENVIRONMENT "test_env_var=test_env_var_default_value" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(GacvQueryParsing "/root/repo/_build/tests/gavc_query_parsing")
+set_tests_properties(GacvQueryParsing PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;41;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(MavenMetadataTest "/root/repo/_build/tests/maven_metadata_test")
+set_tests_properties(MavenMetadataTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;46;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(GavcVersionsFilterTest "/root/repo/_build/tests/gavc_versions_filter")
+set_tests_properties(GavcVersionsFilterTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;51;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(GavcVersionsMatcherTest "/root/repo/_build/tests/gavc_versions_matcher")
+set_tests_properties(GavcVersionsMatcherTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;56;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(GavcVersionsComparatorTest "/root/repo/_build/tests/gavc_versions_comparator")
+set_tests_properties(GavcVersionsComparatorTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;61;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(AssetsTests "/root/repo/_build/tests/assets_tests")
+set_tests_properties(AssetsTests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;66;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(IndexersTests "/root/repo/_build/tests/indexers_tests")
+set_tests_properties(IndexersTests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;71;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(WorkingCopyTests "/root/repo/_build/tests/working_copy_tests")
+set_tests_properties(WorkingCopyTests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;76;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(LoggingTests "/root/repo/_build/tests/logging_tests")
+set_tests_properties(LoggingTests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;81;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(GAVCCache "/root/repo/_build/tests/gavc_cache")
+set_tests_properties(GAVCCache PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;91;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(StoragesTests "/root/repo/_build/tests/storages_tests")
+set_tests_properties(StoragesTests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;96;add_test;/root/repo/tests/CMakeLists.txt;0;")
@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/update_zip_err_str"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/update_zip_err_str.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,130 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/third-party/libzip-1.4.0/lib/gladman-fcrypt.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/gladman-fcrypt.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/gladman-fcrypt.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_add.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_add.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_add.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_add_dir.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_add_dir.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_add_dir.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_add_entry.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_add_entry.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_add_entry.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_algorithm_bzip2.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_algorithm_bzip2.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_algorithm_bzip2.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_algorithm_deflate.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_algorithm_deflate.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_algorithm_deflate.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_buffer.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_buffer.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_buffer.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_close.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_close.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_close.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_delete.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_delete.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_delete.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_dir_add.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_dir_add.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_dir_add.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_dirent.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_dirent.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_dirent.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_discard.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_discard.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_discard.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_entry.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_entry.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_entry.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_err_str.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_err_str.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_err_str.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_error.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_error.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_error.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_error_clear.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_error_clear.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_error_clear.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_error_get.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_error_get.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_error_get.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_error_get_sys_type.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_error_get_sys_type.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_error_get_sys_type.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_error_strerror.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_error_strerror.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_error_strerror.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_error_to_str.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_error_to_str.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_error_to_str.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_extra_field.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_extra_field.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_extra_field.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_extra_field_api.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_extra_field_api.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_extra_field_api.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_fclose.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_fclose.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_fclose.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_fdopen.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_fdopen.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_fdopen.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_file_add.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_add.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_add.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_file_error_clear.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_error_clear.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_error_clear.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_file_error_get.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_error_get.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_error_get.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_file_get_comment.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_get_comment.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_get_comment.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_file_get_external_attributes.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_get_external_attributes.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_get_external_attributes.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_file_get_offset.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_get_offset.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_get_offset.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_file_rename.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_rename.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_rename.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_file_replace.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_replace.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_replace.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_file_set_comment.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_set_comment.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_set_comment.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_file_set_encryption.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_set_encryption.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_set_encryption.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_file_set_external_attributes.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_set_external_attributes.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_set_external_attributes.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_file_set_mtime.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_set_mtime.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_set_mtime.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_file_strerror.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_strerror.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_file_strerror.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_filerange_crc.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_filerange_crc.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_filerange_crc.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_fopen.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_fopen.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_fopen.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_fopen_encrypted.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_fopen_encrypted.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_fopen_encrypted.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_fopen_index.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_fopen_index.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_fopen_index.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_fopen_index_encrypted.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_fopen_index_encrypted.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_fopen_index_encrypted.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_fread.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_fread.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_fread.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_fseek.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_fseek.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_fseek.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_ftell.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_ftell.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_ftell.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_get_archive_comment.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_get_archive_comment.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_get_archive_comment.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_get_archive_flag.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_get_archive_flag.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_get_archive_flag.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_get_encryption_implementation.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_get_encryption_implementation.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_get_encryption_implementation.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_get_file_comment.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_get_file_comment.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_get_file_comment.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_get_name.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_get_name.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_get_name.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_get_num_entries.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_get_num_entries.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_get_num_entries.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_get_num_files.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_get_num_files.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_get_num_files.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_hash.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_hash.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_hash.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_io_util.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_io_util.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_io_util.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_libzip_version.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_libzip_version.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_libzip_version.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_memdup.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_memdup.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_memdup.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_name_locate.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_name_locate.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_name_locate.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_new.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_new.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_new.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_open.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_open.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_open.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_progress.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_progress.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_progress.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_random_unix.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_random_unix.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_random_unix.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_rename.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_rename.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_rename.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_replace.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_replace.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_replace.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_set_archive_comment.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_set_archive_comment.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_set_archive_comment.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_set_archive_flag.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_set_archive_flag.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_set_archive_flag.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_set_default_password.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_set_default_password.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_set_default_password.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_set_file_comment.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_set_file_comment.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_set_file_comment.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_set_file_compression.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_set_file_compression.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_set_file_compression.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_set_name.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_set_name.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_set_name.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_begin_write.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_begin_write.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_begin_write.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_begin_write_cloning.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_begin_write_cloning.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_begin_write_cloning.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_buffer.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_buffer.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_buffer.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_call.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_call.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_call.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_close.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_close.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_close.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_commit_write.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_commit_write.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_commit_write.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_compress.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_compress.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_compress.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_crc.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_crc.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_crc.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_error.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_error.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_error.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_file.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_file.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_file.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_filep.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_filep.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_filep.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_free.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_free.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_free.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_function.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_function.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_function.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_get_compression_flags.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_get_compression_flags.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_get_compression_flags.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_is_deleted.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_is_deleted.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_is_deleted.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_layered.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_layered.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_layered.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_open.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_open.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_open.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_pkware.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_pkware.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_pkware.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_read.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_read.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_read.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_remove.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_remove.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_remove.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_rollback_write.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_rollback_write.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_rollback_write.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_seek.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_seek.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_seek.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_seek_write.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_seek_write.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_seek_write.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_stat.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_stat.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_stat.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_supports.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_supports.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_supports.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_tell.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_tell.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_tell.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_tell_write.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_tell_write.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_tell_write.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_window.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_window.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_window.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_winzip_aes_decode.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_winzip_aes_decode.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_winzip_aes_decode.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_winzip_aes_encode.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_winzip_aes_encode.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_winzip_aes_encode.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_write.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_write.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_write.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_zip.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_zip.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_zip.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_source_zip_new.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_zip_new.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_source_zip_new.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_stat.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_stat.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_stat.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_stat_index.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_stat_index.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_stat_index.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_stat_init.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_stat_init.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_stat_init.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_strerror.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_strerror.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_strerror.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_string.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_string.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_string.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_unchange.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_unchange.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_unchange.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_unchange_all.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_unchange_all.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_unchange_all.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_unchange_archive.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_unchange_archive.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_unchange_archive.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_unchange_data.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_unchange_data.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_unchange_data.c.o.d"
+  "/root/repo/third-party/libzip-1.4.0/lib/zip_utf-8.c" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_utf-8.c.o" "gcc" "third-party/libzip-1.4.0/lib/CMakeFiles/zip.dir/zip_utf-8.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,233 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/zip.dir/gladman-fcrypt.c.o"
+  "CMakeFiles/zip.dir/gladman-fcrypt.c.o.d"
+  "CMakeFiles/zip.dir/zip_add.c.o"
+  "CMakeFiles/zip.dir/zip_add.c.o.d"
+  "CMakeFiles/zip.dir/zip_add_dir.c.o"
+  "CMakeFiles/zip.dir/zip_add_dir.c.o.d"
+  "CMakeFiles/zip.dir/zip_add_entry.c.o"
+  "CMakeFiles/zip.dir/zip_add_entry.c.o.d"
+  "CMakeFiles/zip.dir/zip_algorithm_bzip2.c.o"
+  "CMakeFiles/zip.dir/zip_algorithm_bzip2.c.o.d"
+  "CMakeFiles/zip.dir/zip_algorithm_deflate.c.o"
+  "CMakeFiles/zip.dir/zip_algorithm_deflate.c.o.d"
+  "CMakeFiles/zip.dir/zip_buffer.c.o"
+  "CMakeFiles/zip.dir/zip_buffer.c.o.d"
+  "CMakeFiles/zip.dir/zip_close.c.o"
+  "CMakeFiles/zip.dir/zip_close.c.o.d"
+  "CMakeFiles/zip.dir/zip_delete.c.o"
+  "CMakeFiles/zip.dir/zip_delete.c.o.d"
+  "CMakeFiles/zip.dir/zip_dir_add.c.o"
+  "CMakeFiles/zip.dir/zip_dir_add.c.o.d"
+  "CMakeFiles/zip.dir/zip_dirent.c.o"
+  "CMakeFiles/zip.dir/zip_dirent.c.o.d"
+  "CMakeFiles/zip.dir/zip_discard.c.o"
+  "CMakeFiles/zip.dir/zip_discard.c.o.d"
+  "CMakeFiles/zip.dir/zip_entry.c.o"
+  "CMakeFiles/zip.dir/zip_entry.c.o.d"
+  "CMakeFiles/zip.dir/zip_err_str.c.o"
+  "CMakeFiles/zip.dir/zip_err_str.c.o.d"
+  "CMakeFiles/zip.dir/zip_error.c.o"
+  "CMakeFiles/zip.dir/zip_error.c.o.d"
+  "CMakeFiles/zip.dir/zip_error_clear.c.o"
+  "CMakeFiles/zip.dir/zip_error_clear.c.o.d"
+  "CMakeFiles/zip.dir/zip_error_get.c.o"
+  "CMakeFiles/zip.dir/zip_error_get.c.o.d"
+  "CMakeFiles/zip.dir/zip_error_get_sys_type.c.o"
+  "CMakeFiles/zip.dir/zip_error_get_sys_type.c.o.d"
+  "CMakeFiles/zip.dir/zip_error_strerror.c.o"
+  "CMakeFiles/zip.dir/zip_error_strerror.c.o.d"
+  "CMakeFiles/zip.dir/zip_error_to_str.c.o"
+  "CMakeFiles/zip.dir/zip_error_to_str.c.o.d"
+  "CMakeFiles/zip.dir/zip_extra_field.c.o"
+  "CMakeFiles/zip.dir/zip_extra_field.c.o.d"
+  "CMakeFiles/zip.dir/zip_extra_field_api.c.o"
+  "CMakeFiles/zip.dir/zip_extra_field_api.c.o.d"
+  "CMakeFiles/zip.dir/zip_fclose.c.o"
+  "CMakeFiles/zip.dir/zip_fclose.c.o.d"
+  "CMakeFiles/zip.dir/zip_fdopen.c.o"
+  "CMakeFiles/zip.dir/zip_fdopen.c.o.d"
+  "CMakeFiles/zip.dir/zip_file_add.c.o"
+  "CMakeFiles/zip.dir/zip_file_add.c.o.d"
+  "CMakeFiles/zip.dir/zip_file_error_clear.c.o"
+  "CMakeFiles/zip.dir/zip_file_error_clear.c.o.d"
+  "CMakeFiles/zip.dir/zip_file_error_get.c.o"
+  "CMakeFiles/zip.dir/zip_file_error_get.c.o.d"
+  "CMakeFiles/zip.dir/zip_file_get_comment.c.o"
+  "CMakeFiles/zip.dir/zip_file_get_comment.c.o.d"
+  "CMakeFiles/zip.dir/zip_file_get_external_attributes.c.o"
+  "CMakeFiles/zip.dir/zip_file_get_external_attributes.c.o.d"
+  "CMakeFiles/zip.dir/zip_file_get_offset.c.o"
+  "CMakeFiles/zip.dir/zip_file_get_offset.c.o.d"
+  "CMakeFiles/zip.dir/zip_file_rename.c.o"
+  "CMakeFiles/zip.dir/zip_file_rename.c.o.d"
+  "CMakeFiles/zip.dir/zip_file_replace.c.o"
+  "CMakeFiles/zip.dir/zip_file_replace.c.o.d"
+  "CMakeFiles/zip.dir/zip_file_set_comment.c.o"
+  "CMakeFiles/zip.dir/zip_file_set_comment.c.o.d"
+  "CMakeFiles/zip.dir/zip_file_set_encryption.c.o"
+  "CMakeFiles/zip.dir/zip_file_set_encryption.c.o.d"
+  "CMakeFiles/zip.dir/zip_file_set_external_attributes.c.o"
+  "CMakeFiles/zip.dir/zip_file_set_external_attributes.c.o.d"
+  "CMakeFiles/zip.dir/zip_file_set_mtime.c.o"
+  "CMakeFiles/zip.dir/zip_file_set_mtime.c.o.d"
+  "CMakeFiles/zip.dir/zip_file_strerror.c.o"
+  "CMakeFiles/zip.dir/zip_file_strerror.c.o.d"
+  "CMakeFiles/zip.dir/zip_filerange_crc.c.o"
+  "CMakeFiles/zip.dir/zip_filerange_crc.c.o.d"
+  "CMakeFiles/zip.dir/zip_fopen.c.o"
+  "CMakeFiles/zip.dir/zip_fopen.c.o.d"
+  "CMakeFiles/zip.dir/zip_fopen_encrypted.c.o"
+  "CMakeFiles/zip.dir/zip_fopen_encrypted.c.o.d"
+  "CMakeFiles/zip.dir/zip_fopen_index.c.o"
+  "CMakeFiles/zip.dir/zip_fopen_index.c.o.d"
+  "CMakeFiles/zip.dir/zip_fopen_index_encrypted.c.o"
+  "CMakeFiles/zip.dir/zip_fopen_index_encrypted.c.o.d"
+  "CMakeFiles/zip.dir/zip_fread.c.o"
+  "CMakeFiles/zip.dir/zip_fread.c.o.d"
+  "CMakeFiles/zip.dir/zip_fseek.c.o"
+  "CMakeFiles/zip.dir/zip_fseek.c.o.d"
+  "CMakeFiles/zip.dir/zip_ftell.c.o"
+  "CMakeFiles/zip.dir/zip_ftell.c.o.d"
+  "CMakeFiles/zip.dir/zip_get_archive_comment.c.o"
+  "CMakeFiles/zip.dir/zip_get_archive_comment.c.o.d"
+  "CMakeFiles/zip.dir/zip_get_archive_flag.c.o"
+  "CMakeFiles/zip.dir/zip_get_archive_flag.c.o.d"
+  "CMakeFiles/zip.dir/zip_get_encryption_implementation.c.o"
+  "CMakeFiles/zip.dir/zip_get_encryption_implementation.c.o.d"
+  "CMakeFiles/zip.dir/zip_get_file_comment.c.o"
+  "CMakeFiles/zip.dir/zip_get_file_comment.c.o.d"
+  "CMakeFiles/zip.dir/zip_get_name.c.o"
+  "CMakeFiles/zip.dir/zip_get_name.c.o.d"
+  "CMakeFiles/zip.dir/zip_get_num_entries.c.o"
+  "CMakeFiles/zip.dir/zip_get_num_entries.c.o.d"
+  "CMakeFiles/zip.dir/zip_get_num_files.c.o"
+  "CMakeFiles/zip.dir/zip_get_num_files.c.o.d"
+  "CMakeFiles/zip.dir/zip_hash.c.o"
+  "CMakeFiles/zip.dir/zip_hash.c.o.d"
+  "CMakeFiles/zip.dir/zip_io_util.c.o"
+  "CMakeFiles/zip.dir/zip_io_util.c.o.d"
+  "CMakeFiles/zip.dir/zip_libzip_version.c.o"
+  "CMakeFiles/zip.dir/zip_libzip_version.c.o.d"
+  "CMakeFiles/zip.dir/zip_memdup.c.o"
+  "CMakeFiles/zip.dir/zip_memdup.c.o.d"
+  "CMakeFiles/zip.dir/zip_name_locate.c.o"
+  "CMakeFiles/zip.dir/zip_name_locate.c.o.d"
+  "CMakeFiles/zip.dir/zip_new.c.o"
+  "CMakeFiles/zip.dir/zip_new.c.o.d"
+  "CMakeFiles/zip.dir/zip_open.c.o"
+  "CMakeFiles/zip.dir/zip_open.c.o.d"
+  "CMakeFiles/zip.dir/zip_progress.c.o"
+  "CMakeFiles/zip.dir/zip_progress.c.o.d"
+  "CMakeFiles/zip.dir/zip_random_unix.c.o"
+  "CMakeFiles/zip.dir/zip_random_unix.c.o.d"
+  "CMakeFiles/zip.dir/zip_rename.c.o"
+  "CMakeFiles/zip.dir/zip_rename.c.o.d"
+  "CMakeFiles/zip.dir/zip_replace.c.o"
+  "CMakeFiles/zip.dir/zip_replace.c.o.d"
+  "CMakeFiles/zip.dir/zip_set_archive_comment.c.o"
+  "CMakeFiles/zip.dir/zip_set_archive_comment.c.o.d"
+  "CMakeFiles/zip.dir/zip_set_archive_flag.c.o"
+  "CMakeFiles/zip.dir/zip_set_archive_flag.c.o.d"
+  "CMakeFiles/zip.dir/zip_set_default_password.c.o"
+  "CMakeFiles/zip.dir/zip_set_default_password.c.o.d"
+  "CMakeFiles/zip.dir/zip_set_file_comment.c.o"
+  "CMakeFiles/zip.dir/zip_set_file_comment.c.o.d"
+  "CMakeFiles/zip.dir/zip_set_file_compression.c.o"
+  "CMakeFiles/zip.dir/zip_set_file_compression.c.o.d"
+  "CMakeFiles/zip.dir/zip_set_name.c.o"
+  "CMakeFiles/zip.dir/zip_set_name.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_begin_write.c.o"
+  "CMakeFiles/zip.dir/zip_source_begin_write.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_begin_write_cloning.c.o"
+  "CMakeFiles/zip.dir/zip_source_begin_write_cloning.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_buffer.c.o"
+  "CMakeFiles/zip.dir/zip_source_buffer.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_call.c.o"
+  "CMakeFiles/zip.dir/zip_source_call.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_close.c.o"
+  "CMakeFiles/zip.dir/zip_source_close.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_commit_write.c.o"
+  "CMakeFiles/zip.dir/zip_source_commit_write.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_compress.c.o"
+  "CMakeFiles/zip.dir/zip_source_compress.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_crc.c.o"
+  "CMakeFiles/zip.dir/zip_source_crc.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_error.c.o"
+  "CMakeFiles/zip.dir/zip_source_error.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_file.c.o"
+  "CMakeFiles/zip.dir/zip_source_file.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_filep.c.o"
+  "CMakeFiles/zip.dir/zip_source_filep.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_free.c.o"
+  "CMakeFiles/zip.dir/zip_source_free.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_function.c.o"
+  "CMakeFiles/zip.dir/zip_source_function.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_get_compression_flags.c.o"
+  "CMakeFiles/zip.dir/zip_source_get_compression_flags.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_is_deleted.c.o"
+  "CMakeFiles/zip.dir/zip_source_is_deleted.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_layered.c.o"
+  "CMakeFiles/zip.dir/zip_source_layered.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_open.c.o"
+  "CMakeFiles/zip.dir/zip_source_open.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_pkware.c.o"
+  "CMakeFiles/zip.dir/zip_source_pkware.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_read.c.o"
+  "CMakeFiles/zip.dir/zip_source_read.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_remove.c.o"
+  "CMakeFiles/zip.dir/zip_source_remove.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_rollback_write.c.o"
+  "CMakeFiles/zip.dir/zip_source_rollback_write.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_seek.c.o"
+  "CMakeFiles/zip.dir/zip_source_seek.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_seek_write.c.o"
+  "CMakeFiles/zip.dir/zip_source_seek_write.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_stat.c.o"
+  "CMakeFiles/zip.dir/zip_source_stat.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_supports.c.o"
+  "CMakeFiles/zip.dir/zip_source_supports.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_tell.c.o"
+  "CMakeFiles/zip.dir/zip_source_tell.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_tell_write.c.o"
+  "CMakeFiles/zip.dir/zip_source_tell_write.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_window.c.o"
+  "CMakeFiles/zip.dir/zip_source_window.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_winzip_aes_decode.c.o"
+  "CMakeFiles/zip.dir/zip_source_winzip_aes_decode.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_winzip_aes_encode.c.o"
+  "CMakeFiles/zip.dir/zip_source_winzip_aes_encode.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_write.c.o"
+  "CMakeFiles/zip.dir/zip_source_write.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_zip.c.o"
+  "CMakeFiles/zip.dir/zip_source_zip.c.o.d"
+  "CMakeFiles/zip.dir/zip_source_zip_new.c.o"
+  "CMakeFiles/zip.dir/zip_source_zip_new.c.o.d"
+  "CMakeFiles/zip.dir/zip_stat.c.o"
+  "CMakeFiles/zip.dir/zip_stat.c.o.d"
+  "CMakeFiles/zip.dir/zip_stat_index.c.o"
+  "CMakeFiles/zip.dir/zip_stat_index.c.o.d"
+  "CMakeFiles/zip.dir/zip_stat_init.c.o"
+  "CMakeFiles/zip.dir/zip_stat_init.c.o.d"
+  "CMakeFiles/zip.dir/zip_strerror.c.o"
+  "CMakeFiles/zip.dir/zip_strerror.c.o.d"
+  "CMakeFiles/zip.dir/zip_string.c.o"
+  "CMakeFiles/zip.dir/zip_string.c.o.d"
+  "CMakeFiles/zip.dir/zip_unchange.c.o"
+  "CMakeFiles/zip.dir/zip_unchange.c.o.d"
+  "CMakeFiles/zip.dir/zip_unchange_all.c.o"
+  "CMakeFiles/zip.dir/zip_unchange_all.c.o.d"
+  "CMakeFiles/zip.dir/zip_unchange_archive.c.o"
+  "CMakeFiles/zip.dir/zip_unchange_archive.c.o.d"
+  "CMakeFiles/zip.dir/zip_unchange_data.c.o"
+  "CMakeFiles/zip.dir/zip_unchange_data.c.o.d"
+  "CMakeFiles/zip.dir/zip_utf-8.c.o"
+  "CMakeFiles/zip.dir/zip_utf-8.c.o.d"
+  "libzip.a"
+  "libzip.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/zip.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
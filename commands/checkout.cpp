@@ -32,6 +32,9 @@
 #include <boost_filesystem_ext.hpp>
 #include <assetsextractor.h>
 #include <create.h>
+#include <setconfig.h>
+
+#include <boost/lexical_cast.hpp>
 
 namespace piel { namespace cmd {
 
@@ -65,27 +68,31 @@ std::string Checkout::operator()()
 
     if (piel::lib::AssetId::empty != working_copy()->local_storage()->resolve(ref_to_))
     {
+        piel::lib::TreeIndex::Ptr current_index = working_copy()->working_dir_state();
+
         if (!force_)
         {
             // Check for non commit changes
-            piel::lib::TreeIndex::Ptr current_index = working_copy()->working_dir_state();
-
-            piel::lib::IndexesDiff diff = piel::lib::IndexesDiff::diff(reference_index, current_index);
-            if (!diff.empty())
+            if (piel::lib::IndexesDiff::has_changes(reference_index, current_index))
             {
                 LOGT << "There are non commit changes!" << ELOG;
                 throw errors::there_are_non_commit_changes();
             }
-        }
 
-        // Remove working directory content (exclude metadata)
-        boost::filesystem::remove_directory_content(working_copy()->working_dir(), working_copy()->metadata_dir());
+            // Working directory matches the reference index, diff stored indexes instead.
+            current_index = reference_index;
+        }
 
         // Export data from index
         reference_index = piel::lib::TreeIndex::from_ref(working_copy()->local_storage(), ref_to_);
 
-        piel::lib::AssetsExtractor index_exporter(reference_index, piel::lib::ExtractPolicy__replace_existing);
-        index_exporter.extract_into(working_copy()->working_dir());
+        // Touch only the changed items (metadata is not a part of the indexes)
+        piel::lib::AssetsExtractor index_exporter(reference_index, piel::lib::ExtractPolitic(
+                piel::lib::ExtractPolicy__replace_existing |
+                piel::lib::AssetsExtractor::extract_mode(working_copy()->config().get(SetConfig::extract_mode).value())));
+        index_exporter.set_threads_count(boost::lexical_cast<unsigned int>(
+                working_copy()->config().get(SetConfig::extract_threads).value()));
+        index_exporter.extract_changes_into(working_copy()->working_dir(), current_index);
 
         // Update working copy reference
         working_copy()->setup_current_tree(ref_to_, reference_index);
@@ -104,7 +111,7 @@ std::string Checkout::operator()()
         create();
     }
 
-    return working_copy()->current_tree_state()->self().id().string();
+    return working_copy()->current_tree_state()->id().string();
 }
 
 } } // namespace piel::cmd
@@ -108,7 +108,7 @@ std::string Clean::operator()()
         }
     }
 
-    return working_copy()->current_tree_state()->self().id().string();
+    return working_copy()->current_tree_state()->id().string();
 }
 
 } } // namespace piel::cmd
@@ -50,7 +50,7 @@ const Commit* Commit::set_message(const std::string& message)
 
 piel::lib::IndexesDiff Commit::diff(const piel::lib::TreeIndex::Ptr& current_index) const
 {
-    LOGT << "Calculate diff " << working_copy()->current_tree_state()->self().id().string() << " <-> CDIR" << ELOG;
+    LOGT << "Calculate diff " << working_copy()->current_tree_state()->id().string() << " <-> CDIR" << ELOG;
     return piel::lib::IndexesDiff::diff(working_copy()->current_tree_state(), current_index);
 }
 
@@ -59,15 +59,14 @@ std::string Commit::operator()()
     piel::lib::IObjectsStorage::Ptr ls  = working_copy()->local_storage();
     piel::lib::TreeIndex::Ptr current_index  = working_copy()->working_dir_state();
 
-    piel::lib::IndexesDiff indexes_diff = diff(current_index);
-    if (indexes_diff.empty())
+    if (!piel::lib::IndexesDiff::has_changes(working_copy()->current_tree_state(), current_index))
     {
         LOGT << "Diff is empty!" << ELOG;
         throw errors::nothing_to_commit();
     }
 
     LOGT << "Non empty diff:" << ELOG;
-    LOGT << indexes_diff.format() << ELOG;
+    LOGT << diff(current_index).format() << ELOG;
 
     piel::lib::TreeIndex::Ptr reference_index    = working_copy()->current_tree_state();
 
@@ -92,11 +91,11 @@ std::string Commit::operator()()
     current_index->set_message_(message_);
 
     // Put changes into local storage
-    ls->put(current_index->assets());
+    current_index->ingest_into(ls);
     ls->update_reference(piel::lib::refs::Ref(working_copy()->current_tree_name(), current_index->self()));
 
     working_copy()->setup_current_tree(working_copy()->current_tree_name(), current_index);
-    return working_copy()->current_tree_state()->self().id().string();
+    return working_copy()->current_tree_state()->id().string();
 }
 
 } } // namespace piel::cmd
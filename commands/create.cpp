@@ -53,8 +53,7 @@ void Create::operator()()
     piel::lib::TreeIndex::Ptr current_index = working_copy()->working_dir_state();
     piel::lib::TreeIndex::Ptr reference_index = working_copy()->current_tree_state();
 
-    piel::lib::IndexesDiff diff = piel::lib::IndexesDiff::diff(reference_index, current_index);
-    if (!diff.empty())
+    if (piel::lib::IndexesDiff::has_changes(reference_index, current_index))
     {
         LOGT << "There are non commit changes!" << ELOG;
         throw errors::there_are_non_commit_changes();
@@ -68,7 +67,7 @@ void Create::operator()()
     initial_tree_index->initial_for(new_ref_);
     working_copy()->local_storage()->put(initial_tree_index->assets());
 
-    piel::lib::AssetId new_tree_id = initial_tree_index->self().id();
+    piel::lib::AssetId new_tree_id = initial_tree_index->id();
     working_copy()->local_storage()->create_reference(piel::lib::refs::Ref(new_ref_, new_tree_id));
     working_copy()->setup_current_tree(new_ref_, initial_tree_index);
 
@@ -51,7 +51,7 @@ void Log::format_log_element(const piel::lib::TreeIndex::Ptr& index) const
     cout() << "--------------------------------------------------------------------------------" << std::endl;
     cout() << "author: " << index->get_author_()                                                 << std::endl;
     cout() << "email: " << index->get_email_()                                                   << std::endl;
-    cout() << "id: "<< index->self().id().string()                                               << std::endl;
+    cout() << "id: "<< index->id().string()                                               << std::endl;
     cout()                                                                                       << std::endl;
     cout() << index->get_message_()                                                              << std::endl;
 }
@@ -78,18 +78,18 @@ void Log::operator()()
         }
     }
 
-    if (from->self().id() == to->self().id())
+    if (from->id() == to->id())
     {
         return;
     }
 
-    LOGT << "from: " << from->self().id().string()
-        << " to: " << to->self().id().string() << ELOG;
+    LOGT << "from: " << from->id().string()
+        << " to: " << to->id().string() << ELOG;
 
     piel::lib::TreeEnumerator tree_enumerator(storage(), to);
     while (tree_enumerator.next())
     {
-        if (tree_enumerator.index->self().id() == from->self().id() || tree_enumerator.index->is_initial_index())
+        if (tree_enumerator.index->id() == from->id() || tree_enumerator.index->is_initial_index())
         {
             break;
         }
@@ -34,14 +34,18 @@
 #include <gavc.h>
 #include "gavcconstants.h"
 
-#include <zipindexer.h>
+#include <zipimporter.h>
+#include <remoteobjectsstorage.h>
+#include <objectssync.h>
 
 #include <logging.h>
 #include <fsindexer.h>
 #include <treeindexenumerator.h>
 #include <assetsextractor.h>
+#include <setconfig.h>
 
 #include <boost_filesystem_ext.hpp>
+#include <boost/lexical_cast.hpp>
 
 namespace al = art::lib;
 namespace pl = piel::lib;
@@ -66,6 +70,8 @@ Pull::Pull(const std::string& server_api_access_token
     , server_repository_(server_repository)
     , query_(query)
     , path_to_download_()
+    , classifier_to_checkout_()
+    , objects_transfer_(false)
 {
 }
 
@@ -86,6 +92,50 @@ void Pull::operator()()
         throw errors::invalid_working_copy();
     }
 
+    if (objects_transfer_)
+    {
+        import_objects();
+    }
+    else
+    {
+        import_archives();
+    }
+
+    pl::TreeIndex::Ptr current_tree = piel::lib::TreeIndex::from_ref(working_copy_->local_storage(), classifier_to_checkout_);
+    if (!classifier_to_checkout_.empty() && !current_tree)
+    {
+        cout() << "Can't find requested tree to checkout! Latest imported will be used." << std::endl;
+    }
+
+    if (classifier_to_checkout_.empty() || !current_tree)
+    {
+        classifier_to_checkout_ = working_copy_->current_tree_name();
+
+        // Index with the storage assets: unlike zip entries they can be extracted in parallel.
+        current_tree            = piel::lib::TreeIndex::from_ref(working_copy_->local_storage(), classifier_to_checkout_);
+        if (!current_tree)
+        {
+            current_tree        = working_copy_->current_tree_state();
+        }
+    }
+    else
+    {
+        working_copy_->setup_current_tree(classifier_to_checkout_, current_tree);
+    }
+
+    cout() << "Checkout " << classifier_to_checkout_;
+
+    pl::AssetsExtractor index_exporter(current_tree, pl::ExtractPolitic(pl::ExtractPolicy__replace_existing |
+            pl::AssetsExtractor::extract_mode(working_copy_->config().get(SetConfig::extract_mode).value())));
+    index_exporter.set_threads_count(boost::lexical_cast<unsigned int>(
+            working_copy_->config().get(SetConfig::extract_threads).value()));
+    index_exporter.extract_into(working_copy_->working_dir());
+
+    cout() << " COMPLETE" << std::endl;
+}
+
+void Pull::import_archives()
+{
     fs::path archives_path = working_copy_->archives_dir().generic_string();
 
     GAVC gavc(server_api_access_token_,
@@ -122,38 +172,39 @@ void Pull::operator()()
 
         cout() << "Import tree: " << classifier;
 
-        pl::TreeIndex::Ptr zip_index = pl::ZipIndexer::build(*it);
-        working_copy_->local_storage()->put(zip_index->assets());
+        pl::ZipImporter importer(working_copy_->local_storage(), archives_path);
+        importer.set_threads_count(boost::lexical_cast<unsigned int>(
+                working_copy_->config().get(SetConfig::extract_threads).value()));
+        pl::TreeIndex::Ptr zip_index = importer.import(*it);
 
-        piel::lib::AssetId new_tree_id = zip_index->self().id();
+        piel::lib::AssetId new_tree_id = zip_index->id();
         working_copy_->local_storage()->create_reference(piel::lib::refs::Ref(classifier, new_tree_id));
         working_copy_->setup_current_tree(classifier, zip_index);
 
         cout() << " COMPLETE" << std::endl;
     }
+}
 
-    pl::TreeIndex::Ptr current_tree = piel::lib::TreeIndex::from_ref(working_copy_->local_storage(), classifier_to_checkout_);
-    if (!classifier_to_checkout_.empty() && !current_tree)
-    {
-        cout() << "Can't find requested tree to checkout! Latest imported will be used." << std::endl;
-    }
+void Pull::import_objects()
+{
+    pl::IObjectsStorage::Ptr remote = pl::RemoteObjectsStorage::create_for(server_url_,
+            server_api_access_token_, server_repository_, query_);
 
-    if (classifier_to_checkout_.empty() || !current_tree)
-    {
-        classifier_to_checkout_ = working_copy_->current_tree_name();
-        current_tree            = working_copy_->current_tree_state();
-    }
-    else
+    std::set<pl::refs::Ref> remote_refs = remote->references();
+    if (remote_refs.empty())
     {
-        working_copy_->setup_current_tree(classifier_to_checkout_, current_tree);
+        LOGW << "No trees found on server!" << ELOG;
     }
 
-    cout() << "Checkout " << classifier_to_checkout_;
+    for (std::set<pl::refs::Ref>::const_iterator i = remote_refs.begin(), end = remote_refs.end(); i != end; ++i)
+    {
+        cout() << "Import tree: " << i->first;
 
-    pl::AssetsExtractor index_exporter(current_tree, pl::ExtractPolicy__replace_existing);
-    index_exporter.extract_into(working_copy_->working_dir());
+        std::size_t downloaded = pl::ObjectsSync::pull(remote, working_copy_->local_storage(), i->first);
+        working_copy_->setup_current_tree(i->first, pl::TreeIndex::from_ref(working_copy_->local_storage(), i->first));
 
-    cout() << " COMPLETE" << std::endl;
+        cout() << " objects: " << downloaded << " COMPLETE" << std::endl;
+    }
 }
 
 } } // namespace piel::cmd
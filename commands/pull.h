@@ -64,6 +64,14 @@ public:
     void set_classifier_to_checkout(const std::string& c) { classifier_to_checkout_ = c; }
     std::string get_classifier_to_checkout() const { return classifier_to_checkout_; }
 
+    //! Download only the objects missing in the local storage instead of the trees archives.
+    void set_objects_transfer(bool objects_transfer) { objects_transfer_ = objects_transfer; }
+    bool get_objects_transfer() const { return objects_transfer_; }
+
+protected:
+    void import_archives();
+    void import_objects();
+
 private:
     piel::lib::WorkingCopy::Ptr working_copy_;
     std::string server_url_;
@@ -72,6 +80,7 @@ private:
     art::lib::GavcQuery query_;
     boost::filesystem::path path_to_download_;
     std::string classifier_to_checkout_;
+    bool objects_transfer_;
 };
 
 } } // namespace piel::cmd
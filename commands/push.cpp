@@ -38,8 +38,23 @@
 #include <mavenpom.h>
 #include <artdeployartifacthandlers.h>
 #include <artdeployartifactchecksumhandlers.h>
+#include <remoteobjectsstorage.h>
+#include <objectssync.h>
+#include <zipwriter.h>
+#include <streampipe.h>
+#include <artdeployartifactstreamhandlers.h>
+#include <artdeployartifactbychecksumhandlers.h>
+#include <properties.h>
+#include <setconfig.h>
 #include <boost_filesystem_ext.hpp>
 
+#include <boost/bind.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <boost/iostreams/tee.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/numeric/conversion/cast.hpp>
+#include <boost/thread.hpp>
+
 namespace al = art::lib;
 namespace pl = piel::lib;
 namespace fs = boost::filesystem;
@@ -50,9 +65,131 @@ namespace constants {
 
     static const std::string zip_extention = ".zip";
     static const std::string pom_extention = ".pom";
+    static const std::string checksums_extention = ".checksums";
+    static const std::string temp_extention = ".tmp";
+
+    static const std::string archive_upload_stream  = "stream";
+    static const std::string archive_upload_file    = "file";
 
 };
 
+namespace {
+
+    typedef piel::lib::CurlEasyClient<art::lib::ArtDeployArtifactStreamHandlers> StreamUploadClient;
+    typedef boost::iostreams::tee_device<std::ostream, std::ostream> TeeDevice;
+    typedef boost::iostreams::stream<TeeDevice> TeeStream;
+
+    //! Archive checksums are stored next to the cached archive.
+    fs::path checksums_path(const fs::path& archive)
+    {
+        return archive.string() + constants::checksums_extention;
+    }
+
+    //! \return Names of the checksums deployed with the archives.
+    std::vector<std::string> checksums_names()
+    {
+        std::vector<std::string> result;
+        result.push_back(pl::Md5::t::name());
+        result.push_back(pl::Sha::t::name());
+        result.push_back(pl::Sha256::t::name());
+        return result;
+    }
+
+    //! Load checksums of the cached archive.
+    //! \return false if the archive is not cached.
+    bool load_checksums(const fs::path& archive, pl::ChecksumsDigestBuilder::StrDigests& digests)
+    {
+        if (!fs::exists(archive) || !fs::exists(checksums_path(archive)))
+        {
+            return false;
+        }
+
+        std::ifstream is(checksums_path(archive).c_str());
+        pl::Properties properties = pl::Properties::load(is);
+
+        std::vector<std::string> names = checksums_names();
+        for (std::vector<std::string>::const_iterator i = names.begin(), end = names.end(); i != end; ++i)
+        {
+            std::string value = properties.get(*i, std::string());
+            if (value.empty())
+            {
+                return false;
+            }
+            digests[*i] = value;
+        }
+
+        return true;
+    }
+
+    //! Put archive into the cache. Checksums are stored last, so the partially cached archive is not used.
+    void store_cached(const fs::path& temp_archive, const fs::path& archive, const pl::ChecksumsDigestBuilder::StrDigests& digests)
+    {
+        pl::Properties properties;
+        std::vector<std::string> names = checksums_names();
+        for (std::vector<std::string>::const_iterator i = names.begin(), end = names.end(); i != end; ++i)
+        {
+            pl::ChecksumsDigestBuilder::StrDigests::const_iterator digest = digests.find(*i);
+            properties.set(*i, digest != digests.end() ? digest->second : std::string());
+        }
+
+        fs::path temp_checksums = checksums_path(temp_archive);
+        {
+            std::ofstream os(temp_checksums.c_str(), std::ofstream::out|std::ofstream::trunc);
+            properties.store(os);
+        }
+
+        fs::rename(temp_archive, archive);
+        fs::rename(temp_checksums, checksums_path(archive));
+    }
+
+    //! Archive content depends on the deflate level too, so the cached archives are
+    //!named by the tree id and the level: <tree id>.<level>.zip.
+    std::string cached_archive_name(const pl::AssetId& tree_id, int deflate_level)
+    {
+        return tree_id.string() + "." + boost::lexical_cast<std::string>(deflate_level) + constants::zip_extention;
+    }
+
+    bool is_cached_archive(const fs::path& path)
+    {
+        std::string name = path.stem().string();
+        std::string id = name.substr(0, name.find('.'));
+        return path.extension() == constants::zip_extention && pl::AssetId::create(id).string() == id;
+    }
+
+    //! Remove cached archives of the trees what no reference points to anymore. Other
+    //!files of the archives directory are kept.
+    void prune_cached_archives(const fs::path& archives_dir, const std::list<std::string>& used)
+    {
+        std::set<std::string> keep(used.begin(), used.end());
+
+        for (fs::directory_iterator i(archives_dir), end; i != end; ++i)
+        {
+            fs::path archive = i->path();
+            if (!is_cached_archive(archive) || keep.find(archive.generic_string()) != keep.end())
+            {
+                continue;
+            }
+
+            LOGD << "Remove cached archive: " << archive << ELOG;
+
+            // Checksums go first, so the partially removed archive is not used.
+            boost::system::error_code ec;
+            fs::remove(checksums_path(archive), ec);
+            fs::remove(archive, ec);
+        }
+    }
+
+    //! Upload thread body. Runs concurrently with the archive writing, so must not log.
+    void perform_upload(StreamUploadClient *client, pl::StreamPipe::Ptr pipe, bool *result)
+    {
+        *result = client->perform();
+
+        // Unblock the writer if the upload has stopped before the end of the data.
+        pipe->close_read();
+    }
+
+} // namespace
+
 
 Push::Push(const piel::lib::WorkingCopy::Ptr& working_copy)
     : WorkingCopyCommand(working_copy)
@@ -62,6 +199,8 @@ Push::Push(const piel::lib::WorkingCopy::Ptr& working_copy)
     , server_repository_()
     , query_()
     , zip_list_()
+    , objects_transfer_(false)
+    , deflate_level_(pl::ZipWriter::default_level)
 {
 }
 
@@ -93,6 +232,12 @@ const Push* Push::set_query(const art::lib::GavcQuery &query)
     return this;
 }
 
+const Push* Push::set_objects_transfer(bool objects_transfer)
+{
+    objects_transfer_ = objects_transfer;
+    return this;
+}
+
 void Push::deploy_pom(const boost::filesystem::path &path_to_save_pom)
 {
     pl::MavenPom pom;
@@ -151,16 +296,14 @@ bool Push::upload(const std::string& classifier, const std::string& file_name)
     {
         art::lib::ArtDeployArtifactHandlers deploy_handlers(server_api_access_token_);
 
-        deploy_handlers.set_url(server_url_);
-        deploy_handlers.set_repo(server_repository_);
-        deploy_handlers.set_path(query_.group_path());
-        deploy_handlers.set_name(query_.name());
-        deploy_handlers.set_version(query_.version());
-        deploy_handlers.set_classifier(classifier);
+        init_deploy_handlers(deploy_handlers, classifier);
         deploy_handlers.file(file_name);
 
         piel::lib::CurlEasyClient<art::lib::ArtDeployArtifactHandlers> upload_client(deploy_handlers.gen_uri(), &deploy_handlers);
 
+        // Size is known, so the archive is uploaded without chunked transfer encoding.
+        upload_client.set_upload_size(boost::numeric_cast<curl_off_t>(fs::file_size(file_name)));
+
         LOGD << "Upload: " << file_name << " as " << classifier << " to: " << deploy_handlers.gen_uri() << ELOG;
 
         cout() << "Uploading archive to: " << deploy_handlers.gen_uri();
@@ -185,6 +328,218 @@ bool Push::upload(const std::string& classifier, const std::string& file_name)
     return no_errors;
 }
 
+bool Push::deploy_by_checksums(const std::string& classifier, const piel::lib::ChecksumsDigestBuilder::StrDigests& digests)
+{
+    art::lib::ArtDeployArtifactByChecksumHandlers deploy_handlers(server_api_access_token_, digests);
+    init_deploy_handlers(deploy_handlers, classifier);
+
+    piel::lib::CurlEasyClient<art::lib::ArtDeployArtifactByChecksumHandlers> deploy_client(deploy_handlers.gen_uri(), &deploy_handlers);
+    deploy_client.set_upload_size(0);
+
+    LOGD << "Deploy by checksums: " << classifier << " to: " << deploy_handlers.gen_uri() << ELOG;
+
+    if (!deploy_client.perform())
+    {
+        // Server doesn't have the same content, archive is uploaded.
+        LOGD << deploy_client.curl_error().presentation() << ELOG;
+        return false;
+    }
+
+    cout() << "Deployed existing archive to: " << deploy_handlers.gen_uri() << std::endl;
+
+    Upload::upload_checksums_for(&deploy_handlers, art::lib::ArtBaseConstants::checksums_md5);
+    Upload::upload_checksums_for(&deploy_handlers, art::lib::ArtBaseConstants::checksums_sha1);
+    Upload::upload_checksums_for(&deploy_handlers, art::lib::ArtBaseConstants::checksums_sha256);
+
+    return true;
+}
+
+piel::lib::ChecksumsDigestBuilder::StrDigests Push::write_cached_archive(const boost::filesystem::path& archive,
+        const boost::filesystem::path& temp_dir, const piel::lib::TreeIndex::Ptr& index)
+{
+    fs::path temp_archive = archive.string() + constants::temp_extention;
+    {
+        std::ofstream os(temp_archive.c_str(), std::ofstream::out|std::ofstream::binary|std::ofstream::trunc);
+        write_archive(os, temp_dir, index);
+    }
+
+    std::ifstream is(temp_archive.c_str(), std::ifstream::in|std::ifstream::binary);
+    pl::ChecksumsDigestBuilder digest_builder;
+    pl::ChecksumsDigestBuilder::StrDigests digests = digest_builder.str_digests_for(is);
+    is.close();
+
+    if (digest_builder.bad())
+    {
+        LOGE << "Unable to read archive: " << temp_archive << ELOG;
+
+        throw pl::errors::unable_to_write_zip();
+    }
+
+    store_cached(temp_archive, archive, digests);
+    return digests;
+}
+
+void Push::init_deploy_handlers(art::lib::ArtDeployArtifactHandlers& deploy_handlers, const std::string& classifier)
+{
+    deploy_handlers.set_url(server_url_);
+    deploy_handlers.set_repo(server_repository_);
+    deploy_handlers.set_path(query_.group_path());
+    deploy_handlers.set_name(query_.name());
+    deploy_handlers.set_version(query_.version());
+    deploy_handlers.set_classifier(classifier);
+}
+
+bool Push::upload_archive(const std::string& classifier, const piel::lib::TreeIndex::Ptr& index,
+        const boost::filesystem::path& temp_dir, const boost::filesystem::path& archive)
+{
+    pl::StreamPipe::Ptr pipe = pl::StreamPipe::create();
+
+    art::lib::ArtDeployArtifactStreamHandlers deploy_handlers(server_api_access_token_, pipe);
+    init_deploy_handlers(deploy_handlers, classifier);
+
+    StreamUploadClient upload_client(deploy_handlers.gen_uri(), &deploy_handlers);
+
+    LOGD << "Upload stream as " << classifier << " to: " << deploy_handlers.gen_uri() << ELOG;
+
+    cout() << "Uploading archive to: " << deploy_handlers.gen_uri();
+
+    bool uploaded = false;
+    boost::thread upload_thread(boost::bind(&perform_upload, &upload_client, pipe, &uploaded));
+
+    // Archive is cached while uploaded. Cache write errors don't break the upload, archive
+    // is just not cached.
+    fs::path temp_archive = archive.string() + constants::temp_extention;
+    std::ofstream cache_stream(temp_archive.c_str(), std::ofstream::out|std::ofstream::binary|std::ofstream::trunc);
+
+    try
+    {
+        {
+            boost::shared_ptr<std::ostream> os = pipe->ostream();
+            TeeStream tee_stream(TeeDevice(*os, cache_stream));
+            write_archive(tee_stream, temp_dir, index);
+            tee_stream.flush();
+            os->flush();
+        }
+        pipe->close();
+        upload_thread.join();
+    }
+    catch (const pl::errors::unable_to_write_zip&)
+    {
+        // Pipe is not writable if the upload has failed, the upload error is reported below.
+        pipe->abort();
+        upload_thread.join();
+        if (uploaded)
+        {
+            fs::remove(temp_archive);
+            throw;
+        }
+    }
+    catch (...)
+    {
+        pipe->abort();
+        upload_thread.join();
+        fs::remove(temp_archive);
+        throw;
+    }
+
+    cache_stream.close();
+
+    if (!uploaded || !cache_stream)
+    {
+        fs::remove(temp_archive);
+    }
+
+    if (!uploaded)
+    {
+        cout() << " ERROR" << std::endl;
+
+        LOGE << "Error on upload archive!"                  << ELOG;
+        LOGE << upload_client.curl_error().presentation()   << ELOG;
+
+        throw errors::uploading_classifier_error(upload_client.curl_error().presentation());
+    }
+
+    cout() << " COMPLETE" << std::endl;
+
+    if (cache_stream)
+    {
+        store_cached(temp_archive, archive, deploy_handlers.str_digests());
+    }
+    else
+    {
+        LOGW << "Unable to cache archive: " << archive << ELOG;
+    }
+
+    Upload::upload_checksums_for(&deploy_handlers, art::lib::ArtBaseConstants::checksums_md5);
+    Upload::upload_checksums_for(&deploy_handlers, art::lib::ArtBaseConstants::checksums_sha1);
+    Upload::upload_checksums_for(&deploy_handlers, art::lib::ArtBaseConstants::checksums_sha256);
+
+    return uploaded;
+}
+
+void Push::write_archive(std::ostream& os, const boost::filesystem::path& temp_dir, const piel::lib::TreeIndex::Ptr& index)
+{
+    piel::lib::TreeIndexEnumerator enumerator(index);
+
+    lib::ZipWriter zip(os, temp_dir);
+    zip.set_threads_count(boost::lexical_cast<unsigned int>(
+            working_copy()->config().get(SetConfig::archive_threads).value()));
+    zip.set_level(deflate_level_);
+
+    while (enumerator.next())
+    {
+        LOGD << "\t" << enumerator.path << ":"
+                << enumerator.asset.id().string() << ELOG;
+
+        std::string asset_mode_str = index->get_attr_(enumerator.path, pl::PredefinedAttributes::asset_mode);
+
+        int asset_mode = pl::PredefinedAttributes::parse_asset_mode(asset_mode_str,
+                pl::PredefinedAttributes::default_asset_mode);
+
+        zip.add(enumerator.path, enumerator.asset, asset_mode);
+    }
+
+    zip.write();
+}
+
+/*static*/ bool Push::stream_archives(const std::string& archive_upload)
+{
+    if (archive_upload == constants::archive_upload_stream)
+    {
+        return true;
+    }
+    else if (archive_upload == constants::archive_upload_file)
+    {
+        return false;
+    }
+
+    LOGE << "Unknown archive upload mode: " << archive_upload << ELOG;
+
+    throw errors::unknown_archive_upload();
+}
+
+/*static*/ int Push::archive_deflate_level(const std::string& level)
+{
+    int result = pl::ZipWriter::max_level + 1;
+    try
+    {
+        result = boost::lexical_cast<int>(level);
+    }
+    catch (const boost::bad_lexical_cast&)
+    {
+    }
+
+    if (result < pl::ZipWriter::default_level || result > pl::ZipWriter::max_level)
+    {
+        LOGE << "Archive deflate level must be a number from " << pl::ZipWriter::default_level
+             << " to " << pl::ZipWriter::max_level << ", got: " << level << ELOG;
+
+        throw errors::invalid_archive_deflate_level();
+    }
+
+    return result;
+}
+
 void Push::operator()()
 {
     bool no_errors = true;
@@ -197,6 +552,16 @@ void Push::operator()()
         throw errors::nothing_to_push();
     }
 
+    if (objects_transfer_)
+    {
+        push_objects(all_refs);
+        return;
+    }
+
+    bool stream             = stream_archives(working_copy()->config().get(SetConfig::archive_upload).value());
+    bool checksum_deploy    = working_copy()->config().get(SetConfig::archive_checksum_deploy).value() == "true";
+    deflate_level_          = archive_deflate_level(working_copy()->config().get(SetConfig::archive_deflate_level).value());
+
     boost::filesystem::path version_dir = working_copy()->archives_dir() / query_.version();
     fs::create_directories(version_dir);
 
@@ -211,37 +576,66 @@ void Push::operator()()
         LOGD << log_str << ":" << i->second.string() << ELOG;
 
         piel::lib::TreeIndex::Ptr reference_index = piel::lib::TreeIndex::from_ref(working_copy()->local_storage(), i->first);
-        piel::lib::TreeIndexEnumerator enumerator(reference_index);
 
-        LOGD << "reference_index->self().id().string():" << reference_index->self().id().string() << ELOG;
+        LOGD << "reference_index->id().string():" << reference_index->id().string() << ELOG;
 
-        boost::filesystem::path zip_path_fs = version_dir / (i->first + constants::zip_extention);
+        // Archives are reproducible, so the archive of the same tree and deflate level is reused.
+        std::string classifier = i->first + constants::zip_extention;
+        boost::filesystem::path zip_path = working_copy()->archives_dir() / cached_archive_name(reference_index->self().id(), deflate_level_);
+        zip_list_.push_back(zip_path.generic_string());
 
-        std::string zip_path = zip_path_fs.generic_string();
-        zip_list_.push_back(zip_path);
+        pl::ChecksumsDigestBuilder::StrDigests digests;
+        if (load_checksums(zip_path, digests))
         {
-            lib::ZipFile::FilePtr zip = lib::ZipFile::create(zip_path);
-
-            while (enumerator.next())
-            {
-                LOGD << "\t" << enumerator.path << ":"
-                        << enumerator.asset.id().string() << ELOG;
-
-                std::string asset_mode_str = reference_index->get_attr_(enumerator.path, pl::PredefinedAttributes::asset_mode);
-
-                int asset_mode = pl::PredefinedAttributes::parse_asset_mode(asset_mode_str,
-                        pl::PredefinedAttributes::default_asset_mode);
+            LOGD << "Use cached archive: " << zip_path << ELOG;
+        }
+        else if (stream)
+        {
+            no_errors &= upload_archive(classifier, reference_index, version_dir, zip_path);
+            continue;
+        }
+        else
+        {
+            digests = write_cached_archive(zip_path, version_dir, reference_index);
+        }
 
-                zip->add_istream(enumerator.path, enumerator.asset.istream(), asset_mode);
-            }
+        if (checksum_deploy && deploy_by_checksums(classifier, digests))
+        {
+            continue;
         }
-        no_errors &= upload(i->first + constants::zip_extention, zip_path);
+
+        no_errors &= upload(classifier, zip_path.generic_string());
     }
 
+    prune_cached_archives(working_copy()->archives_dir(), zip_list_);
+
     if (no_errors)
     {
         deploy_pom(version_dir);
     }
 }
 
+void Push::push_objects(const std::set<piel::lib::refs::Ref>& refs)
+{
+    pl::IObjectsStorage::Ptr remote = pl::RemoteObjectsStorage::create_for(server_url_,
+            server_api_access_token_, server_repository_, query_);
+
+    for(std::set<piel::lib::refs::Ref>::const_iterator i = refs.begin(), end = refs.end(); i != end; ++i)
+    {
+        cout() << "Uploading tree: " << i->first;
+
+        try
+        {
+            std::size_t uploaded = pl::ObjectsSync::push(working_copy()->local_storage(), remote, i->first);
+            cout() << " objects: " << uploaded << " COMPLETE" << std::endl;
+        }
+        catch (const pl::errors::remote_storage_error& e)
+        {
+            cout() << " ERROR" << std::endl;
+
+            throw errors::uploading_classifier_error(e.error);
+        }
+    }
+}
+
 } } // namespace piel::cmd
@@ -42,6 +42,8 @@ namespace piel { namespace cmd {
 
 namespace errors {
     struct nothing_to_push {};
+    struct unknown_archive_upload {};
+    struct invalid_archive_deflate_level {};
     struct uploading_classifier_error
     {
         uploading_classifier_error(const std::string& e) : error(e) {}
@@ -66,9 +68,28 @@ public:
     const Push* set_server_api_access_token(const std::string& token);
     const Push* set_server_repository(const std::string& repo);
     const Push* set_query(const art::lib::GavcQuery& query);
+    //! Upload only the objects missing on server instead of the trees archives.
+    const Push* set_objects_transfer(bool objects_transfer);
 
 protected:
     bool upload(const std::string& classifier, const std::string& file_name);
+    //! Upload archive of the tree while it is written and put it into the cache.
+    bool upload_archive(const std::string& classifier, const piel::lib::TreeIndex::Ptr& index,
+            const boost::filesystem::path& temp_dir, const boost::filesystem::path& archive);
+    //! Deploy the archive already known by server, without the upload.
+    //! \return false if server doesn't have the archive content.
+    bool deploy_by_checksums(const std::string& classifier, const piel::lib::ChecksumsDigestBuilder::StrDigests& digests);
+    //! Write archive of the tree into the cache.
+    //! \return Checksums of the archive.
+    piel::lib::ChecksumsDigestBuilder::StrDigests write_cached_archive(const boost::filesystem::path& archive,
+            const boost::filesystem::path& temp_dir, const piel::lib::TreeIndex::Ptr& index);
+    void write_archive(std::ostream& os, const boost::filesystem::path& temp_dir, const piel::lib::TreeIndex::Ptr& index);
+    void init_deploy_handlers(art::lib::ArtDeployArtifactHandlers& deploy_handlers, const std::string& classifier);
+    //! \return true for the stream archive upload mode, false for the file one.
+    static bool stream_archives(const std::string& archive_upload);
+    //! \return Deflate level from -1 to 9.
+    static int archive_deflate_level(const std::string& level);
+    void push_objects(const std::set<piel::lib::refs::Ref>& refs);
     void deploy_pom(const boost::filesystem::path& path_to_save_pom);
 
 private:
@@ -77,6 +98,8 @@ private:
     std::string server_repository_;
     art::lib::GavcQuery query_;
     std::list<std::string> zip_list_;
+    bool objects_transfer_;
+    int deflate_level_;
 };
 
 } } // namespace piel::cmd
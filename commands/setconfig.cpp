@@ -42,6 +42,42 @@ namespace piel { namespace cmd {
 /*static*/ piel::lib::Properties::DefaultFromEnv SetConfig::commiter_email =
         piel::lib::Properties::Property("commiter_email", "unknown", "Commiter email.").default_from_env("PIE_COMMITER_EMAIL");
 
+/*static*/ piel::lib::Properties::DefaultFromEnv SetConfig::storage_format =
+        piel::lib::Properties::Property("storage_format", "loose", "Local objects storage format: loose or packed.").default_from_env("PIE_STORAGE_FORMAT");
+
+/*static*/ piel::lib::Properties::DefaultFromEnv SetConfig::index_layout =
+        piel::lib::Properties::Property("index_layout", "flat", "Committed indexes layout: flat or tree (directory objects shared between commits).").default_from_env("PIE_INDEX_LAYOUT");
+
+/*static*/ piel::lib::Properties::DefaultFromEnv SetConfig::extract_threads =
+        piel::lib::Properties::Property("extract_threads", "0", "Checkout and pull extraction threads: 0 means number of CPUs, 1 extracts serially.").default_from_env("PIE_EXTRACT_THREADS");
+
+/*static*/ piel::lib::Properties::DefaultFromEnv SetConfig::extract_mode =
+        piel::lib::Properties::Property("extract_mode", "clone", "Checkout and pull files extraction: copy, clone (reflink, copy if not supported) or hardlink (read only working copies).").default_from_env("PIE_EXTRACT_MODE");
+
+/*static*/ piel::lib::Properties::DefaultFromEnv SetConfig::archive_threads =
+        piel::lib::Properties::Property("archive_threads", "0", "Push archives compression threads: 0 means number of CPUs, 1 compresses serially.").default_from_env("PIE_ARCHIVE_THREADS");
+
+/*static*/ piel::lib::Properties::DefaultFromEnv SetConfig::archive_deflate_level =
+        piel::lib::Properties::Property("archive_deflate_level", "-1", "Push archives deflate level: 0 stores all files, 1 (fastest) to 9 (smallest), -1 zlib default. Compressed formats are always stored.").default_from_env("PIE_ARCHIVE_DEFLATE_LEVEL");
+
+/*static*/ piel::lib::Properties::DefaultFromEnv SetConfig::archive_upload =
+        piel::lib::Properties::Property("archive_upload", "stream", "Push archives upload: stream (uploaded while compressed) or file (written into the archives directory first, for servers rejecting chunked uploads).").default_from_env("PIE_ARCHIVE_UPLOAD");
+
+/*static*/ piel::lib::Properties::DefaultFromEnv SetConfig::archive_checksum_deploy =
+        piel::lib::Properties::Property("archive_checksum_deploy", "true", "Deploy cached push archives by checksum first, without upload if server has the same content: true or false.").default_from_env("PIE_ARCHIVE_CHECKSUM_DEPLOY");
+
+/*static*/ piel::lib::Properties::DefaultFromEnv SetConfig::object_compression =
+        piel::lib::Properties::Property("object_compression", "none", "Local storage objects compression: none or zlib (already compressed data are stored as is).").default_from_env("PIE_OBJECT_COMPRESSION");
+
+/*static*/ piel::lib::Properties::DefaultFromEnv SetConfig::object_chunking =
+        piel::lib::Properties::Property("object_chunking", "none", "Large files storing: none (single object) or cdc (content defined chunks shared between files versions).").default_from_env("PIE_OBJECT_CHUNKING");
+
+/*static*/ piel::lib::Properties::DefaultFromEnv SetConfig::shared_storages =
+        piel::lib::Properties::Property("shared_storages", "", "Colon separated storage directories looked up for the objects missing in the local storage.").default_from_env("PIE_SHARED_STORAGES");
+
+/*static*/ piel::lib::Properties::DefaultFromEnv SetConfig::promote_shared_objects =
+        piel::lib::Properties::Property("promote_shared_objects", "false", "Copy objects read from the shared storages into the local storage: false or true.").default_from_env("PIE_PROMOTE_SHARED_OBJECTS");
+
 SetConfig::SetConfig(const piel::lib::WorkingCopy::Ptr& working_copy)
     : WorkingCopyCommand(working_copy)
     , global_(false)
@@ -60,6 +96,18 @@ SetConfig::~SetConfig()
         result.insert(std::make_pair(email.name(), email.description()));
         result.insert(std::make_pair(commiter.name(), commiter.description()));
         result.insert(std::make_pair(commiter_email.name(), commiter_email.description()));
+        result.insert(std::make_pair(storage_format.name(), storage_format.description()));
+        result.insert(std::make_pair(index_layout.name(), index_layout.description()));
+        result.insert(std::make_pair(extract_threads.name(), extract_threads.description()));
+        result.insert(std::make_pair(extract_mode.name(), extract_mode.description()));
+        result.insert(std::make_pair(archive_threads.name(), archive_threads.description()));
+        result.insert(std::make_pair(archive_deflate_level.name(), archive_deflate_level.description()));
+        result.insert(std::make_pair(archive_upload.name(), archive_upload.description()));
+        result.insert(std::make_pair(archive_checksum_deploy.name(), archive_checksum_deploy.description()));
+        result.insert(std::make_pair(object_compression.name(), object_compression.description()));
+        result.insert(std::make_pair(object_chunking.name(), object_chunking.description()));
+        result.insert(std::make_pair(shared_storages.name(), shared_storages.description()));
+        result.insert(std::make_pair(promote_shared_objects.name(), promote_shared_objects.description()));
     }
     return result;
 }
@@ -56,6 +56,18 @@ public:
     static piel::lib::Properties::DefaultFromEnv email;
     static piel::lib::Properties::DefaultFromEnv commiter;
     static piel::lib::Properties::DefaultFromEnv commiter_email;
+    static piel::lib::Properties::DefaultFromEnv storage_format;
+    static piel::lib::Properties::DefaultFromEnv index_layout;
+    static piel::lib::Properties::DefaultFromEnv extract_threads;
+    static piel::lib::Properties::DefaultFromEnv extract_mode;
+    static piel::lib::Properties::DefaultFromEnv archive_threads;
+    static piel::lib::Properties::DefaultFromEnv archive_deflate_level;
+    static piel::lib::Properties::DefaultFromEnv archive_upload;
+    static piel::lib::Properties::DefaultFromEnv archive_checksum_deploy;
+    static piel::lib::Properties::DefaultFromEnv object_compression;
+    static piel::lib::Properties::DefaultFromEnv object_chunking;
+    static piel::lib::Properties::DefaultFromEnv shared_storages;
+    static piel::lib::Properties::DefaultFromEnv promote_shared_objects;
 
 private:
     bool        global_;
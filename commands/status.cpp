@@ -84,57 +84,88 @@ Status::~Status()
 {
 }
 
-std::string Status::operator()()
+//! Prints the path and the changes of its attributes.
+//! \return true if something was printed.
+bool Status::print_element(const piel::lib::IndexesDiff& diff,
+        const std::string& path, piel::lib::IndexesDiff::ElementState state) const
 {
-    typedef piel::lib::IndexesDiff::ContentDiff::const_iterator ContentIter;
     typedef piel::lib::IndexesDiff::ContentAttributesDiff::const_iterator ContentAttrsIter;
     typedef piel::lib::IndexesDiff::AttributesDiff AttributesDiff;
     typedef piel::lib::IndexesDiff::AttributesDiff::const_iterator AttrsDiffIter;
 
-    std::string final_status_str = Status_clean;
+    bool printed = false;
 
-    piel::lib::IndexesDiff diff = piel::lib::IndexesDiff::diff(
-            working_copy()->current_tree_state(), working_copy()->working_dir_state());
+    if (fmt::is_printable(state))
+    {
+        cout() << fmt::element_state(state) << " " << path << std::endl;
 
-    for (ContentIter i = diff.content_diff().begin(), end = diff.content_diff().end(); i != end; ++i)
+        printed = true;
+    }
+
+    ContentAttrsIter attributes_element_iter = diff.content_attributes_diff().find(path);
+
+    if (attributes_element_iter == diff.content_attributes_diff().end())
     {
-        ContentAttrsIter attributes_element_iter = diff.content_attributes_diff().find(i->first);
+        return printed;
+    }
 
-        bool has_attrubutes_changes = attributes_element_iter != diff.content_attributes_diff().end();
+    AttributesDiff content_attributes_diff = diff.content_item_attributes_diff(attributes_element_iter);
 
-        if (fmt::is_printable(i->second.first) || has_attrubutes_changes)
+    for (AttrsDiffIter j = content_attributes_diff.begin(), end = content_attributes_diff.end(); j != end; ++j)
+    {
+        if (fmt::is_printable(j->second.first) && j->second.first != piel::lib::IndexesDiff::ElementState_removed)
         {
-            if (fmt::is_printable(i->second.first))
+            if (!printed)
             {
-                cout() << fmt::element_state(i->second.first) << " " << i->first << std::endl;
+                cout() << fmt::element_state(piel::lib::IndexesDiff::ElementState_modified) << " " << path << std::endl;
 
-                final_status_str = Status_dirty;
+                printed = true;
             }
 
-            AttributesDiff content_attributes_diff = diff.content_item_attributes_diff(attributes_element_iter);
+            cout() << fmt::tab(1)
+                      << fmt::element_state(j->second.first)
+                      << " attribute: "
+                      << j->first
+                      << " "
+                      << j->second.second.first
+                      << " -> "
+                      << j->second.second.second
+                      << std::endl;
+        }
+    }
 
-            for (AttrsDiffIter j = content_attributes_diff.begin(), end1 = content_attributes_diff.end(); j != end1; ++j)
-            {
-                if (fmt::is_printable(j->second.first) && j->second.first != piel::lib::IndexesDiff::ElementState_removed)
-                {
-                    if (!fmt::is_printable(i->second.first))
-                    {
-                        cout() << fmt::element_state(i->second.first) << " " << i->first << std::endl;
-                    }
-
-                    cout() << fmt::tab(1)
-                              << fmt::element_state(j->second.first)
-                              << " attribute: "
-                              << j->first
-                              << " "
-                              << j->second.second.first
-                              << " -> "
-                              << j->second.second.second
-                              << std::endl;
-
-                    final_status_str = Status_dirty;
-                }
-            }
+    return printed;
+}
+
+std::string Status::operator()()
+{
+    typedef piel::lib::IndexesDiff::ContentDiff::const_iterator ContentIter;
+    typedef piel::lib::IndexesDiff::ContentAttributesDiff::const_iterator ContentAttrsIter;
+
+    std::string final_status_str = Status_clean;
+
+    piel::lib::IndexesDiff diff = piel::lib::IndexesDiff::diff(
+            working_copy()->current_tree_state(), working_copy()->working_dir_state());
+
+    for (ContentIter i = diff.content_diff().begin(), end = diff.content_diff().end(); i != end; ++i)
+    {
+        if (print_element(diff, i->first, i->second.first))
+        {
+            final_status_str = Status_dirty;
+        }
+    }
+
+    // Diff contains only the changed elements, so the attributes only changes (chmod) are not in the content diff.
+    for (ContentAttrsIter i = diff.content_attributes_diff().begin(), end = diff.content_attributes_diff().end(); i != end; ++i)
+    {
+        if (diff.content_diff().find(i->first) != diff.content_diff().end())
+        {
+            continue;
+        }
+
+        if (print_element(diff, i->first, piel::lib::IndexesDiff::ElementState_unmodified))
+        {
+            final_status_str = Status_dirty;
         }
     }
 
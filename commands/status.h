@@ -31,6 +31,7 @@
 
 #include <workingcopycommand.h>
 #include <iostreamsholder.h>
+#include <indexesdiff.h>
 
 namespace piel { namespace cmd {
 
@@ -45,6 +46,10 @@ public:
 
     std::string operator()();
 
+private:
+    bool print_element(const piel::lib::IndexesDiff& diff,
+            const std::string& path, piel::lib::IndexesDiff::ElementState state) const;
+
 };
 
 } } // namespace piel::cmd
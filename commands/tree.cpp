@@ -61,7 +61,7 @@ void Tree::operator()()
         cout() << working_copy()->current_tree_name();
 
         if (verbose_)
-            cout() << ":" << working_copy()->current_tree_state()->self().id().string();
+            cout() << ":" << working_copy()->current_tree_state()->id().string();
 
         cout() << std::endl;
 
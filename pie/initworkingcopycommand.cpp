@@ -40,6 +40,7 @@ InitWorkingCopyCommand::InitWorkingCopyCommand(Application *app, int argc, char
     , argv_(argv)
     , working_copy_()
     , ref_()
+    , id_algorithm_("sha256")
 {
 }
 
@@ -49,7 +50,7 @@ InitWorkingCopyCommand::~InitWorkingCopyCommand()
 
 void InitWorkingCopyCommand::show_command_help_message(const po::options_description& desc)
 {
-    std::cerr << "Usage: init <tree name>" << std::endl;
+    std::cerr << "Usage: init [--id-algorithm <sha256|blake3>] <tree name>" << std::endl;
     std::cout << desc;
 }
 
@@ -57,7 +58,8 @@ int InitWorkingCopyCommand::perform()
 {
     po::options_description desc("Initialize working copy");
     desc.add_options()
-        ("tree", po::value<std::string>(&ref_)->required(), "Name for tree what will be created on working copy initialization.");
+        ("tree", po::value<std::string>(&ref_)->required(), "Name for tree what will be created on working copy initialization.")
+        ("id-algorithm", po::value<std::string>(&id_algorithm_), "Assets ids algorithm: sha256 (default) or blake3. Can be set by PIE_ID_ALGORITHM environment variable.")
         ;
 
     po::positional_options_description pos_desc;
@@ -74,9 +76,12 @@ int InitWorkingCopyCommand::perform()
     po::store(parsed, vm);
     po::notify(vm);
 
+    get_from_env(vm, "id-algorithm", "PIE_ID_ALGORITHM", id_algorithm_);
+
     try
     {
-        working_copy_ = piel::lib::WorkingCopy::init(boost::filesystem::current_path(), ref_);
+        working_copy_ = piel::lib::WorkingCopy::init(boost::filesystem::current_path(), ref_,
+                piel::lib::AssetId::algorithm_for(id_algorithm_));
 
         std::cout << ref_ << std::endl;
     }
@@ -85,6 +90,11 @@ int InitWorkingCopyCommand::perform()
         std::cerr << "Attempt to initialize already initialized working copy!" << std::endl;
         return -1;
     }
+    catch (const piel::lib::errors::unknown_id_algorithm& e)
+    {
+        std::cerr << "Unknown id algorithm: " << id_algorithm_ << "!" << std::endl;
+        return -1;
+    }
 
     if (!working_copy_->is_valid())
     {
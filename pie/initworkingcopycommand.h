@@ -51,6 +51,7 @@ private:
 
     piel::lib::WorkingCopy::Ptr working_copy_;
     std::string ref_;
+    std::string id_algorithm_;
 
 };
 
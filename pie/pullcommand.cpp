@@ -35,6 +35,8 @@
 #include <artgavchandlers.h>
 #include <logging.h>
 #include <mavenmetadata.h>
+#include <remoteobjectsstorage.h>
+#include <zipimporter.h>
 
 #include <boost/bind.hpp>
 #include <boost_property_tree_ext.hpp>
@@ -57,6 +59,7 @@ PullCommand::PullCommand(Application *app, int argc, char **argv)
     , query_()
     , path_to_download_()
     , classifier_to_checkout_()
+    , objects_transfer_(false)
 {
 }
 
@@ -81,6 +84,7 @@ bool PullCommand::parse_arguments()
         ("repository,r",    po::value<std::string>(&server_repository_),        "Server repository (required). Can be set using GAVC_SERVER_REPOSITORY environment variable.")
         ("path,p",          po::value<std::string>(&path_to_download_),         "New working copy directory.")
         ("classifier,c",    po::value<std::string>(&classifier_to_checkout_),   "Tree name what will be checkout after pulling data.")
+        ("objects,o",                                                           "Download only the objects missing in the local storage (trees must be pushed with --objects). Exact version is needed.")
         ;
 
     if (show_help(desc, argc_, argv_)) {
@@ -124,6 +128,13 @@ bool PullCommand::parse_arguments()
         return false;
     }
 
+    objects_transfer_ = vm.count("objects");
+    if (objects_transfer_ && !query_.is_exact_version_query())
+    {
+        std::cerr << "Exact version is needed for the objects transfer!" << std::endl;
+        return false;
+    }
+
     bool get_env_flag = true;
     get_env_flag &= get_from_env(vm, "token",       "GAVC_SERVER_API_ACCESS_TOKEN", server_api_access_token_);
     get_env_flag &= get_from_env(vm, "server",      "GAVC_SERVER_URL",              server_url_);
@@ -154,6 +165,7 @@ bool PullCommand::parse_arguments()
 
         pull.set_path_to_download(path_to_download_);
         pull.set_classifier_to_checkout(classifier_to_checkout_);
+        pull.set_objects_transfer(objects_transfer_);
 
         pull();
     }
@@ -211,6 +223,21 @@ bool PullCommand::parse_arguments()
         std::cerr << "Unable to find reference file at working copy!" << std::endl;
         return -1;
     }
+    catch (const piel::lib::errors::remote_storage_error& e)
+    {
+        std::cerr << "Objects downloading error:" << e.error << std::endl;
+        return -1;
+    }
+    catch (const piel::lib::errors::unable_to_open_zip&)
+    {
+        std::cerr << "Unable to open downloaded archive!" << std::endl;
+        return -1;
+    }
+    catch (const piel::lib::errors::unable_to_inflate_zip_entry&)
+    {
+        std::cerr << "Downloaded archive is corrupted!" << std::endl;
+        return -1;
+    }
 
     result = 0;
 
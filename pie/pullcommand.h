@@ -60,6 +60,7 @@ private:
     art::lib::GavcQuery query_;
     std::string path_to_download_;
     std::string classifier_to_checkout_;
+    bool objects_transfer_;
 };
 
 } } // namespace pie::app
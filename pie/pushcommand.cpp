@@ -34,6 +34,7 @@
 #include <artgavchandlers.h>
 #include <logging.h>
 #include <mavenmetadata.h>
+#include <zipwriter.h>
 
 #include <boost/bind.hpp>
 #include <boost_property_tree_ext.hpp>
@@ -54,6 +55,7 @@ PushCommand::PushCommand(Application *app, int argc, char **argv)
     , server_api_access_token_()
     , server_repository_()
     , query_()
+    , objects_transfer_(false)
 {
 }
 
@@ -76,6 +78,7 @@ bool PushCommand::parse_arguments()
         ("token,t",         po::value<std::string>(&server_api_access_token_),  "Token to access server remote api (required). Can be set using GAVC_SERVER_API_ACCESS_TOKEN environment variable.")
         ("server,s",        po::value<std::string>(&server_url_),               "Server url (required). Can be set using GAVC_SERVER_URL environment variable.")
         ("repository,r",    po::value<std::string>(&server_repository_),        "Server repository (required). Can be set using GAVC_SERVER_REPOSITORY environment variable.")
+        ("objects,o",                                                           "Upload only the objects missing on server instead of the trees archives.")
         ;
 
     if (show_help(desc, argc_, argv_)) {
@@ -119,6 +122,8 @@ bool PushCommand::parse_arguments()
         return false;
     }
 
+    objects_transfer_ = vm.count("objects");
+
     bool get_env_flag = true;
     get_env_flag &= get_from_env(vm, "token",       "GAVC_SERVER_API_ACCESS_TOKEN", server_api_access_token_);
     get_env_flag &= get_from_env(vm, "server",      "GAVC_SERVER_URL",              server_url_);
@@ -150,6 +155,7 @@ bool PushCommand::parse_arguments()
         push.set_server_api_access_token(server_api_access_token_);
         push.set_server_repository(server_repository_);
         push.set_query(query_);
+        push.set_objects_transfer(objects_transfer_);
 
         push();
 
@@ -169,6 +175,16 @@ bool PushCommand::parse_arguments()
         std::cerr << "No changes!" << std::endl;
         return -1;
     }
+    catch (const piel::cmd::errors::unknown_archive_upload&)
+    {
+        std::cerr << "Unknown archive_upload config value! Supported: stream, file." << std::endl;
+        return -1;
+    }
+    catch (const piel::cmd::errors::invalid_archive_deflate_level&)
+    {
+        std::cerr << "Invalid archive_deflate_level config value! Supported: -1 (zlib default), 0 to 9." << std::endl;
+        return -1;
+    }
     catch (const piel::cmd::errors::uploading_classifier_error& e)
     {
         std::cerr << "Classifier uploading error:" << e.error << std::endl;
@@ -184,6 +200,16 @@ bool PushCommand::parse_arguments()
         std::cerr << "Uploading checksum error:" << e.error << std::endl;
         return -1;
     }
+    catch (const piel::lib::errors::unable_to_write_zip&)
+    {
+        std::cerr << "Unable to write classifier archive!" << std::endl;
+        return -1;
+    }
+    catch (const piel::lib::errors::unable_to_deflate_zip_entry&)
+    {
+        std::cerr << "Unable to compress classifier archive entry!" << std::endl;
+        return -1;
+    }
 
     if (!working_copy_->is_valid())
     {
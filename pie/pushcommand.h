@@ -58,6 +58,7 @@ private:
     std::string server_repository_;
 
     art::lib::GavcQuery query_;
+    bool objects_transfer_;
 
     piel::lib::WorkingCopy::Ptr working_copy_;
 };
@@ -37,6 +37,10 @@ namespace art { namespace lib {
 /*static*/ const std::string ArtBaseConstants::rest_api_header__access_key          = "X-JFrog-Art-Api:";
 /*static*/ const std::string ArtBaseConstants::rest_api_header__gavc_details        = "X-Result-Detail:";
 /*static*/ const std::string ArtBaseConstants::rest_api_header__gavc_details_value  = "info, properties";
+/*static*/ const std::string ArtBaseConstants::rest_api_header__checksum_deploy     = "X-Checksum-Deploy:";
+/*static*/ const std::string ArtBaseConstants::rest_api_header__checksum_deploy_value = "true";
+/*static*/ const std::string ArtBaseConstants::rest_api_header__checksum_sha1       = "X-Checksum-Sha1:";
+/*static*/ const std::string ArtBaseConstants::rest_api_header__checksum_sha256     = "X-Checksum-Sha256:";
 
 /*static*/ const std::string ArtBaseConstants::uri_delimiter                        = "/";
 /*static*/ const std::string ArtBaseConstants::checksums_md5                        = "md5";
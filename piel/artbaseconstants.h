@@ -42,6 +42,10 @@ struct ArtBaseConstants {
     static const std::string rest_api_header__access_key;
     static const std::string rest_api_header__gavc_details;
     static const std::string rest_api_header__gavc_details_value;
+    static const std::string rest_api_header__checksum_deploy;
+    static const std::string rest_api_header__checksum_deploy_value;
+    static const std::string rest_api_header__checksum_sha1;
+    static const std::string rest_api_header__checksum_sha256;
 
     static const std::string uri_delimiter;
 
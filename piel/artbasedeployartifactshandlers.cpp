@@ -108,6 +108,11 @@ piel::lib::ChecksumsDigestBuilder::StrDigests& ArtBaseDeployArtifactsHandlers::s
     return str_digests_;
 }
 
+void ArtBaseDeployArtifactsHandlers::set_str_digests(const piel::lib::ChecksumsDigestBuilder::StrDigests& digests)
+{
+    str_digests_ = digests;
+}
+
 size_t ArtBaseDeployArtifactsHandlers::handle_input(char *ptr, size_t size)
 {
     if (first_call_)
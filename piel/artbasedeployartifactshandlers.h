@@ -68,6 +68,8 @@ public:
     size_t putto(char* ptr, size_t size);
 
     piel::lib::ChecksumsDigestBuilder::StrDigests& str_digests(bool reset = false);
+    //! Set checksums of the data known in advance.
+    void set_str_digests(const piel::lib::ChecksumsDigestBuilder::StrDigests& digests);
 
 protected:
     std::string trim(const std::string& src);
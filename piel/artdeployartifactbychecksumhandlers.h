@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef ARTDEPLOYARTIFACTBYCHECKSUMHANDLERS_H
+#define ARTDEPLOYARTIFACTBYCHECKSUMHANDLERS_H
+
+#include <artdeployartifacthandlers.h>
+
+namespace art { namespace lib {
+
+//! Handlers to deploy the artifact by checksums, without the data upload. Server
+//!responds 404 if it doesn't have the content with the same checksums.
+class ArtDeployArtifactByChecksumHandlers: public ArtDeployArtifactHandlers
+{
+public:
+    //! Constructor.
+    //! \param api_token Artifactory server REST api access token.
+    //! \param digests Checksums of the artifact data.
+    ArtDeployArtifactByChecksumHandlers(const std::string& api_token, const piel::lib::ChecksumsDigestBuilder::StrDigests& digests);
+    virtual ~ArtDeployArtifactByChecksumHandlers();
+
+    virtual piel::lib::CurlEasyHandlers::headers_type custom_header();
+    virtual size_t handle_input(char *ptr, size_t size);
+};
+
+} } // namespace art::lib
+
+#endif // ARTDEPLOYARTIFACTBYCHECKSUMHANDLERS_H
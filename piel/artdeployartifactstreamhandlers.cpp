@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <artdeployartifactstreamhandlers.h>
+
+//      custom_header,    handle_header,  handle_input,   handle_output,  before_input,   before_output)
+CURLH_T_(art::lib::ArtDeployArtifactStreamHandlers,\
+        true,             false,          true,           true,           false,          false);
+
+namespace art { namespace lib {
+
+ArtDeployArtifactStreamHandlers::ArtDeployArtifactStreamHandlers(const std::string& api_token, const piel::lib::StreamPipe::Ptr& pipe)
+    : ArtDeployArtifactHandlers(api_token)
+    , pipe_(pipe)
+{
+    push_input_stream(pipe_->istream());
+}
+
+/*virtual*/ ArtDeployArtifactStreamHandlers::~ArtDeployArtifactStreamHandlers()
+{
+}
+
+/*virtual*/ size_t ArtDeployArtifactStreamHandlers::handle_input(char *ptr, size_t size)
+{
+    size_t result = ArtDeployArtifactHandlers::handle_input(ptr, size);
+
+    // Incomplete data must not be deployed.
+    if (pipe_->aborted())
+    {
+        return CURL_READFUNC_ABORT;
+    }
+
+    return result;
+}
+
+/*virtual*/ size_t ArtDeployArtifactStreamHandlers::handle_output(char *ptr, size_t size)
+{
+    // Server response is not used.
+    return size;
+}
+
+} } // namespace art::lib
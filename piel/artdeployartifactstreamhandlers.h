@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef ARTDEPLOYARTIFACTSTREAMHANDLERS_H
+#define ARTDEPLOYARTIFACTSTREAMHANDLERS_H
+
+#include <artdeployartifacthandlers.h>
+#include <streampipe.h>
+
+namespace art { namespace lib {
+
+//! Handlers to deploy the artifact data produced concurrently into the pipe. Checksums
+//!are calculated while the data are uploaded.
+//!
+//! Handlers are called on the uploading thread, so they don't log. Upload is aborted if
+//!the pipe writer has aborted the data.
+class ArtDeployArtifactStreamHandlers: public ArtDeployArtifactHandlers
+{
+public:
+    //! Constructor.
+    //! \param api_token Artifactory server REST api access token.
+    //! \param pipe Pipe with the artifact data.
+    ArtDeployArtifactStreamHandlers(const std::string& api_token, const piel::lib::StreamPipe::Ptr& pipe);
+    virtual ~ArtDeployArtifactStreamHandlers();
+
+    virtual size_t handle_input(char *ptr, size_t size);
+    virtual size_t handle_output(char *ptr, size_t size);
+
+private:
+    piel::lib::StreamPipe::Ptr pipe_;   //!< Artifact data.
+};
+
+} } // namespace art::lib
+
+#endif // ARTDEPLOYARTIFACTSTREAMHANDLERS_H
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <artstreamuploadhandlers.h>
+
+//      custom_header,    handle_header,  handle_input,   handle_output,  before_input,   before_output)
+CURLH_T_(art::lib::ArtStreamUploadHandlers,\
+        true,             false,          true,           true,           false,          false);
+
+namespace art { namespace lib {
+
+ArtStreamUploadHandlers::ArtStreamUploadHandlers(const std::string& api_token, const boost::shared_ptr<std::istream>& is)
+    : ArtBaseApiHandlers(api_token)
+    , is_(is)
+{
+}
+
+/*virtual*/ ArtStreamUploadHandlers::~ArtStreamUploadHandlers()
+{
+}
+
+/*virtual*/ size_t ArtStreamUploadHandlers::handle_input(char *ptr, size_t size)
+{
+    if (!is_ || !*is_)
+    {
+        return 0;
+    }
+
+    return static_cast<size_t>(is_->read(ptr, size).gcount());
+}
+
+/*virtual*/ size_t ArtStreamUploadHandlers::handle_output(char *ptr, size_t size)
+{
+    // Server response is not used.
+    return size;
+}
+
+} } // namespace art::lib
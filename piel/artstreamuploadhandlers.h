@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef ARTSTREAMUPLOADHANDLERS_H
+#define ARTSTREAMUPLOADHANDLERS_H
+
+#include <artbaseapihandlers.h>
+
+#include <istream>
+#include <boost/shared_ptr.hpp>
+
+namespace art { namespace lib {
+
+//! Handlers to upload (PUT) the stream data as is. Unlike deploy handlers they don't
+//! expect artifactory JSON response, so any HTTP server what accepts PUT can be used.
+class ArtStreamUploadHandlers: public ArtBaseApiHandlers
+{
+public:
+    //! Constructor.
+    //! \param api_token Artifactory server REST api access token.
+    //! \param is Stream with the data to upload.
+    ArtStreamUploadHandlers(const std::string& api_token, const boost::shared_ptr<std::istream>& is);
+    virtual ~ArtStreamUploadHandlers();
+
+    virtual size_t handle_input(char *ptr, size_t size);
+    virtual size_t handle_output(char *ptr, size_t size);
+
+private:
+    boost::shared_ptr<std::istream> is_;    //!< Data to upload.
+};
+
+} } // namespace art::lib
+
+#endif // ARTSTREAMUPLOADHANDLERS_H
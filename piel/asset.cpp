@@ -81,8 +81,23 @@ public:
         return id_;
     }
 
+    bool id_calculated() const
+    {
+        return id_ != AssetId::not_calculated;
+    }
+
     virtual boost::shared_ptr<std::istream> istream() const = 0;
 
+    virtual std::size_t size() const
+    {
+        return 0;
+    }
+
+    virtual boost::filesystem::path file_path() const
+    {
+        return boost::filesystem::path();
+    }
+
     virtual AssetImpl *clone() const = 0;
 
 protected:
@@ -133,6 +148,11 @@ public:
         return boost::shared_ptr<std::istream>(new std::istringstream(str_));
     }
 
+    std::size_t size() const
+    {
+        return str_.size();
+    }
+
     AssetImpl *clone() const
     {
         return new StringImpl(*this);
@@ -158,11 +178,29 @@ public:
     {
     }
 
+    FileImpl(const boost::filesystem::path& file_path, const AssetId& id)
+        : AssetImpl(id)
+        , file_path_(file_path)
+    {
+    }
+
     boost::shared_ptr<std::istream> istream() const
     {
         return boost::shared_ptr<std::istream>(new std::ifstream(file_path_.c_str(), std::ifstream::in|std::ifstream::binary));
     }
 
+    std::size_t size() const
+    {
+        boost::system::error_code ec;
+        boost::uintmax_t size = boost::filesystem::file_size(file_path_, ec);
+        return ec ? 0 : static_cast<std::size_t>(size);
+    }
+
+    boost::filesystem::path file_path() const
+    {
+        return file_path_;
+    }
+
     AssetImpl *clone() const
     {
         return new FileImpl(*this);
@@ -223,6 +261,16 @@ public:
         return storage_->istream_for(id_);
     }
 
+    std::size_t size() const
+    {
+        return storage_->size_of(id_);
+    }
+
+    boost::filesystem::path file_path() const
+    {
+        return storage_->object_file(id_);
+    }
+
     AssetImpl *clone() const
     {
         return new StorageImpl(*this);
@@ -315,11 +363,26 @@ const AssetId& Asset::id() const
     return impl_->id();
 }
 
+bool Asset::id_calculated() const
+{
+    return impl_->id_calculated();
+}
+
 boost::shared_ptr<std::istream> Asset::istream() const
 {
     return impl_->istream();
 }
 
+std::size_t Asset::size() const
+{
+    return impl_->size();
+}
+
+boost::filesystem::path Asset::file_path() const
+{
+    return impl_->file_path();
+}
+
 /*static*/ Asset Asset::create_id(const AssetId& id)
 {
     return Asset(new IdImpl(id));
@@ -345,6 +408,11 @@ boost::shared_ptr<std::istream> Asset::istream() const
     return Asset(new FileImpl(file_path));
 }
 
+/*static*/ Asset Asset::create_for(const boost::filesystem::path& file_path, const AssetId& id)
+{
+    return Asset(new FileImpl(file_path, id));
+}
+
 /*static*/ Asset Asset::create_for(boost::shared_ptr<ZipEntry> entry)
 {
     return Asset(new ZipEntryImpl(entry));
@@ -59,14 +59,22 @@ public:
     operator AssetId() const;
 
     const AssetId& id() const;
+    bool id_calculated() const;
     boost::shared_ptr<std::istream> istream() const;
 
+    //! Asset data size if it is known without reading the data, 0 otherwise.
+    std::size_t size() const;
+
+    //! Local file what holds exactly the asset data, empty path if there is no such file.
+    boost::filesystem::path file_path() const;
+
     static Asset create_id(const AssetId& id);
 
     static Asset create_for(const boost::shared_ptr<IObjectsStorage>& storage, const AssetId& id);
 //    static Asset create_for(const IObjectsStorage* storage, const AssetId& id);
     static Asset create_for(const std::string& str_data);
     static Asset create_for(const boost::filesystem::path& file_path);
+    static Asset create_for(const boost::filesystem::path& file_path, const AssetId& known_id);
     static Asset create_for(boost::shared_ptr<ZipEntry> entry);
 
     static void store(boost::property_tree::ptree& tree, const Asset& asset);
@@ -28,55 +28,189 @@
 
 #include <assetid.h>
 #include <checksumsdigestbuilder.hpp>
+#include <hexcodec.h>
+#include <logging.h>
+
+#include <boost/thread/tss.hpp>
+
+#include <cstring>
 
 namespace piel { namespace lib {
 
-const AssetId AssetId::not_calculated("<not calculated>");
-const AssetId AssetId::empty("<empty>");
+namespace constants {
+    static const char *str_not_calculated   = "<not calculated>";
+    static const char *str_empty            = "<empty>";
+    static const char *str_invalid          = "<invalid>";
+}
+
+static_assert(AssetId::digest_len == SHA256_DIGEST_LENGTH, "AssetId digest length must match SHA-256 digest length.");
+static_assert(AssetId::digest_len == Blake3Hasher::out_len, "AssetId digest length must match BLAKE3 digest length.");
+
+namespace {
+    AssetId::Algorithm current_algorithm = AssetId::Algorithm_sha256;
+}
+
+const unsigned int AssetId::digest_len;
+
+const AssetId AssetId::not_calculated(AssetId::Kind_not_calculated);
+const AssetId AssetId::empty(AssetId::Kind_empty);
 
 const std::string AssetId::digest_algo      = Sha256::t::name();
 const unsigned int AssetId::str_digest_len  = Sha256::t::len() * 2;
 
 AssetId::AssetId()
-    : id_(AssetId::empty.id_)
+    : kind_(Kind_empty)
+    , digest_()
+{
+}
+
+AssetId::AssetId(Kind kind)
+    : kind_(kind)
+    , digest_()
 {
 }
 
 AssetId::AssetId(const std::string& id)
-    : id_(id)
+    : kind_(Kind_invalid)
+    , digest_()
 {
+    assign(id);
 }
 
 AssetId::AssetId(std::istream& is)
-    : id_()
+    : kind_(Kind_invalid)
+    , digest_()
+{
+    // Each thread reuses its builders: no contexts and IO buffer allocations per asset.
+    static boost::thread_specific_ptr<ChecksumsDigestBuilder> sha256_builder;
+    static boost::thread_specific_ptr<ChecksumsDigestBuilder> blake3_builder;
+
+    Algorithm algo = algorithm();
+    boost::thread_specific_ptr<ChecksumsDigestBuilder>& builder =
+            algo == Algorithm_blake3 ? blake3_builder : sha256_builder;
+    if (!builder.get())
+    {
+        builder.reset(new ChecksumsDigestBuilder(algorithm_digest(algo)));
+    }
+
+    ChecksumsDigestBuilder::Digests digests = builder->digests_for(is);
+    std::memcpy(digest_, digests[algorithm_name(algo)].data(), digest_len);
+    kind_ = Kind_digest;
+}
+
+/*static*/ void AssetId::set_algorithm(Algorithm algorithm)
+{
+    current_algorithm = algorithm;
+}
+
+/*static*/ AssetId::Algorithm AssetId::algorithm()
+{
+    return current_algorithm;
+}
+
+/*static*/ std::string AssetId::algorithm_name(Algorithm algorithm)
+{
+    return algorithm == Algorithm_blake3 ? Blake3::t::name() : Sha256::t::name();
+}
+
+/*static*/ AssetId::Algorithm AssetId::algorithm_for(const std::string& name)
+{
+    if (name == Sha256::t::name() || name == "sha256")
+    {
+        return Algorithm_sha256;
+    }
+    else if (name == Blake3::t::name() || name == "blake3")
+    {
+        return Algorithm_blake3;
+    }
+
+    LOGE << "Unknown id algorithm: " << name << ELOG;
+
+    throw errors::unknown_id_algorithm();
+}
+
+/*static*/ int AssetId::algorithm_digest(Algorithm algorithm)
 {
-    ChecksumsDigestBuilder digestBuilder;
-    ChecksumsDigestBuilder::StrDigests str_digests = digestBuilder.str_digests_for(is);
-    id_ = str_digests[AssetId::digest_algo];
+    return algorithm == Algorithm_blake3 ? ChecksumsDigestBuilder::Digest_blake3 : ChecksumsDigestBuilder::Digest_sha256;
 }
 
 AssetId::AssetId(const AssetId& src)
-    : id_(src.id_)
+    : kind_(src.kind_)
 {
+    std::memcpy(digest_, src.digest_, digest_len);
 }
 
 AssetId::~AssetId()
 {
 }
 
+AssetId& AssetId::operator=(const AssetId& src)
+{
+    kind_ = src.kind_;
+    std::memcpy(digest_, src.digest_, digest_len);
+    return *this;
+}
+
+void AssetId::assign(const std::string& id)
+{
+    if (id.length() == str_digest_len && HexCodec::decode(id.data(), id.length(), digest_))
+    {
+        kind_ = Kind_digest;
+    }
+    else if (id == constants::str_empty)
+    {
+        kind_ = Kind_empty;
+    }
+    else if (id == constants::str_not_calculated)
+    {
+        kind_ = Kind_not_calculated;
+    }
+    else
+    {
+        kind_ = Kind_invalid;
+    }
+
+    if (kind_ != Kind_digest)
+    {
+        std::memset(digest_, 0, digest_len);
+    }
+}
+
 bool AssetId::operator==(const AssetId& src) const
 {
-    return id_ == src.id_;
+    return kind_ == src.kind_ && std::memcmp(digest_, src.digest_, digest_len) == 0;
 }
 
 bool AssetId::operator!=(const AssetId& src) const
 {
-    return id_ != src.id_;
+    return !operator==(src);
 }
 
 bool AssetId::operator<(const AssetId& src) const
 {
-    return id_ < src.id_;
+    if (kind_ != src.kind_)
+    {
+        return kind_ < src.kind_;
+    }
+    return std::memcmp(digest_, src.digest_, digest_len) < 0;
+}
+
+bool AssetId::has_digest() const
+{
+    return kind_ == Kind_digest;
+}
+
+const unsigned char *AssetId::data() const
+{
+    return digest_;
+}
+
+std::size_t AssetId::hash() const
+{
+    // Digest bytes are uniformly distributed, so its prefix is a good hash.
+    std::size_t result;
+    std::memcpy(&result, digest_, sizeof(result));
+    return result ^ static_cast<std::size_t>(kind_);
 }
 
 AssetId AssetId::create_for(std::istream& is)
@@ -89,9 +223,22 @@ AssetId AssetId::create(const std::string& id)
     return AssetId(id);
 }
 
+AssetId AssetId::create(const unsigned char *digest)
+{
+    AssetId result(Kind_digest);
+    std::memcpy(result.digest_, digest, digest_len);
+    return result;
+}
+
 std::string AssetId::string() const
 {
-    return id_;
+    switch (kind_)
+    {
+    case Kind_digest:           return HexCodec::encode(digest_, digest_len);
+    case Kind_empty:            return constants::str_empty;
+    case Kind_not_calculated:   return constants::str_not_calculated;
+    default:                    return constants::str_invalid;
+    }
 }
 
 } } // namespace piel::lib
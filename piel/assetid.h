@@ -29,18 +29,37 @@
 #ifndef PIEL_ASSETID_H_
 #define PIEL_ASSETID_H_
 
+#include <cstddef>
+#include <functional>
 #include <iostream>
 #include <string>
 
 namespace piel { namespace lib {
 
+namespace errors {
+    struct unknown_id_algorithm {};
+};
+
+//! Asset identifier. Holds binary digest of the asset content, or one of the
+//! special values (empty, not calculated). String representation is produced
+//! only on demand.
+//!
+//! Digest algorithm is process wide: repository records the algorithm of its ids
+//! and working copy selects it before any id is calculated.
 class AssetId
 {
 public:
+    //! Ids digest algorithms. Both produce digest_len bytes digests.
+    enum Algorithm {
+        Algorithm_sha256,   //!< SHA-256. Default, used by repositories without algorithm record.
+        Algorithm_blake3,   //!< BLAKE3. Faster, large assets are hashed by several threads.
+    };
+
     static const AssetId not_calculated;
     static const AssetId empty;
-    static const std::string digest_algo;
+    static const std::string digest_algo;           //!< Default algorithm digest name.
     static const unsigned int str_digest_len;
+    static const unsigned int digest_len = 32;  //!< Binary digest length.
 
     AssetId();
     AssetId(std::istream& is);
@@ -49,6 +68,8 @@ public:
 
     ~AssetId();
 
+    AssetId& operator=(const AssetId& src);
+
     bool operator==(const AssetId& src) const;
     bool operator!=(const AssetId& src) const;
 
@@ -56,14 +77,71 @@ public:
 
     std::string string() const;
 
+    //! \return true if id holds the content digest (is not a special value).
+    bool has_digest() const;
+
+    //! \return Binary digest data, digest_len bytes.
+    const unsigned char *data() const;
+
+    //! \return Hash value suitable for the unordered containers.
+    std::size_t hash() const;
+
+    //! Set ids algorithm. Must be called before ids calculations.
+    static void set_algorithm(Algorithm algorithm);
+    static Algorithm algorithm();
+
+    //! \return Algorithm digest name (ChecksumsDigestBuilder digests key).
+    static std::string algorithm_name(Algorithm algorithm);
+
+    //! Find algorithm by the digest name ("SHA-256", "BLAKE3") or short name
+    //! ("sha256", "blake3"). Throws errors::unknown_id_algorithm.
+    static Algorithm algorithm_for(const std::string& name);
+
+    //! \return ChecksumsDigestBuilder::Digest flag of the algorithm.
+    static int algorithm_digest(Algorithm algorithm);
+
     static AssetId create_for(std::istream& is);
     static AssetId create(const std::string& id);
 
+    //! Create id from the binary digest.
+    //! \param digest Binary digest, digest_len bytes.
+    static AssetId create(const unsigned char *digest);
+
 private:
-    std::string id_;
+    enum Kind {
+        Kind_digest,
+        Kind_empty,
+        Kind_not_calculated,
+        Kind_invalid,
+    };
+
+    explicit AssetId(Kind kind);
+
+    void assign(const std::string& id);
+
+private:
+    Kind kind_;
+    unsigned char digest_[digest_len];
 
 };
 
+inline std::size_t hash_value(const AssetId& id)
+{
+    return id.hash();
+}
+
 } } // namespace piel::lib
 
+namespace std {
+
+template<> struct hash<piel::lib::AssetId>
+{
+    std::size_t operator()(const piel::lib::AssetId& id) const
+    {
+        return id.hash();
+    }
+};
+
+} // namespace std
+
 #endif /* PIEL_ASSETID_H_ */
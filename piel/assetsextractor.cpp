@@ -27,16 +27,318 @@
  */
 
 #include <assetsextractor.h>
+#include <indexesdiff.h>
 #include <logging.h>
+#include <blake3.h>
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/thread.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <deque>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/fs.h>
+#endif
 
 namespace piel { namespace lib {
 
 namespace fs = boost::filesystem;
 
+//! Ids of the object files what were checked before they were cloned or linked into the items.
+//! Shared by the extraction workers, so each object is read only once per extraction.
+class VerifiedObjects {
+public:
+    //! \return true if the object file data match the id.
+    bool verify(const AssetId& id, const fs::path& source)
+    {
+        {
+            boost::unique_lock<boost::mutex> lock(mutex_);
+            if (ids_.find(id) != ids_.end())
+            {
+                return true;
+            }
+        }
+
+        boost::shared_ptr<std::istream> isp = fs::istream(source);
+        if (!isp || AssetId::create_for(*isp) != id)
+        {
+            return false;
+        }
+
+        boost::unique_lock<boost::mutex> lock(mutex_);
+        ids_.insert(id);
+        return true;
+    }
+
+private:
+    std::set<AssetId>   ids_;
+    boost::mutex        mutex_;
+};
+
+namespace {
+
+    //! Check if the file has given mode. Hard linked items share the mode with the object file.
+    bool has_mode(const fs::path& path, int mode)
+    {
+        boost::system::error_code ec;
+        fs::file_status status = fs::status(path, ec);
+        return !ec && (status.permissions() & fs::perms_mask) == (((fs::perms)mode) & fs::perms_mask);
+    }
+
+    //! Clone (reflink) or hard link the object file into the item, so the data is not copied through the user space.
+    //! \return false if the file system doesn't support it and the data has to be copied.
+    bool clone_item(const fs::path& source, const fs::path& item_path, bool hard_link)
+    {
+        if (hard_link)
+        {
+            boost::system::error_code ec;
+            fs::create_hard_link(source, item_path, ec);
+            return !ec;
+        }
+
+#if defined(__linux__)
+        int src = ::open(source.c_str(), O_RDONLY | O_CLOEXEC);
+        if (src < 0)
+        {
+            return false;
+        }
+
+        struct stat st;
+        int dst = ::fstat(src, &st) == 0 ? ::open(item_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600) : -1;
+
+        bool cloned = false;
+        if (dst >= 0)
+        {
+#if defined(FICLONE)
+            cloned = ::ioctl(dst, FICLONE, src) == 0;
+#endif
+#if defined(SYS_copy_file_range)
+            // In kernel copy, file systems what support it share the extents.
+            if (!cloned)
+            {
+                off_t left = st.st_size;
+                for (long copied = 1; left > 0 && copied > 0; )
+                {
+                    copied = ::syscall(SYS_copy_file_range, src, 0, dst, 0, static_cast<std::size_t>(left), 0u);
+                    if (copied > 0)
+                    {
+                        left -= copied;
+                    }
+                }
+                cloned = left == 0;
+            }
+#endif
+            ::close(dst);
+
+            if (!cloned)
+            {
+                ::unlink(item_path.c_str());
+            }
+        }
+
+        ::close(src);
+
+        return cloned;
+#else
+        return false;
+#endif
+    }
+
+    //! Write asset data into the item. Called by the extraction workers, so it must not log.
+    //! \param source Local file with the asset data or empty path.
+    //! \param isp Asset data stream, if null the data is read from the source.
+    void write_item(const fs::path& item_path, const AssetId& id, const std::string& asset_type, int asset_mode,
+            const fs::path& source, boost::shared_ptr<std::istream> isp, int politic, VerifiedObjects *verified)
+    {
+        if (!isp && !source.empty())
+        {
+            isp = fs::istream(source);
+        }
+
+        if (asset_type == PredefinedAttributes::asset_type__file)
+        {
+            if (!source.empty() && (politic & (ExtractPolicy__clone_objects | ExtractPolicy__link_objects)))
+            {
+                // Clone doesn't read the data, so the object is checked as the copy does.
+                if (!verified->verify(id, source))
+                {
+                    throw errors::exported_data_is_corrupted();
+                }
+
+                // Object file is never chmoded, so only the object files with the asset mode are linked.
+                if ((politic & ExtractPolicy__link_objects) && has_mode(source, asset_mode)
+                        && clone_item(source, item_path, true))
+                {
+                    return;
+                }
+
+                if (clone_item(source, item_path, false))
+                {
+                    fs::permissions(item_path, (fs::perms)asset_mode);
+                    return;
+                }
+            }
+
+            boost::shared_ptr<std::ostream> osp = fs::ostream(item_path);
+
+            if (id != fs::copy_into(osp, isp))
+            {
+                throw errors::exported_data_is_corrupted();
+            }
+
+            osp.reset();
+
+            fs::permissions(item_path, (fs::perms)asset_mode);
+        }
+        else if (asset_type == PredefinedAttributes::asset_type__symlink)
+        {
+            std::ostringstream* ossp = new std::ostringstream();
+            boost::shared_ptr<std::ostream> oss(ossp);
+
+            if (id != fs::copy_into(oss, isp))
+            {
+                throw errors::exported_data_is_corrupted();
+            }
+
+            fs::create_symlink(ossp->str(), item_path);
+
+            // TODO: permissions for symlinks
+            //fs::permissions(item_path, fs::perms::symlink_perms|((fs::perms)asset_mode));
+        }
+        else
+        {
+            throw errors::unknown_asset_type();
+        }
+    }
+
+    //! Item prepared on the main thread to be written by the extraction workers.
+    struct ExtractJob {
+        ExtractJob()
+            : item_path()
+            , source()
+            , id()
+            , asset_type()
+            , asset_mode(PredefinedAttributes::default_asset_mode)
+            , size(0)
+            , isp()
+            , error()
+        {
+        }
+
+        fs::path                            item_path;
+        fs::path                            source;     //!< Object file to clone, if any.
+        AssetId                             id;
+        std::string                         asset_type;
+        int                                 asset_mode;
+        std::size_t                         size;       //!< Asset data size, used to start the largest items first.
+        boost::shared_ptr<std::istream>     isp;        //!< Opened by the main thread.
+        std::exception_ptr                  error;      //!< Job error.
+    };
+
+    //! Bounded queue of the jobs with opened asset streams. Bounds the number of opened files.
+    class ExtractQueue {
+    public:
+        ExtractQueue(std::size_t capacity)
+            : capacity_(capacity)
+            , closed_(false)
+        {
+        }
+
+        void push(ExtractJob *job)
+        {
+            boost::unique_lock<boost::mutex> lock(mutex_);
+            while (jobs_.size() >= capacity_)
+            {
+                not_full_.wait(lock);
+            }
+            jobs_.push_back(job);
+            not_empty_.notify_one();
+        }
+
+        //! \return next job or null if the queue is closed and empty.
+        ExtractJob *pop()
+        {
+            boost::unique_lock<boost::mutex> lock(mutex_);
+            while (jobs_.empty() && !closed_)
+            {
+                not_empty_.wait(lock);
+            }
+
+            if (jobs_.empty())
+            {
+                return 0;
+            }
+
+            ExtractJob *job = jobs_.front();
+            jobs_.pop_front();
+            not_full_.notify_one();
+            return job;
+        }
+
+        void close()
+        {
+            boost::unique_lock<boost::mutex> lock(mutex_);
+            closed_ = true;
+            not_empty_.notify_all();
+        }
+
+    private:
+        std::size_t                 capacity_;
+        bool                        closed_;
+        std::deque<ExtractJob*>     jobs_;
+        boost::mutex                mutex_;
+        boost::condition_variable   not_empty_;
+        boost::condition_variable   not_full_;
+    };
+
+    void extract_worker(ExtractQueue *queue, int politic, VerifiedObjects *verified)
+    {
+        Blake3Hasher::SerialScope serial_hashing;
+
+        for (ExtractJob *job = queue->pop(); job; job = queue->pop())
+        {
+            try
+            {
+                write_item(job->item_path, job->id, job->asset_type, job->asset_mode, job->source, job->isp, politic, verified);
+            }
+            catch (...)
+            {
+                job->error = std::current_exception();
+            }
+
+            // Close the asset stream as soon as possible.
+            job->isp.reset();
+        }
+    }
+
+    struct LargerJobFirst {
+        LargerJobFirst(const std::vector<ExtractJob>& jobs)
+            : jobs_(jobs)
+        {
+        }
+
+        bool operator()(std::size_t first, std::size_t second) const
+        {
+            return jobs_[first].size > jobs_[second].size;
+        }
+
+    private:
+        const std::vector<ExtractJob>& jobs_;
+    };
+
+} // namespace
+
 AssetsExtractor::AssetsExtractor(const TreeIndex::Ptr& index, ExtractPolitic politic)
     : index_(index)
     , politic_(politic)
+    , threads_count_(1)
+    , verified_(new VerifiedObjects())
 {
 }
 
@@ -44,12 +346,40 @@ AssetsExtractor::~AssetsExtractor()
 {
 }
 
+/*static*/ ExtractPolitic AssetsExtractor::extract_mode(const std::string& mode_name)
+{
+    if (mode_name == "copy")
+    {
+        return ExtractPolitic(0);
+    }
+    else if (mode_name == "clone")
+    {
+        return ExtractPolicy__clone_objects;
+    }
+    else if (mode_name == "hardlink")
+    {
+        return ExtractPolicy__link_objects;
+    }
+
+    LOGE << "Unknown extract mode: " << mode_name << ELOG;
+
+    throw errors::unknown_extract_mode();
+}
+
+void AssetsExtractor::set_threads_count(unsigned int threads_count)
+{
+    threads_count_ = threads_count ? threads_count : std::max(1u, boost::thread::hardware_concurrency());
+}
+
 void AssetsExtractor::create_parent_path(const boost::filesystem::path& item_path)
 {
-    fs::path parent_path    = item_path.parent_path();
+    LOGT << "Extract item: " << item_path << " parent: " << item_path.parent_path() << ELOG;
 
-    LOGT << "Extract item: " << item_path << " parent: " << parent_path << ELOG;
+    create_directory(item_path.parent_path());
+}
 
+void AssetsExtractor::create_directory(const boost::filesystem::path& parent_path)
+{
     // Create item parent directory
     if (fs::exists(parent_path))
     {
@@ -81,8 +411,11 @@ void AssetsExtractor::create_parent_path(const boost::filesystem::path& item_pat
 void AssetsExtractor::extract_asset_into(const boost::filesystem::path& item_path,
         const TreeIndex::Content::const_iterator& i)
 {
-    boost::shared_ptr<std::istream> isp = i->second.istream();
-    if (!isp)
+    fs::path source = (politic_ & (ExtractPolicy__clone_objects | ExtractPolicy__link_objects))
+            ? i->second.file_path() : fs::path();
+
+    boost::shared_ptr<std::istream> isp = source.empty() ? i->second.istream() : boost::shared_ptr<std::istream>();
+    if (!isp && source.empty())
     {
         LOGF << "Non readable asset: " << i->second.id().string() << ELOG;
 
@@ -103,45 +436,161 @@ void AssetsExtractor::extract_asset_into(const boost::filesystem::path& item_pat
     if (asset_type == PredefinedAttributes::asset_type__file)
     {
         LOGT << "Copy data from asset to file." << ELOG;
+    }
+    else if (asset_type == PredefinedAttributes::asset_type__symlink)
+    {
+        LOGT << "Create symbolic link." << ELOG;
+    }
+
+    try
+    {
+        write_item(item_path, i->second.id(), asset_type, asset_mode, source, isp, politic_, verified_.get());
+    }
+    catch (const errors::exported_data_is_corrupted&)
+    {
+        LOGF << "Corrupted asset data." << ELOG;
 
-        boost::shared_ptr<std::ostream> osp = fs::ostream(item_path);
+        throw;
+    }
+}
 
-        if (i->second.id().string() != fs::copy_into(osp, isp))
+void AssetsExtractor::extract_items(const Items& items)
+{
+    if (threads_count_ <= 1 || items.size() <= 1)
+    {
+        for (Items::const_iterator i = items.begin(), end = items.end(); i != end; ++i)
         {
-            LOGF << "Corrupted asset data." << ELOG;
+            extract_asset_into(i->first, i->second);
+        }
+        return;
+    }
 
-            throw errors::exported_data_is_corrupted();
+    std::vector<ExtractJob> jobs(items.size());
+    std::vector<std::size_t> order(items.size());
+    std::set<fs::path> parents;
+
+    for (std::size_t k = 0; k < items.size(); ++k)
+    {
+        const TreeIndex::Content::const_iterator& i = items[k].second;
+        ExtractJob& job = jobs[k];
+
+        job.item_path   = items[k].first;
+        job.id          = i->second.id();
+        job.asset_type  = index_->get_attr_(i->first,
+                PredefinedAttributes::asset_type, PredefinedAttributes::asset_type__file);
+        job.asset_mode  = PredefinedAttributes::parse_asset_mode(
+                index_->get_attr_(i->first, PredefinedAttributes::asset_mode),
+                PredefinedAttributes::default_asset_mode);
+        job.size        = i->second.size();
+
+        if (politic_ & (ExtractPolicy__clone_objects | ExtractPolicy__link_objects))
+        {
+            job.source  = i->second.file_path();
         }
 
-        fs::permissions(item_path, (fs::perms)asset_mode);
+        order[k] = k;
+        parents.insert(job.item_path.parent_path());
     }
-    else if (asset_type == PredefinedAttributes::asset_type__symlink)
+
+    // Each parent directory is checked and created only once.
+    for (std::set<fs::path>::const_iterator i = parents.begin(), end = parents.end(); i != end; ++i)
     {
-        LOGT << "Create symbolic link." << ELOG;
+        create_directory(*i);
+    }
+
+    // Largest items go first to avoid the stragglers at the end.
+    std::stable_sort(order.begin(), order.end(), LargerJobFirst(jobs));
 
-        std::ostringstream* ossp = new std::ostringstream();
-        boost::shared_ptr<std::ostream> oss(ossp);
+    LOGT << "Extract " << jobs.size() << " items using " << threads_count_ << " threads." << ELOG;
 
-        if (i->second.id().string() != fs::copy_into(oss, isp))
+    ExtractQueue queue(threads_count_ * 4);
+
+    boost::thread_group threads;
+    for (unsigned int t = 0; t < threads_count_; ++t)
+    {
+        threads.create_thread(boost::bind(&extract_worker, &queue, politic_, verified_.get()));
+    }
+
+    // Asset streams are opened here, so only this thread interacts with the storage and logs.
+    for (std::vector<std::size_t>::const_iterator k = order.begin(), end = order.end(); k != end; ++k)
+    {
+        ExtractJob& job = jobs[*k];
+
+        if (!job.source.empty())
         {
-            LOGF << "Corrupted asset data." << ELOG;
+            // Workers read the object file themselves if it can't be cloned.
+            queue.push(&job);
+            continue;
+        }
 
-            throw errors::exported_data_is_corrupted();
+        try
+        {
+            job.isp = items[*k].second->second.istream();
+        }
+        catch (...)
+        {
+            job.error = std::current_exception();
+            continue;
+        }
+
+        if (!job.isp)
+        {
+            job.error = std::make_exception_ptr(errors::attempt_to_export_non_readable_asset());
+            continue;
         }
 
-        std::string symlink_target = ossp->str();
+        queue.push(&job);
+    }
 
-        LOGT << "Create symbolic link " << item_path << " -> " << symlink_target << ELOG;
+    queue.close();
+    threads.join_all();
 
-        fs::create_symlink(symlink_target, item_path);
+    // Report the first failed item in the index order, whatever order the workers failed in.
+    for (std::vector<ExtractJob>::const_iterator i = jobs.begin(), end = jobs.end(); i != end; ++i)
+    {
+        if (i->error)
+        {
+            LOGE << "Unable to extract item: " << i->item_path << " asset: " << i->id.string() << ELOG;
 
-        // TODO: permissions for symlinks
-        //fs::permissions(item_path, fs::perms::symlink_perms|((fs::perms)asset_mode));
+            std::rethrow_exception(i->error);
+        }
     }
-    else
+}
+
+bool AssetsExtractor::prepare_item_path(boost::filesystem::path& item_path)
+{
+    if (fs::exists(fs::symlink_status(item_path)))
     {
-        throw errors::unknown_asset_type();
+        if (politic_ & ExtractPolicy__replace_existing)
+        {
+            LOGT << "Replace existing file: " << item_path << ELOG;
+
+            fs::remove_all(item_path);
+        }
+
+        if (politic_ & ExtractPolicy__backup_existing)
+        {
+            LOGT << "Backup existing file: " << item_path << ELOG;
+
+            fs::copy_file(item_path, item_path / (std::string(".backup.") + index_->id().string()));
+        }
+
+        if (politic_ & ExtractPolicy__put_new_with_suffix)
+        {
+            item_path /= std::string(".new.") + index_->id().string();
+
+            LOGT << "New item path: " << item_path << ELOG;
+        }
+
+        if ((politic_ & ExtractPolicy__keep_existing) && !(politic_ & ExtractPolicy__put_new_with_suffix))
+        {
+            LOGT << "Keep existing: " << item_path << ELOG;
+
+            return false;
+        }
     }
+
+    return true;
 }
 
 void AssetsExtractor::extract_into(const boost::filesystem::path& directory, const std::string& prefix_only)
@@ -153,6 +602,8 @@ void AssetsExtractor::extract_into(const boost::filesystem::path& directory, con
         throw errors::attempt_to_export_to_non_existing_directory();
     }
 
+    Items items;
+
     for (TreeIndex::Content::const_iterator i = index_->content().begin(), end = index_->content().end(); i != end; ++i)
     {
         if (!prefix_only.empty())
@@ -167,39 +618,132 @@ void AssetsExtractor::extract_into(const boost::filesystem::path& directory, con
 
         fs::path item_path      = directory / i->first;
 
-        if (fs::exists(item_path))
+        if (!prepare_item_path(item_path))
         {
-            if (politic_ & ExtractPolicy__replace_existing)
-            {
-                LOGT << "Replace existing file: " << item_path << ELOG;
+            continue;
+        }
 
-                fs::remove_all(item_path);
-            }
+        items.push_back(std::make_pair(item_path, i));
+    }
 
-            if (politic_ & ExtractPolicy__backup_existing)
-            {
-                LOGT << "Backup existing file: " << item_path << ELOG;
+    extract_items(items);
+}
 
-                fs::copy_file(item_path, item_path / (std::string(".backup.") + index_->self().id().string()));
-            }
+void AssetsExtractor::remove_item(const boost::filesystem::path& directory, const std::string& index_path)
+{
+    fs::path item_path = directory / index_path;
 
-            if (politic_ & ExtractPolicy__put_new_with_suffix)
-            {
-                item_path /= std::string(".new.") + index_->self().id().string();
+    LOGT << "Remove item: " << item_path << ELOG;
 
-                LOGT << "New item path: " << item_path << ELOG;
-            }
+    fs::remove_all(item_path);
 
-            if ((politic_ & ExtractPolicy__keep_existing) && !(politic_ & ExtractPolicy__put_new_with_suffix))
-            {
-                LOGT << "Keep existing: " << item_path << ELOG;
+    // Remove parent directories what became empty.
+    boost::system::error_code ec;
+    for (fs::path parent_path = item_path.parent_path(); parent_path != directory; parent_path = parent_path.parent_path())
+    {
+        if (!fs::is_directory(parent_path, ec) || !fs::is_empty(parent_path, ec) || !fs::remove(parent_path, ec))
+        {
+            break;
+        }
+    }
+}
 
-                continue;
+void AssetsExtractor::extract_changes_into(const boost::filesystem::path& directory, const TreeIndex::Ptr& current_index)
+{
+    if (!fs::exists(directory) || !fs::is_directory(directory))
+    {
+        LOGF << "Attempt to extract data to non existing directory: " << directory << ELOG;
+
+        throw errors::attempt_to_export_to_non_existing_directory();
+    }
+
+    IndexesDiff diff = IndexesDiff::diff(current_index, index_);
+
+    typedef IndexesDiff::ContentDiff::const_iterator            ContentIter;
+    typedef IndexesDiff::ContentAttributesDiff::const_iterator  AttributesIter;
+
+    const IndexesDiff::ContentDiff& content_diff                = diff.content_diff();
+    const IndexesDiff::ContentAttributesDiff& attributes_diff   = diff.content_attributes_diff();
+
+    // Removals go first, so replaced files and directories are out of the way.
+    for (ContentIter i = content_diff.begin(), end = content_diff.end(); i != end; ++i)
+    {
+        if (i->second.first == IndexesDiff::ElementState_removed)
+        {
+            remove_item(directory, i->first);
+        }
+    }
+
+    Items items;
+    std::size_t changed_modes = 0;
+
+    for (ContentIter i = content_diff.begin(), end = content_diff.end(); i != end; ++i)
+    {
+        if (i->second.first == IndexesDiff::ElementState_removed)
+        {
+            continue;
+        }
+
+        fs::path item_path = directory / i->first;
+
+        if (!prepare_item_path(item_path))
+        {
+            continue;
+        }
+
+        items.push_back(std::make_pair(item_path, index_->content().find(i->first)));
+    }
+
+    // Items with the same data but different attributes.
+    for (AttributesIter i = attributes_diff.begin(), end = attributes_diff.end(); i != end; ++i)
+    {
+        if (i->second.first != IndexesDiff::ElementState_modified || content_diff.find(i->first) != content_diff.end())
+        {
+            continue;
+        }
+
+        TreeIndex::Content::const_iterator item = index_->content().find(i->first);
+        if (item == index_->content().end())
+        {
+            continue;
+        }
+
+        std::string current_type = current_index->get_attr_(i->first,
+                PredefinedAttributes::asset_type, PredefinedAttributes::asset_type__file);
+
+        std::string asset_type = index_->get_attr_(i->first,
+                PredefinedAttributes::asset_type, PredefinedAttributes::asset_type__file);
+
+        fs::path item_path = directory / i->first;
+
+        // Hard linked item shares the mode with the object file, so it is extracted again instead of chmod.
+        boost::system::error_code ec;
+        boost::uintmax_t links = fs::hard_link_count(item_path, ec);
+        bool linked = asset_type == PredefinedAttributes::asset_type__file && !ec && links > 1;
+
+        if (current_type != asset_type || linked)
+        {
+            if (prepare_item_path(item_path))
+            {
+                items.push_back(std::make_pair(item_path, item));
             }
         }
+        else if (asset_type == PredefinedAttributes::asset_type__file)
+        {
+            int asset_mode = PredefinedAttributes::parse_asset_mode(
+                    index_->get_attr_(i->first, PredefinedAttributes::asset_mode),
+                    PredefinedAttributes::default_asset_mode);
+
+            LOGT << "Change mode: " << item_path << ELOG;
 
-        extract_asset_into(item_path, i);
+            fs::permissions(item_path, (fs::perms)asset_mode);
+            ++changed_modes;
+        }
     }
+
+    extract_items(items);
+
+    LOGT << "Changes extracted: " << items.size() << " modes changed: " << changed_modes << ELOG;
 }
 
 } } // namespace piel::lib
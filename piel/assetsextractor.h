@@ -40,6 +40,7 @@ namespace errors {
     struct unable_to_create_item_parent {};
     struct exported_data_is_corrupted {};
     struct unknown_asset_type {};
+    struct unknown_extract_mode {};
 };
 
 enum ExtractPolitic
@@ -48,8 +49,12 @@ enum ExtractPolitic
     ExtractPolicy__replace_existing      = 0x02,
     ExtractPolicy__backup_existing       = 0x04,
     ExtractPolicy__put_new_with_suffix   = 0x08,
+    ExtractPolicy__clone_objects         = 0x10, //!< Reflink object files into the items, copy if not supported.
+    ExtractPolicy__link_objects          = 0x20, //!< Hard link object files into the items. For read only working copies.
 };
 
+class VerifiedObjects;
+
 class AssetsExtractor
 {
 public:
@@ -57,15 +62,34 @@ public:
     ~AssetsExtractor();
 
     void extract_into(const boost::filesystem::path& directory, const std::string& prefix_only = std::string());
+
+    //! Bring directory content described by current_index to the state of the index. Only changed items are touched.
+    void extract_changes_into(const boost::filesystem::path& directory, const TreeIndex::Ptr& current_index);
+
     void extract_asset_into(const boost::filesystem::path& item_path,
             const TreeIndex::Content::const_iterator& i);
 
+    //! Extract policy flags for the mode name: "copy", "clone" or "hardlink".
+    static ExtractPolitic extract_mode(const std::string& mode_name);
+
+    //! Number of the threads what write extracted items: 1 (default) extracts serially, 0 uses all CPUs.
+    //! Index assets must be readable from the different threads, what is true for the storage assets.
+    void set_threads_count(unsigned int threads_count);
+
 private:
+    typedef std::vector<std::pair<boost::filesystem::path, TreeIndex::Content::const_iterator> > Items;
+
     void create_parent_path(const boost::filesystem::path& item_path);
+    void create_directory(const boost::filesystem::path& parent_path);
+    void extract_items(const Items& items);
+    bool prepare_item_path(boost::filesystem::path& item_path);
+    void remove_item(const boost::filesystem::path& directory, const std::string& index_path);
 
 private:
     TreeIndex::Ptr          index_;
     ExtractPolitic          politic_;
+    unsigned int            threads_count_;
+    boost::shared_ptr<VerifiedObjects> verified_;   //!< Objects checked before clone or link.
 
 };
 
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PIEL_BINARYIO_HPP_
+#define PIEL_BINARYIO_HPP_
+
+#include <assetid.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace piel { namespace lib { namespace binaryio {
+
+    //! Binary serialization constants.
+    struct C {
+        static const uint8_t id_digest = 0;     //!< Id stored as raw digest.
+        static const uint8_t id_string = 1;     //!< Id stored as string (special ids).
+    };
+
+    //! Binary data writer.
+    class Writer {
+    public:
+        Writer(std::string& out)
+            : out_(out)
+        {
+        }
+
+        void bytes(const void *data, std::size_t size)
+        {
+            out_.append(static_cast<const char*>(data), size);
+        }
+
+        void u8(uint8_t value)
+        {
+            out_.push_back(static_cast<char>(value));
+        }
+
+        void u32(uint32_t value)
+        {
+            bytes(&value, sizeof(value));
+        }
+
+        //! LEB128 encoded unsigned integer.
+        void varint(uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                u8(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            u8(static_cast<uint8_t>(value));
+        }
+
+        void string(const std::string& value)
+        {
+            varint(value.size());
+            bytes(value.data(), value.size());
+        }
+
+        //! Path compressed against the previous one: shared prefix length and suffix.
+        void path(const std::string& value, std::string& previous)
+        {
+            std::size_t shared = 0;
+            std::size_t limit  = std::min(value.size(), previous.size());
+            while (shared < limit && value[shared] == previous[shared])
+            {
+                ++shared;
+            }
+
+            varint(shared);
+            varint(value.size() - shared);
+            bytes(value.data() + shared, value.size() - shared);
+
+            previous = value;
+        }
+
+        void id(const AssetId& value)
+        {
+            if (value.has_digest())
+            {
+                u8(C::id_digest);
+                bytes(value.data(), AssetId::digest_len);
+            }
+            else
+            {
+                u8(C::id_string);
+                string(value.string());
+            }
+        }
+
+    private:
+        std::string& out_;
+    };
+
+    //! Binary data reader. Reads directly from the memory block.
+    //! \param Error Exception type thrown on malformed data.
+    template<class Error>
+    class Reader {
+    public:
+        Reader(const char *data, std::size_t size)
+            : data_(data)
+            , end_(data + size)
+        {
+        }
+
+        const char *bytes(std::size_t size)
+        {
+            if (static_cast<std::size_t>(end_ - data_) < size)
+            {
+                throw Error();
+            }
+            const char *result = data_;
+            data_ += size;
+            return result;
+        }
+
+        uint8_t u8()
+        {
+            return static_cast<uint8_t>(*bytes(1));
+        }
+
+        uint32_t u32()
+        {
+            uint32_t result;
+            std::memcpy(&result, bytes(sizeof(result)), sizeof(result));
+            return result;
+        }
+
+        uint64_t varint()
+        {
+            uint64_t result = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7)
+            {
+                uint8_t byte = u8();
+                result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                if (!(byte & 0x80))
+                {
+                    return result;
+                }
+            }
+            throw Error();
+        }
+
+        std::string string()
+        {
+            std::size_t size = varint();
+            return std::string(bytes(size), size);
+        }
+
+        const std::string& path(std::string& previous)
+        {
+            std::size_t shared = varint();
+            std::size_t suffix = varint();
+            if (shared > previous.size())
+            {
+                throw Error();
+            }
+
+            previous.resize(shared);
+            previous.append(bytes(suffix), suffix);
+            return previous;
+        }
+
+        AssetId id()
+        {
+            uint8_t kind = u8();
+            if (kind == C::id_digest)
+            {
+                return AssetId::create(reinterpret_cast<const unsigned char*>(bytes(AssetId::digest_len)));
+            }
+            else if (kind == C::id_string)
+            {
+                return AssetId::create(string());
+            }
+            throw Error();
+        }
+
+        bool at_end() const
+        {
+            return data_ == end_;
+        }
+
+    private:
+        const char *data_;
+        const char *end_;
+    };
+
+} } } // namespace piel::lib::binaryio
+
+#endif /* PIEL_BINARYIO_HPP_ */
@@ -0,0 +1,584 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <blake3.h>
+
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+
+namespace piel { namespace lib {
+
+namespace {
+
+typedef Blake3Hasher::Word Word;
+typedef Blake3Hasher::ChainingValue ChainingValue;
+
+const Word iv[8] = {
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+    0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19,
+};
+
+const unsigned char msg_schedule[7][16] = {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    {  2,  6,  3, 10,  7,  0,  4, 13,  1, 11, 12,  5,  9, 14, 15,  8 },
+    {  3,  4, 10, 12, 13,  2,  7, 14,  6,  5,  9,  0, 11, 15,  8,  1 },
+    { 10,  7, 12,  9, 14,  3, 13, 15,  4,  0, 11,  2,  5,  8,  1,  6 },
+    { 12, 13,  9, 11, 15, 10, 14,  8,  7,  2,  5,  3,  0,  1,  6,  4 },
+    {  9, 14, 11,  5,  8, 12, 15,  1, 13,  3,  0, 10,  2,  6,  4,  7 },
+    { 11, 15,  5,  0,  1,  9,  8,  6, 14, 10,  2, 12,  3,  4,  7, 13 },
+};
+
+enum Flags {
+    Flags_chunk_start   = 0x01,
+    Flags_chunk_end     = 0x02,
+    Flags_parent        = 0x04,
+    Flags_root          = 0x08,
+};
+
+//! Subtree of 2^subtree_log chunks is the unit of the concurrent hashing.
+const unsigned subtree_log          = 8;
+const std::size_t subtree_chunks    = std::size_t(1) << subtree_log;
+const std::size_t subtree_size      = subtree_chunks * Blake3Hasher::chunk_len;
+
+//! Upper limit for the threads count, bounds the batch buffer size.
+const unsigned max_threads          = 16;
+
+inline Word rotr(Word w, unsigned c)
+{
+    return (w >> c) | (w << (32 - c));
+}
+
+inline Word load_word(const unsigned char *p)
+{
+    return Word(p[0]) | (Word(p[1]) << 8) | (Word(p[2]) << 16) | (Word(p[3]) << 24);
+}
+
+inline void store_word(Word w, unsigned char *p)
+{
+    p[0] = static_cast<unsigned char>(w);
+    p[1] = static_cast<unsigned char>(w >> 8);
+    p[2] = static_cast<unsigned char>(w >> 16);
+    p[3] = static_cast<unsigned char>(w >> 24);
+}
+
+inline void load_block(const unsigned char *block, Word *words)
+{
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        words[i] = load_word(block + i * 4);
+    }
+}
+
+inline void g(Word *s, unsigned a, unsigned b, unsigned c, unsigned d, Word x, Word y)
+{
+    s[a] = s[a] + s[b] + x;
+    s[d] = rotr(s[d] ^ s[a], 16);
+    s[c] = s[c] + s[d];
+    s[b] = rotr(s[b] ^ s[c], 12);
+    s[a] = s[a] + s[b] + y;
+    s[d] = rotr(s[d] ^ s[a], 8);
+    s[c] = s[c] + s[d];
+    s[b] = rotr(s[b] ^ s[c], 7);
+}
+
+//! BLAKE3 compression function.
+//! \param cv Input chaining value.
+//! \param m Message block words.
+//! \param counter Chunk (or output block) counter.
+//! \param block_len Count of the meaningful bytes in the block.
+//! \param flags Domain separation flags.
+//! \param out 16 words of the compression result.
+void compress(const Word *cv, const Word *m, boost::uint64_t counter, Word block_len, Word flags, Word *out)
+{
+    Word s[16] = {
+        cv[0], cv[1], cv[2], cv[3], cv[4], cv[5], cv[6], cv[7],
+        iv[0], iv[1], iv[2], iv[3],
+        static_cast<Word>(counter), static_cast<Word>(counter >> 32), block_len, flags,
+    };
+
+    for (std::size_t r = 0; r < 7; ++r)
+    {
+        const unsigned char *p = msg_schedule[r];
+        g(s, 0, 4,  8, 12, m[p[0]],  m[p[1]]);
+        g(s, 1, 5,  9, 13, m[p[2]],  m[p[3]]);
+        g(s, 2, 6, 10, 14, m[p[4]],  m[p[5]]);
+        g(s, 3, 7, 11, 15, m[p[6]],  m[p[7]]);
+        g(s, 0, 5, 10, 15, m[p[8]],  m[p[9]]);
+        g(s, 1, 6, 11, 12, m[p[10]], m[p[11]]);
+        g(s, 2, 7,  8, 13, m[p[12]], m[p[13]]);
+        g(s, 3, 4,  9, 14, m[p[14]], m[p[15]]);
+    }
+
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        out[i] = s[i] ^ s[i + 8];
+        out[i + 8] = s[i + 8] ^ cv[i];
+    }
+}
+
+inline ChainingValue initial_cv()
+{
+    ChainingValue cv;
+    std::copy(iv, iv + 8, cv.words);
+    return cv;
+}
+
+//! Compress block in place of the chaining value (used while the output is not needed).
+inline void compress_cv(ChainingValue& cv, const Word *m, boost::uint64_t counter, Word block_len, Word flags)
+{
+    Word out[16];
+    compress(cv.words, m, counter, block_len, flags, out);
+    std::copy(out, out + 8, cv.words);
+}
+
+inline ChainingValue parent_cv(const ChainingValue& left, const ChainingValue& right)
+{
+    Word m[16];
+    std::copy(left.words, left.words + 8, m);
+    std::copy(right.words, right.words + 8, m + 8);
+
+    ChainingValue cv = initial_cv();
+    compress_cv(cv, m, 0, Blake3Hasher::block_len, Flags_parent);
+    return cv;
+}
+
+//! Chaining value of the full (not last) chunk.
+ChainingValue chunk_cv(const unsigned char *data, boost::uint64_t counter)
+{
+    const std::size_t blocks = Blake3Hasher::chunk_len / Blake3Hasher::block_len;
+
+    ChainingValue cv = initial_cv();
+    Word m[16];
+    for (std::size_t i = 0; i < blocks; ++i)
+    {
+        Word flags = 0;
+        if (i == 0)             flags |= Flags_chunk_start;
+        if (i == blocks - 1)    flags |= Flags_chunk_end;
+
+        load_block(data + i * Blake3Hasher::block_len, m);
+        compress_cv(cv, m, counter, Blake3Hasher::block_len, flags);
+    }
+    return cv;
+}
+
+//! Chaining value of the full subtree (never a root).
+//! \param data subtree_size bytes of the input.
+//! \param counter First chunk counter, multiple of subtree_chunks.
+ChainingValue subtree_cv(const unsigned char *data, boost::uint64_t counter)
+{
+    ChainingValue cvs[subtree_chunks];
+    for (std::size_t i = 0; i < subtree_chunks; ++i)
+    {
+        cvs[i] = chunk_cv(data + i * Blake3Hasher::chunk_len, counter + i);
+    }
+
+    for (std::size_t n = subtree_chunks; n > 1; n /= 2)
+    {
+        for (std::size_t i = 0; i < n / 2; ++i)
+        {
+            cvs[i] = parent_cv(cvs[2 * i], cvs[2 * i + 1]);
+        }
+    }
+    return cvs[0];
+}
+
+//! Thread function. Hash each step-th subtree starting from the first one.
+//! Subtrees of one input what are hashed concurrently.
+struct SubtreesBatch {
+    const unsigned char *data;
+    boost::uint64_t     counter;        //!< Counter of the first chunk.
+    std::size_t         subtrees;       //!< Subtrees count.
+    std::size_t         next;           //!< Next subtree to hash.
+    std::size_t         pending;        //!< Subtrees what are not hashed yet.
+    ChainingValue       *out;
+};
+
+//! Long lived threads what hash the subtrees of the batches. Threads are created once
+//!for all hashers, the hashing thread takes its batch subtrees too.
+class SubtreesPool
+{
+public:
+    static SubtreesPool& instance()
+    {
+        static SubtreesPool pool;
+        return pool;
+    }
+
+    //! Hash subtrees by the calling thread and up to threads - 1 pool threads.
+    void hash(const unsigned char *data, boost::uint64_t counter, std::size_t subtrees, std::size_t threads, ChainingValue *out)
+    {
+        SubtreesBatch batch = { data, counter, subtrees, 0, subtrees, out };
+
+        boost::unique_lock<boost::mutex> lock(mutex_);
+
+        queue_.push_back(&batch);
+        for (std::size_t i = 1; i < threads; ++i)
+        {
+            has_work_.notify_one();
+        }
+
+        while (batch.next < batch.subtrees)
+        {
+            hash_next(lock, batch);
+        }
+
+        while (batch.pending > 0)
+        {
+            done_.wait(lock);
+        }
+    }
+
+    ~SubtreesPool()
+    {
+        {
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        has_work_.notify_all();
+        threads_.join_all();
+    }
+
+private:
+    SubtreesPool()
+        : mutex_()
+        , has_work_()
+        , done_()
+        , queue_()
+        , stop_(false)
+        , threads_()
+    {
+        unsigned count = std::max(1u, std::min(boost::thread::hardware_concurrency(), max_threads));
+        for (unsigned i = 1; i < count; ++i)
+        {
+            threads_.create_thread(boost::bind(&SubtreesPool::work, this));
+        }
+    }
+
+    //! Hash the next subtree of the batch, mutex is unlocked while hashing.
+    void hash_next(boost::unique_lock<boost::mutex>& lock, SubtreesBatch& batch)
+    {
+        std::size_t i = batch.next++;
+        if (batch.next == batch.subtrees)
+        {
+            queue_.erase(std::find(queue_.begin(), queue_.end(), &batch));
+        }
+
+        lock.unlock();
+        batch.out[i] = subtree_cv(batch.data + i * subtree_size, batch.counter + i * subtree_chunks);
+        lock.lock();
+
+        if (--batch.pending == 0)
+        {
+            done_.notify_all();
+        }
+    }
+
+    void work()
+    {
+        boost::unique_lock<boost::mutex> lock(mutex_);
+        for (;;)
+        {
+            while (!stop_ && queue_.empty())
+            {
+                has_work_.wait(lock);
+            }
+
+            if (stop_)
+            {
+                return;
+            }
+
+            hash_next(lock, *queue_.front());
+        }
+    }
+
+private:
+    boost::mutex                    mutex_;
+    boost::condition_variable       has_work_;
+    boost::condition_variable       done_;
+    std::deque<SubtreesBatch*>      queue_;         //!< Batches with not taken subtrees.
+    bool                            stop_;
+    boost::thread_group             threads_;
+};
+
+//! Set while the thread is a threads pool worker. Points to the static flag, so there is nothing to clean up.
+bool serial_flag = true;
+boost::thread_specific_ptr<bool> serial_thread(0);
+
+bool is_serial_thread()
+{
+    return serial_thread.get() != 0;
+}
+
+} // namespace
+
+const std::size_t Blake3Hasher::out_len;
+const std::size_t Blake3Hasher::block_len;
+const std::size_t Blake3Hasher::chunk_len;
+
+struct Blake3Hasher::Output {
+    ChainingValue cv;
+    Word block[16];
+    boost::uint64_t counter;
+    Word block_len;
+    Word flags;
+
+    ChainingValue chaining_value() const
+    {
+        ChainingValue result = cv;
+        compress_cv(result, block, counter, block_len, flags);
+        return result;
+    }
+
+    void root_bytes(unsigned char *out) const
+    {
+        Word words[16];
+        compress(cv.words, block, 0, block_len, flags | Flags_root, words);
+        for (std::size_t i = 0; i < out_len / 4; ++i)
+        {
+            store_word(words[i], out + i * 4);
+        }
+    }
+};
+
+Blake3Hasher::ChunkState::ChunkState(boost::uint64_t chunk_counter)
+    : cv(initial_cv())
+    , counter(chunk_counter)
+    , block()
+    , block_size(0)
+    , blocks_compressed(0)
+{
+}
+
+std::size_t Blake3Hasher::ChunkState::size() const
+{
+    return blocks_compressed * block_len + block_size;
+}
+
+unsigned int Blake3Hasher::ChunkState::start_flag() const
+{
+    return blocks_compressed == 0 ? Flags_chunk_start : 0;
+}
+
+void Blake3Hasher::ChunkState::update(const unsigned char *data, std::size_t size)
+{
+    while (size > 0)
+    {
+        // The last block of the chunk is compressed by output() with the chunk end flag.
+        if (block_size == block_len)
+        {
+            Word m[16];
+            load_block(block, m);
+            compress_cv(cv, m, counter, block_len, start_flag());
+            ++blocks_compressed;
+            std::memset(block, 0, block_len);
+            block_size = 0;
+        }
+
+        std::size_t take = std::min(block_len - block_size, size);
+        std::memcpy(block + block_size, data, take);
+        block_size += take;
+        data += take;
+        size -= take;
+    }
+}
+
+Blake3Hasher::Output Blake3Hasher::ChunkState::output() const
+{
+    Output result;
+    result.cv = cv;
+    load_block(block, result.block);
+    result.counter = counter;
+    result.block_len = static_cast<Word>(block_size);
+    result.flags = start_flag() | Flags_chunk_end;
+    return result;
+}
+
+Blake3Hasher::SerialScope::SerialScope()
+    : previous_(is_serial_thread())
+{
+    serial_thread.reset(&serial_flag);
+}
+
+Blake3Hasher::SerialScope::~SerialScope()
+{
+    serial_thread.reset(previous_ ? &serial_flag : 0);
+}
+
+Blake3Hasher::Blake3Hasher(unsigned threads)
+    : threads_(threads ? threads : boost::thread::hardware_concurrency())
+    , chunk_(0)
+    , cv_stack_()
+    , batch_()
+    , batch_size_(0)
+{
+    threads_ = std::max(1u, std::min(threads_, max_threads));
+    if (threads_ > 1)
+    {
+        batch_size_ = threads_ * subtree_size;
+    }
+}
+
+void Blake3Hasher::init()
+{
+    chunk_ = ChunkState(0);
+    cv_stack_.clear();
+    batch_.clear();
+}
+
+void Blake3Hasher::push_chunk(const ChainingValue& cv, boost::uint64_t total_chunks)
+{
+    // Merge the completed subtrees, total_chunks trailing zeros is the count of them.
+    ChainingValue node = cv;
+    while ((total_chunks & 1) == 0)
+    {
+        node = parent_cv(cv_stack_.back(), node);
+        cv_stack_.pop_back();
+        total_chunks >>= 1;
+    }
+    cv_stack_.push_back(node);
+}
+
+void Blake3Hasher::push_subtree(const ChainingValue& cv, boost::uint64_t subtree_index)
+{
+    // Same as push_chunk on the tree level where subtrees are leaves.
+    push_chunk(cv, subtree_index + 1);
+}
+
+void Blake3Hasher::hash_serial(const unsigned char *data, std::size_t size)
+{
+    while (size > 0)
+    {
+        // Full chunk is finalized only when more input is known to follow: the last
+        // chunk of the input must be finalized as the root if it is the only one.
+        if (chunk_.size() == chunk_len)
+        {
+            push_chunk(chunk_.output().chaining_value(), chunk_.counter + 1);
+            chunk_ = ChunkState(chunk_.counter + 1);
+        }
+
+        std::size_t take = std::min(chunk_len - chunk_.size(), size);
+        chunk_.update(data, take);
+        data += take;
+        size -= take;
+    }
+}
+
+void Blake3Hasher::hash_input(const unsigned char *data, std::size_t size, bool more_input)
+{
+    if (size > 0 && chunk_.size() == chunk_len)
+    {
+        push_chunk(chunk_.output().chaining_value(), chunk_.counter + 1);
+        chunk_ = ChunkState(chunk_.counter + 1);
+    }
+
+    if (threads_ > 1 && !is_serial_thread() && chunk_.size() == 0 && chunk_.counter % subtree_chunks == 0)
+    {
+        std::size_t subtrees = size / subtree_size;
+        if (!more_input && subtrees > 0 && subtrees * subtree_size == size)
+        {
+            // Keep the tail in the chunk state, tree root must be finalized by finalize().
+            --subtrees;
+        }
+
+        if (subtrees > 1)
+        {
+            std::vector<ChainingValue> cvs(subtrees);
+            SubtreesPool::instance().hash(data, chunk_.counter, subtrees, std::min<std::size_t>(threads_, subtrees), cvs.data());
+
+            boost::uint64_t first_subtree = chunk_.counter >> subtree_log;
+            for (std::size_t i = 0; i < subtrees; ++i)
+            {
+                push_subtree(cvs[i], first_subtree + i);
+            }
+
+            chunk_ = ChunkState(chunk_.counter + subtrees * subtree_chunks);
+            data += subtrees * subtree_size;
+            size -= subtrees * subtree_size;
+        }
+    }
+
+    hash_serial(data, size);
+}
+
+void Blake3Hasher::update(const void *data, std::size_t size)
+{
+    const unsigned char *input = static_cast<const unsigned char*>(data);
+
+    if (!batch_size_ || (batch_.empty() && is_serial_thread()))
+    {
+        hash_serial(input, size);
+        return;
+    }
+
+    while (size > 0)
+    {
+        if (batch_.size() == batch_size_)
+        {
+            // More input follows, so the whole batch can be hashed as the subtrees.
+            hash_input(batch_.data(), batch_.size(), true);
+            batch_.clear();
+        }
+
+        std::size_t take = std::min(batch_size_ - batch_.size(), size);
+        batch_.insert(batch_.end(), input, input + take);
+        input += take;
+        size -= take;
+    }
+}
+
+void Blake3Hasher::finalize(unsigned char *out)
+{
+    if (!batch_.empty())
+    {
+        hash_input(batch_.data(), batch_.size(), false);
+        batch_.clear();
+    }
+
+    Output output = chunk_.output();
+    for (std::vector<ChainingValue>::const_reverse_iterator i = cv_stack_.rbegin(); i != cv_stack_.rend(); ++i)
+    {
+        Output parent;
+        parent.cv = initial_cv();
+        std::copy(i->words, i->words + 8, parent.block);
+        ChainingValue right = output.chaining_value();
+        std::copy(right.words, right.words + 8, parent.block + 8);
+        parent.counter = 0;
+        parent.block_len = block_len;
+        parent.flags = Flags_parent;
+        output = parent;
+    }
+
+    output.root_bytes(out);
+}
+
+} } // namespace piel::lib
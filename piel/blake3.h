@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PIEL_BLAKE3_H_
+#define PIEL_BLAKE3_H_
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace piel { namespace lib {
+
+//! Portable BLAKE3 hasher (hash mode, 32 bytes output).
+//!
+//! BLAKE3 hashes the input as a binary tree of 1 KiB chunks. Subtrees of the tree are
+//! independent, so when the hasher is allowed to use several threads it collects the
+//! input into batches and hashes subtrees of the batch concurrently. The result does not
+//! depend on the threads count or on the update() calls granularity.
+//!
+//! Subtrees are hashed by the threads pool shared by all hashers. Threads pools what
+//! hash many inputs concurrently mark their workers by SerialScope, so the hashers
+//! used by the workers don't split the inputs.
+class Blake3Hasher
+{
+public:
+    static const std::size_t out_len    = 32;       //!< Output length.
+    static const std::size_t block_len  = 64;       //!< Compression function block length.
+    static const std::size_t chunk_len  = 1024;     //!< Tree leaf length.
+
+    typedef boost::uint32_t Word;
+
+    //! Constructor.
+    //! \param threads Max threads used to hash one input. 1 - hash in the calling thread,
+    //!        0 - use hardware concurrency.
+    explicit Blake3Hasher(unsigned threads = 1);
+
+    //! Reset hasher to the initial state.
+    void init();
+
+    //! Process data block.
+    //! \param data Pointer to a data block.
+    //! \param size Data block size.
+    void update(const void *data, std::size_t size);
+
+    //! Finalize calculations.
+    //! \param out Output buffer, out_len bytes.
+    void finalize(unsigned char *out);
+
+    //! Chaining value of a tree node.
+    struct ChainingValue {
+        Word words[8];
+    };
+
+    //! Hashers used by the calling thread hash in this thread while the object exists.
+    class SerialScope
+    {
+    public:
+        SerialScope();
+        ~SerialScope();
+
+    private:
+        SerialScope(const SerialScope&);
+        SerialScope& operator=(const SerialScope&);
+
+        bool previous_;     //!< Thread was already marked.
+    };
+
+private:
+    //! Input of the compression function for a tree node output.
+    struct Output;
+
+    //! State of the currently hashed chunk.
+    struct ChunkState {
+        ChainingValue cv;
+        boost::uint64_t counter;
+        unsigned char block[block_len];
+        std::size_t block_size;
+        std::size_t blocks_compressed;
+
+        explicit ChunkState(boost::uint64_t chunk_counter);
+
+        std::size_t size() const;
+        unsigned int start_flag() const;
+        void update(const unsigned char *data, std::size_t size);
+        Output output() const;
+    };
+
+    void hash_serial(const unsigned char *data, std::size_t size);
+    void hash_input(const unsigned char *data, std::size_t size, bool more_input);
+    void push_chunk(const ChainingValue& cv, boost::uint64_t total_chunks);
+    void push_subtree(const ChainingValue& cv, boost::uint64_t subtree_index);
+
+private:
+    unsigned threads_;                      //!< Threads count.
+    ChunkState chunk_;                      //!< Current chunk.
+    std::vector<ChainingValue> cv_stack_;   //!< Chaining values of the completed subtrees.
+    std::vector<unsigned char> batch_;      //!< Input collected for the concurrent hashing.
+    std::size_t batch_size_;                //!< Batch size, 0 if the hasher uses one thread.
+
+};
+
+} } // namespace piel::lib
+
+#endif /* PIEL_BLAKE3_H_ */
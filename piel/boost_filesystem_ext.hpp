@@ -91,11 +91,12 @@ inline void remove_directory_content(const path& dir, const path& exclude)
     }
 }
 
-inline std::string copy_into(boost::shared_ptr<std::ostream> osp, boost::shared_ptr<std::istream> isp)
+inline piel::lib::AssetId copy_into(boost::shared_ptr<std::ostream> osp, boost::shared_ptr<std::istream> isp)
 {
     typedef std::vector<char> BufferType;
 
-    piel::lib::ChecksumsDigestBuilder digest_builder;
+    piel::lib::AssetId::Algorithm algorithm = piel::lib::AssetId::algorithm();
+    piel::lib::ChecksumsDigestBuilder digest_builder(piel::lib::AssetId::algorithm_digest(algorithm));
     digest_builder.init();
 
     BufferType copy_buffer(piel::lib::CommonConstants::io_buffer_size);
@@ -107,10 +108,10 @@ inline std::string copy_into(boost::shared_ptr<std::ostream> osp, boost::shared_
         }
     } while(!isp->eof() & !isp->fail() & !isp->bad());
 
-    piel::lib::ChecksumsDigestBuilder::StrDigests str_digests =
-            digest_builder.finalize<piel::lib::ChecksumsDigestBuilder::StrDigests>();
+    piel::lib::ChecksumsDigestBuilder::Digests digests =
+            digest_builder.finalize<piel::lib::ChecksumsDigestBuilder::Digests>();
 
-    return str_digests[piel::lib::AssetId::digest_algo];
+    return piel::lib::AssetId::create(digests[piel::lib::AssetId::algorithm_name(algorithm)].data());
 }
 
 } } // namespace boost::filesystem
@@ -40,77 +40,95 @@ template<> char const* const DigestTraits<Sha>::name_       = "SHA-1";
 template<> const int DigestTraits<Sha>::len_                = SHA_DIGEST_LENGTH;
 template<> char const* const DigestTraits<Md5>::name_       = "MD5";
 template<> const int DigestTraits<Md5>::len_                = MD5_DIGEST_LENGTH;
+template<> char const* const DigestTraits<Blake3>::name_    = "BLAKE3";
+template<> const int DigestTraits<Blake3>::len_             = Blake3Hasher::out_len;
 
 //! Format digest string.
 //! \return Digest string representation.
 std::string IDigestContext::format(const Digest& digest) {
-    std::string result;
-    Formatter resultFormatter(result);
-    std::for_each(digest.begin(), digest.end(), resultFormatter);
-    return result;
+    return HexCodec::encode(digest.data(), digest.size());
 }
 
-template<> void DigestContext<Sha256>::init()
-{
-    SHA256_Init(&ctx_);
-}
+template<> const EVP_MD *DigestTraits<Sha256>::md()  { return EVP_sha256(); }
+template<> const EVP_MD *DigestTraits<Sha>::md()     { return EVP_sha1(); }
+template<> const EVP_MD *DigestTraits<Md5>::md()     { return EVP_md5(); }
+
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+#define EVP_MD_CTX_new  EVP_MD_CTX_create
+#define EVP_MD_CTX_free EVP_MD_CTX_destroy
+#endif
 
-template<> void DigestContext<Sha256>::update(const void *data, size_t size)
+template<typename CTX> DigestContext<CTX>::DigestContext()
+    : digest_(CTX::t::len())
+    , ctx_(EVP_MD_CTX_new())
 {
-    SHA256_Update(&ctx_, data, size);
 }
 
-template<> DigestContext<Sha256>::Digest& DigestContext<Sha256>::finalize()
+template<typename CTX> DigestContext<CTX>::~DigestContext()
 {
-    SHA256_Final(digest_.data(), &ctx_);
-    return digest_;
+    EVP_MD_CTX_free(ctx_);
 }
 
-typedef DigestContext<Sha256> Sha256Context;
-
-template<> void DigestContext<Sha>::init()
+template<typename CTX> void DigestContext<CTX>::init()
 {
-    SHA1_Init(&ctx_);
+    EVP_DigestInit_ex(ctx_, CTX::t::md(), 0);
 }
 
-template<> void DigestContext<Sha>::update(const void *data, size_t size)
+template<typename CTX> void DigestContext<CTX>::update(const void *data, size_t size)
 {
-    SHA1_Update(&ctx_, data, size);
+    EVP_DigestUpdate(ctx_, data, size);
 }
 
-template<> DigestContext<Sha>::Digest& DigestContext<Sha>::finalize()
+template<typename CTX> typename DigestContext<CTX>::Digest& DigestContext<CTX>::finalize()
 {
-    SHA1_Final(digest_.data(), &ctx_);
+    EVP_DigestFinal_ex(ctx_, digest_.data(), 0);
     return digest_;
 }
 
-typedef DigestContext<Sha> ShaContext;
+template class DigestContext<Sha256>;
+template class DigestContext<Sha>;
+template class DigestContext<Md5>;
 
-template<> void DigestContext<Md5>::init()
+Blake3Context::Blake3Context()
+    : digest_(Blake3::t::len())
+    , hasher_(0)
 {
-    MD5_Init(&ctx_);
 }
 
-template<> void DigestContext<Md5>::update(const void *data, size_t size)
+void Blake3Context::init()
 {
-    MD5_Update(&ctx_, data, size);
+    hasher_.init();
 }
 
-template<> DigestContext<Md5>::Digest& DigestContext<Md5>::finalize()
+void Blake3Context::update(const void *data, size_t size)
 {
-    MD5_Final(digest_.data(), &ctx_);
+    hasher_.update(data, size);
+}
+
+Blake3Context::Digest& Blake3Context::finalize()
+{
+    hasher_.finalize(digest_.data());
     return digest_;
 }
 
 //! Constructor
-ChecksumsDigestBuilder::ChecksumsDigestBuilder()
+ChecksumsDigestBuilder::ChecksumsDigestBuilder(int digests)
     : contexts_()
     , buf_(DigestConstants::buf_size)
     , bad_(false)
 {
-    contexts_.push_back(boost::shared_ptr<IDigestContext>(new Sha256Context()));
-    contexts_.push_back(boost::shared_ptr<IDigestContext>(new ShaContext()));
-    contexts_.push_back(boost::shared_ptr<IDigestContext>(new Md5Context()));
+    if (digests & Digest_sha256) {
+        contexts_.push_back(boost::shared_ptr<IDigestContext>(new Sha256Context()));
+    }
+    if (digests & Digest_sha1) {
+        contexts_.push_back(boost::shared_ptr<IDigestContext>(new ShaContext()));
+    }
+    if (digests & Digest_md5) {
+        contexts_.push_back(boost::shared_ptr<IDigestContext>(new Md5Context()));
+    }
+    if (digests & Digest_blake3) {
+        contexts_.push_back(boost::shared_ptr<IDigestContext>(new Blake3Context()));
+    }
 }
 
 bool ChecksumsDigestBuilder::bad() const
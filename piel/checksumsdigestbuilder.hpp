@@ -29,6 +29,7 @@
 #ifndef CHECKSUM_DIGEST_BUILDER_HPP
 #define CHECKSUM_DIGEST_BUILDER_HPP
 
+#include <openssl/evp.h>
 #include <openssl/sha.h>
 #include <openssl/md5.h>
 
@@ -38,6 +39,9 @@
 #include <boost/format.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <blake3.h>
+#include <hexcodec.h>
+
 namespace piel { namespace lib {
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -48,30 +52,32 @@ struct DigestConstants {
 
 template<class Digest>
 struct DigestTraits {
-    typedef typename Digest::ctx ctx;
     static std::string name() {
         return name_;
     }
     static int len() {
         return len_;
     }
+    //! OpenSSL EVP digest. EVP selects the hardware accelerated (SHA-NI, AVX2, ...)
+    //! implementation at runtime and falls back to the scalar one.
+    static const EVP_MD *md();
 private:
     static char const* const name_;
     static const int len_;
 };
 
 struct Sha256 {
-    typedef SHA256_CTX ctx;
     typedef DigestTraits<Sha256> t;
 };
 struct Sha {
-    typedef SHA_CTX ctx;
     typedef DigestTraits<Sha> t;
 };
 struct Md5 {
-    typedef MD5_CTX ctx;
     typedef DigestTraits<Md5> t;
 };
+struct Blake3 {
+    typedef DigestTraits<Blake3> t;
+};
 
 ////////////////////////////////////////////////////////////////////////////////
 //! \brief Checksums formatter.
@@ -94,7 +100,10 @@ public:
     //! \param v checksum data byte.
     void operator()(const value_type& v)
     {
-        str_.append((boost::format("%1$02x") % (int)v).str());
+        unsigned char byte = static_cast<unsigned char>(v);
+        char digits[2];
+        HexCodec::encode(&byte, 1, digits);
+        str_.append(digits, sizeof(digits));
     }
 
 private:
@@ -133,19 +142,18 @@ struct IDigestContext {
 };
 
 ////////////////////////////////////////////////////////////////////////////////
-//! Template for wrappers of C api & data structures used by OpenSSL library for
-//! calculating checksums.
-//! \param CTX Type of the OpenSSL api context structure.
-//! \param digestSize the digest size in bytes.
+//! Template for wrappers of OpenSSL EVP api used for calculating checksums.
+//! The EVP context is allocated once and reused by each init() call.
+//! \param CTX Digest tag type (Sha256, Sha, Md5).
 template<typename CTX> class DigestContext
         : public IDigestContext
 {
 public:
     //! Constructor.
-    DigestContext()
-        : digest_(CTX::t::len())
-        , ctx_()
-    {}
+    DigestContext();
+
+    //! Destructor.
+    ~DigestContext();
 
     //! Init internal data.
     void init();
@@ -166,8 +174,11 @@ public:
     }
 
 private:
+    DigestContext(const DigestContext&);
+    void operator=(const DigestContext&);
+
     Digest digest_;                 //!< Digest data container.
-    typename CTX::ctx ctx_;         //!< OpenSSL api context structure.
+    EVP_MD_CTX *ctx_;               //!< OpenSSL EVP context.
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -182,10 +193,43 @@ typedef DigestContext<Sha> ShaContext;
 //! MD5 specialization.
 typedef DigestContext<Md5> Md5Context;
 
+////////////////////////////////////////////////////////////////////////////////
+//! BLAKE3 context. OpenSSL has no BLAKE3, the portable implementation is used.
+//! Large inputs are hashed by the several threads.
+class Blake3Context
+        : public IDigestContext
+{
+public:
+    //! Constructor.
+    Blake3Context();
+
+    //! Init internal data.
+    void init();
+
+    //! Process data block.
+    //! \param data Pointer to a data block.
+    //! \param size Data block size.
+    void update(const void *data, size_t size);
+
+    //! Finalize calculations.
+    //! \return Reference to digest data container
+    Digest& finalize();
+
+    //! Get checksum name.
+    //! \return Checksum name.
+    std::string name() const {
+        return Blake3::t::name();
+    }
+
+private:
+    Digest digest_;                 //!< Digest data container.
+    Blake3Hasher hasher_;           //!< Hasher state.
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 //! Upper level class for checksums calculations.
 //!
-//! \sa DigestContext, Sha256Context, ShaContext, Md5Context.
+//! \sa DigestContext, Sha256Context, ShaContext, Md5Context, Blake3Context.
 class ChecksumsDigestBuilder {
 public:
 
@@ -193,8 +237,19 @@ public:
     typedef std::map<std::string, IDigestContext::Digest> Digests;
     typedef std::vector<boost::shared_ptr<IDigestContext> >::iterator CtxIter;
 
+    //! Digests what can be calculated by the builder.
+    enum Digest {
+        Digest_sha256   = 0x01,
+        Digest_sha1     = 0x02,
+        Digest_md5      = 0x04,
+        Digest_blake3   = 0x08,
+        Digest_all      = Digest_sha256 | Digest_sha1 | Digest_md5,   //!< Artifactory checksums.
+    };
+
     //! Constructor
-    ChecksumsDigestBuilder();
+    //! \param digests Set of the digests to calculate (Digest flags). Asset ids need only the
+    //!        repository id digest, Artifactory uploads and downloads validation use Digest_all.
+    explicit ChecksumsDigestBuilder(int digests = Digest_all);
 
     //! Method will return istream.bad() after last digests_for(istream) str_digests_for(istream)
     //! call. Must be used to check if there are no IO errors during last calculation.
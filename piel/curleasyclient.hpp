@@ -172,6 +172,8 @@ public:
     //! \sa curl_easy_init
     CurlEasyClient(const std::string& url, HandlersPtr handlers)
         : url_(url)
+        , request_()
+        , upload_size_(-1)
         , handlers_(handlers)
         , curl_error_()
     {
@@ -190,6 +192,22 @@ public:
     //! \sa curl_easy_perform, curl_error
     bool perform();
 
+    //! Set HTTP request method, for example "HEAD" or "DELETE". Default method is chosen by
+    //! the implemented handlers: PUT if the handlers have handle_input, GET otherwise.
+    //! \param request Request method name.
+    void set_request(const std::string& request)
+    {
+        request_ = request;
+    }
+
+    //! Set size of the uploaded data. If not set, data of the unknown size are uploaded
+    //! using chunked transfer encoding.
+    //! \param upload_size Size of the data returned by the handlers handle_input.
+    void set_upload_size(curl_off_t upload_size)
+    {
+        upload_size_ = upload_size;
+    }
+
     //! Get CurlError structure.
     //! Can be used to determine error reason if false was resurned by perform.
     //! \return reference to internal CurlError.
@@ -205,6 +223,8 @@ protected:
 
 private:
     std::string url_;               //!< Working url.
+    std::string request_;           //!< Custom request method, if any.
+    curl_off_t upload_size_;        //!< Size of the uploaded data, -1 if unknown.
     ::CURL *curl_;                  //!< libcurl handle.
     HandlersPtr handlers_;          //!< Pointer to implementation instance of *Handlers.
     char errbuf_[CURL_ERROR_SIZE];  //!< libcurl error buffer
@@ -276,6 +296,14 @@ bool CurlEasyClient<Handlers>::perform()
         ::curl_easy_setopt(curl_, CURLOPT_READDATA, this);
         ::curl_easy_setopt(curl_, CURLOPT_READFUNCTION, handle_read);
         ::curl_easy_setopt(curl_, CURLOPT_UPLOAD, 1L);
+        if (upload_size_ >= 0) {
+            ::curl_easy_setopt(curl_, CURLOPT_INFILESIZE_LARGE, upload_size_);
+        }
+    }
+    if (request_ == "HEAD") {
+        ::curl_easy_setopt(curl_, CURLOPT_NOBODY, 1L);
+    } else if (!request_.empty()) {
+        ::curl_easy_setopt(curl_, CURLOPT_CUSTOMREQUEST, request_.c_str());
     }
     ::curl_easy_setopt(curl_, CURLOPT_FAILONERROR, 1L);
 #ifdef DEBUG_VERBOSE_CURL
@@ -29,15 +29,309 @@
 #include <fsindexer.h>
 #include <logging.h>
 #include <boost_filesystem_ext.hpp>
+#include <blake3.h>
 
-#include <iostream>
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <deque>
+#include <exception>
 #include <fstream>
-#include <queue>
+#include <vector>
 
 namespace piel { namespace lib {
 
 namespace fs = boost::filesystem;
 
+namespace {
+
+    //! Scanned index element.
+    struct ScanEntry {
+        std::string name;       //!< Index path (relative to the indexed directory).
+        std::string path;       //!< Filesystem path.
+        bool        symlink;    //!< Entry is symlink.
+        int         mode;       //!< Unix mode.
+        Asset       asset;      //!< Entry asset.
+    };
+
+    //! Directory to scan.
+    struct DirTask {
+        std::string path;       //!< Filesystem path.
+        std::string prefix;     //!< Index path prefix for directory elements.
+    };
+
+    //! Per thread scanner state. Own tasks are taken from back, stolen from front.
+    struct ScanWorker {
+        boost::mutex            mutex;
+        std::deque<DirTask>     tasks;
+        std::vector<ScanEntry>  entries;
+    };
+
+    //! Parallel directories scanner. Directories are distributed between workers,
+    //! idle workers steal directories from others. Workers must not log: logger
+    //! is not thread safe.
+    class Scanner {
+    public:
+        Scanner(const std::string& exclude, StatCache *stat_cache, unsigned int threads)
+            : exclude_(exclude)
+            , stat_cache_(stat_cache)
+            , workers_(threads)
+            , pending_(0)
+            , failed_(false)
+            , error_()
+            , idle_mutex_()
+            , idle_cv_()
+        {
+            for (std::size_t i = 0; i < workers_.size(); ++i)
+            {
+                workers_[i].reset(new ScanWorker());
+            }
+        }
+
+        void run(const std::string& root)
+        {
+            DirTask root_task = { root, std::string() };
+            push(0, root_task);
+
+            if (workers_.size() == 1)
+            {
+                work(0);
+            }
+            else
+            {
+                boost::thread_group threads;
+                for (std::size_t i = 0; i < workers_.size(); ++i)
+                {
+                    threads.create_thread(boost::bind(&Scanner::pool_work, this, i));
+                }
+                threads.join_all();
+            }
+
+            if (error_)
+            {
+                std::rethrow_exception(error_);
+            }
+        }
+
+        std::size_t workers_count() const
+        {
+            return workers_.size();
+        }
+
+        const std::vector<ScanEntry>& entries(std::size_t worker) const
+        {
+            return workers_[worker]->entries;
+        }
+
+    private:
+        void push(std::size_t worker, const DirTask& task)
+        {
+            ++pending_;
+            {
+                boost::mutex::scoped_lock lock(workers_[worker]->mutex);
+                workers_[worker]->tasks.push_back(task);
+            }
+            idle_cv_.notify_one();
+        }
+
+        bool pop(std::size_t worker, DirTask& task)
+        {
+            {
+                ScanWorker& own = *workers_[worker];
+                boost::mutex::scoped_lock lock(own.mutex);
+                if (!own.tasks.empty())
+                {
+                    task = own.tasks.back();
+                    own.tasks.pop_back();
+                    return true;
+                }
+            }
+
+            for (std::size_t i = 1; i < workers_.size(); ++i)
+            {
+                ScanWorker& victim = *workers_[(worker + i) % workers_.size()];
+                boost::mutex::scoped_lock lock(victim.mutex);
+                if (!victim.tasks.empty())
+                {
+                    task = victim.tasks.front();
+                    victim.tasks.pop_front();
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        //! Workers hash many files concurrently, so each file is hashed by one thread.
+        void pool_work(std::size_t worker)
+        {
+            Blake3Hasher::SerialScope serial_hashing;
+            work(worker);
+        }
+
+        void work(std::size_t worker)
+        {
+            for (;;)
+            {
+                DirTask task;
+                if (pop(worker, task))
+                {
+                    if (!failed_)
+                    {
+                        try
+                        {
+                            scan(worker, task);
+                        }
+                        catch (...)
+                        {
+                            boost::mutex::scoped_lock lock(idle_mutex_);
+                            if (!error_)
+                            {
+                                error_ = std::current_exception();
+                            }
+                            failed_ = true;
+                        }
+                    }
+
+                    if (--pending_ == 0)
+                    {
+                        boost::mutex::scoped_lock lock(idle_mutex_);
+                        idle_cv_.notify_all();
+                    }
+                    continue;
+                }
+
+                boost::mutex::scoped_lock lock(idle_mutex_);
+                if (pending_ == 0)
+                {
+                    return;
+                }
+                idle_cv_.timed_wait(lock, boost::posix_time::milliseconds(1));
+            }
+        }
+
+        void scan(std::size_t worker, const DirTask& task)
+        {
+            DIR *dir = ::opendir(task.path.c_str());
+            if (!dir)
+            {
+                throw fs::filesystem_error("opendir", fs::path(task.path),
+                        boost::system::error_code(errno, boost::system::system_category()));
+            }
+
+            std::vector<ScanEntry>& entries = workers_[worker]->entries;
+
+            while (struct dirent *e = ::readdir(dir))
+            {
+                if (e->d_name[0] == '.' && (e->d_name[1] == '\0' || (e->d_name[1] == '.' && e->d_name[2] == '\0')))
+                {
+                    continue;
+                }
+
+                std::string path = task.path + "/" + e->d_name;
+                std::string name = task.prefix + e->d_name;
+
+                unsigned char type = e->d_type;
+                boost::optional<StatCache::Stat> st;
+                if (type == DT_UNKNOWN)
+                {
+                    st = StatCache::stat(path);
+                    if (!st) continue;
+
+                    if      (S_ISDIR(st->mode)) type = DT_DIR;
+                    else if (S_ISLNK(st->mode)) type = DT_LNK;
+                    else if (S_ISREG(st->mode)) type = DT_REG;
+                }
+
+                if (type == DT_DIR)
+                {
+                    if (exclude_.empty() || path != exclude_)
+                    {
+                        DirTask subdir = { path, name + "/" };
+                        push(worker, subdir);
+                    }
+                }
+                else if (type == DT_LNK)
+                {
+                    if (!st) st = StatCache::stat(path);
+                    if (!st) continue;
+
+                    std::vector<char> target(st->size + 1);
+                    ssize_t len = ::readlink(path.c_str(), target.data(), target.size());
+                    if (len < 0) continue;
+
+                    ScanEntry entry = { name, path, true, static_cast<int>(st->mode),
+                                        Asset::create_for(std::string(target.data(), len)) };
+                    entries.push_back(entry);
+                }
+                else if (type == DT_REG)
+                {
+                    if (!st) st = StatCache::stat(path);
+                    if (!st) continue;
+
+                    ScanEntry entry = { name, path, false, static_cast<int>(st->mode), file_asset(path, name, *st) };
+                    entries.push_back(entry);
+                }
+            }
+
+            ::closedir(dir);
+        }
+
+        Asset file_asset(const std::string& path, const std::string& name, const StatCache::Stat& st)
+        {
+            if (!stat_cache_)
+            {
+                return Asset::create_for(fs::path(path));
+            }
+
+            boost::optional<AssetId> cached_id = stat_cache_->lookup(name, st);
+            if (cached_id)
+            {
+                return Asset::create_for(fs::path(path), *cached_id);
+            }
+
+            // Stat information is taken before hashing, so changes made during hashing
+            // will be detected on the next lookup.
+            std::ifstream is(path.c_str(), std::ifstream::in|std::ifstream::binary);
+            if (!is)
+            {
+                return Asset::create_for(fs::path(path));
+            }
+
+            AssetId id = AssetId::create_for(is);
+            stat_cache_->update(name, st, id);
+            return Asset::create_for(fs::path(path), id);
+        }
+
+    private:
+        std::string                                 exclude_;       //!< Excluded directory path.
+        StatCache                                   *stat_cache_;   //!< Optional stat cache.
+        std::vector<boost::shared_ptr<ScanWorker> > workers_;       //!< Workers state.
+        boost::atomic<std::size_t>                  pending_;       //!< Queued and in progress directories count.
+        boost::atomic<bool>                         failed_;        //!< Scan failed, skip remaining directories.
+        std::exception_ptr                          error_;         //!< First scan error.
+        boost::mutex                                idle_mutex_;
+        boost::condition_variable                   idle_cv_;
+    };
+
+    std::string scanner_path(const fs::path& path)
+    {
+        std::string result = path.string();
+        while (result.size() > 1 && result[result.size() - 1] == '/')
+        {
+            result.erase(result.size() - 1);
+        }
+        return result;
+    }
+
+} // namespace
+
 FsIndexer::FsIndexer()
 {
 }
@@ -46,68 +340,67 @@ FsIndexer::~FsIndexer()
 {
 }
 
+/*static*/ unsigned int FsIndexer::threads_count()
+{
+    return std::max(1u, boost::thread::hardware_concurrency());
+}
+
 /*static*/ TreeIndex::Ptr FsIndexer::build(const fs::path& dir, const fs::path& exclude)
+{
+    return build(dir, exclude, static_cast<StatCache*>(0));
+}
+
+/*static*/ TreeIndex::Ptr FsIndexer::build(const fs::path& dir, const fs::path& exclude, StatCache& stat_cache)
+{
+    return build(dir, exclude, &stat_cache);
+}
+
+/*static*/ TreeIndex::Ptr FsIndexer::build(const fs::path& dir, const fs::path& exclude, StatCache *stat_cache)
 {
     if (!is_directory(dir)) {
         LOGF << dir << " is not a directory!" << ELOG;
         return TreeIndex::Ptr(new TreeIndex());
     }
 
-    TreeIndex::Ptr          result(new TreeIndex());
-    std::queue<fs::path>    directories;
+    TreeIndex::Ptr result(new TreeIndex());
 
-    directories.push( dir );
+    std::string root = scanner_path(dir);
+    Scanner scanner(exclude.empty() ? std::string() : scanner_path(exclude), stat_cache, threads_count());
 
-    while( !directories.empty() )
-    {
-        fs::path p = directories.front();
-        directories.pop();
+    LOGT << "d " << dir.generic_string() << " threads: " << threads_count() << ELOG;
 
-        LOGT << "d " << p.generic_string() << ELOG;
+    scanner.run(root);
 
-        for (fs::directory_iterator i = fs::directory_iterator(p), end = fs::directory_iterator(); i != end; i++)
-        {
-            fs::directory_entry e           = *i;
-            fs::path            relative    = fs::make_relative( dir, e.path() );
-            std::string         name        = relative.generic_string();
+    for (std::size_t w = 0; w < scanner.workers_count(); ++w)
+    {
+        const std::vector<ScanEntry>& entries = scanner.entries(w);
 
-            if ( fs::is_symlink( e.path() ) )
+        for (std::vector<ScanEntry>::const_iterator i = entries.begin(), end = entries.end(); i != end; ++i)
+        {
+            if (i->symlink)
             {
-                std::string target = fs::read_symlink( e.path() ).generic_string();
+                LOGT << "s " << i->name << ELOG;
 
-                LOGT << "s " << name << ELOG;
-
-                if (result->insert_path(name, Asset::create_for(target)))
+                if (result->insert_path(i->name, i->asset))
                 {
-                    PredefinedAttributes::fill_symlink_attrs(result, name, e.path());
+                    PredefinedAttributes::fill_symlink_attrs(result, i->name, i->mode);
                 }
                 else
                 {
-                    LOGF << "Can't insert element " << name << " into index! Probably index already have element with such name." << ELOG;
+                    LOGF << "Can't insert element " << i->name << " into index! Probably index already have element with such name." << ELOG;
                 }
             }
-            else if ( fs::is_regular_file( e.path() ) )
+            else
             {
-                LOGT << "f " << name << ELOG;
+                LOGT << "f " << i->name << ELOG;
 
-                if (result->insert_path(name, Asset::create_for(e.path())))
-                {
-                    PredefinedAttributes::fill_file_attrs(result, name, e.path());
-                }
-                else
-                {
-                    LOGF << "Can't insert element " << name << " into index! Probably index already have element with such name." << ELOG;
-                }
-            }
-            else if ( fs::is_directory(e.path()) )
-            {
-                if ( exclude.empty() || e.path() != exclude )
+                if (result->insert_path(i->name, i->asset))
                 {
-                    directories.push( e.path() );
+                    PredefinedAttributes::fill_file_attrs(result, i->name, i->mode);
                 }
                 else
                 {
-                    LOGT << "exclude directory:" << e.path() << ELOG;
+                    LOGF << "Can't insert element " << i->name << " into index! Probably index already have element with such name." << ELOG;
                 }
             }
         }
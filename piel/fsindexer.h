@@ -31,6 +31,7 @@
 
 #include <boost/filesystem.hpp>
 #include <treeindex.h>
+#include <statcache.h>
 
 namespace piel { namespace lib {
 
@@ -50,6 +51,20 @@ public:
     //! \return an index.
     static TreeIndex::Ptr build(const boost::filesystem::path& dir, const boost::filesystem::path& exclude = boost::filesystem::path());
 
+    //! Build filesystem index using stat cache. Files with unchanged stat information
+    //! get ids from the cache, other files are hashed and cache is updated.
+    //! \param dir indexed directory.
+    //! \param exclude sub directory what will be skipped on indexing.
+    //! \param stat_cache stat cache.
+    //! \return an index.
+    static TreeIndex::Ptr build(const boost::filesystem::path& dir, const boost::filesystem::path& exclude, StatCache& stat_cache);
+
+    //! \return Count of the threads used to scan directories.
+    static unsigned int threads_count();
+
+private:
+    static TreeIndex::Ptr build(const boost::filesystem::path& dir, const boost::filesystem::path& exclude, StatCache *stat_cache);
+
 };
 
 } } // namespace piel::lib
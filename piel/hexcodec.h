@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PIEL_HEXCODEC_H_
+#define PIEL_HEXCODEC_H_
+
+#include <cstddef>
+#include <string>
+
+namespace piel { namespace lib {
+
+//! Table driven hex encoder/decoder. Used to convert binary digests into the
+//! strings representation and back.
+struct HexCodec {
+    //! Encode data into the lower case hex string.
+    //! \param data Data to encode.
+    //! \param size Data size.
+    //! \param out Output buffer, must have at least size * 2 bytes.
+    static void encode(const unsigned char *data, std::size_t size, char *out);
+
+    //! Encode data into the lower case hex string.
+    //! \param data Data to encode.
+    //! \param size Data size.
+    //! \return Hex string.
+    static std::string encode(const unsigned char *data, std::size_t size);
+
+    //! Decode hex string. Both lower and upper case digits are accepted.
+    //! \param str Hex string.
+    //! \param len Hex string length. Must be even.
+    //! \param out Output buffer, must have at least len / 2 bytes.
+    //! \return false if string is not valid hex string.
+    static bool decode(const char *str, std::size_t len, unsigned char *out);
+};
+
+} } // namespace piel::lib
+
+#endif /* PIEL_HEXCODEC_H_ */
@@ -28,73 +28,130 @@
 
 #include <indexesdiff.h>
 
+#include <merkletree.h>
 #include <logging.h>
 
+#include <algorithm>
+
 namespace piel { namespace lib {
 
+//! Skip nothing.
+struct NoSkip {
+    bool skip(const std::string& key, std::string& next) const
+    {
+        return false;
+    }
+};
+
+//! Skip paths from the directories what have equal ids in both tree layout indexes.
+struct EqualDirectoriesSkip {
+    EqualDirectoriesSkip(const TreeIndex::DirectoryIds *first, const TreeIndex::DirectoryIds *second)
+        : first_(first)
+        , second_(second)
+    {
+    }
+
+    //! \param key Current path.
+    //! \param next First path after the skipped directory.
+    //! \return true if key is in the equal directory.
+    bool skip(const std::string& key, std::string& next) const
+    {
+        if (!first_ || !second_)
+        {
+            return false;
+        }
+
+        for (std::string::size_type pos = key.find('/'); pos != std::string::npos; pos = key.find('/', pos + 1))
+        {
+            std::string dir = key.substr(0, pos);
+
+            TreeIndex::DirectoryIds::const_iterator f = first_->find(dir);
+            TreeIndex::DirectoryIds::const_iterator s = second_->find(dir);
+
+            if (f == first_->end() || s == second_->end())
+            {
+                return false;
+            }
+
+            if (f->second == s->second)
+            {
+                // '0' follows '/', so all "dir/..." paths are less than "dir0".
+                next = dir + static_cast<char>('/' + 1);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+private:
+    const TreeIndex::DirectoryIds *first_;
+    const TreeIndex::DirectoryIds *second_;
+};
+
+//! Builds diff of two sorted maps by the single ordered sweep. Only changed elements are emitted.
 template<class DiffMap, class CompareMap>
 struct MapDiffBuilder {
 
-    typedef typename DiffMap::iterator                      DiffMapIterator;
     typedef typename CompareMap::const_iterator             ConstIter;
     typedef typename CompareMap::value_type::second_type    EmptyValueType;
 
     static DiffMap diff(const CompareMap& first_map, const CompareMap& second_map)
+    {
+        return diff(first_map, second_map, NoSkip());
+    }
+
+    template<class Skip>
+    static DiffMap diff(const CompareMap& first_map, const CompareMap& second_map, const Skip& skip)
     {
         DiffMap result;
 
-        ConstIter first_end    = first_map.end(),
-                  second_end   = second_map.end();
+        ConstIter i             = first_map.begin(),
+                  first_end     = first_map.end(),
+                  j             = second_map.begin(),
+                  second_end    = second_map.end();
 
-        for (ConstIter i = first_map.begin(); i != first_end; ++i)
+        std::string next;
+        while (i != first_end || j != second_end)
         {
-            ConstIter second_iter_ = second_map.find(i->first);
+            bool only_first     = j == second_end || (i != first_end && i->first < j->first);
+            bool only_second    = !only_first && (i == first_end || j->first < i->first);
 
-            std::pair<DiffMapIterator, bool> insert_result;
-
-            if (second_iter_ != second_end)
+            if (skip.skip(only_second ? j->first : i->first, next))
             {
-                IndexesDiff::ElementState element_state = (i->second == second_iter_->second)
-                        ?  IndexesDiff::ElementState_unmodified
-                        :  IndexesDiff::ElementState_modified;
-
-
-                insert_result = result.insert(
-                        std::make_pair(i->first,
-                                std::make_pair(element_state,
-                                        std::make_pair(i->second, second_iter_->second))));
+                i = first_map.lower_bound(next);
+                j = second_map.lower_bound(next);
+                continue;
             }
-            else
+
+            // Keys are visited in order, so the end of the result is always the right hint.
+            if (only_first)
             {
-                insert_result = result.insert(
+                result.insert(result.end(),
                         std::make_pair(i->first,
                                 std::make_pair(IndexesDiff::ElementState_removed,
                                         std::make_pair(i->second, EmptyValueType()))));
+                ++i;
             }
-
-            if (!insert_result.second)
+            else if (only_second)
             {
-                LOGF << "Unable on insert maps diff element into diff. Key: " << i->first << ELOG;
+                result.insert(result.end(),
+                        std::make_pair(j->first,
+                                std::make_pair(IndexesDiff::ElementState_added,
+                                        std::make_pair(EmptyValueType(), j->second))));
+                ++j;
             }
-        }
-
-        for (ConstIter i = second_map.begin(); i != second_end; ++i)
-        {
-            ConstIter first_iter = first_map.find(i->first);
-
-            if (first_iter == first_end)
+            else
             {
-                std::pair<DiffMapIterator, bool> insert_result;
-
-                insert_result = result.insert(
-                        std::make_pair(i->first,
-                                std::make_pair(IndexesDiff::ElementState_added,
-                                        std::make_pair(EmptyValueType(), i->second))));
-
-                if (!insert_result.second)
+                if (i->second != j->second)
                 {
-                    LOGF << "Unable on insert maps diff element into diff. Key: " << i->first << ELOG;
+                    result.insert(result.end(),
+                            std::make_pair(i->first,
+                                    std::make_pair(IndexesDiff::ElementState_modified,
+                                            std::make_pair(i->second, j->second))));
                 }
+                ++i;
+                ++j;
             }
         }
 
@@ -103,18 +160,24 @@ struct MapDiffBuilder {
 
 };
 
-struct FindChangedElement {
+//! Compares keys of the map elements.
+struct EqualKeys {
 
     template<class ValueType>
-    bool operator()(ValueType val) const
+    bool operator()(const ValueType& first, const ValueType& second) const
     {
-        return val.second.first != IndexesDiff::ElementState_unmodified;
+        return first.first == second.first;
     }
 
-    template<class Map>
-    static bool has_changed(const Map& map)
+};
+
+//! Compares values of the map elements.
+struct EqualValues {
+
+    template<class ValueType>
+    bool operator()(const ValueType& first, const ValueType& second) const
     {
-        return std::find_if(map.begin(), map.end(), FindChangedElement()) != map.end();
+        return first.second == second.second;
     }
 
 };
@@ -142,17 +205,17 @@ bool IndexesDiff::empty() const
 
 bool IndexesDiff::different_content() const
 {
-    return FindChangedElement::has_changed(content_diff_);
+    return !content_diff_.empty();
 }
 
 bool IndexesDiff::different_attributes() const
 {
-    return FindChangedElement::has_changed(attributes_diff_);
+    return !attributes_diff_.empty();
 }
 
 bool IndexesDiff::different_content_attributes() const
 {
-    return FindChangedElement::has_changed(content_attributes_diff_);
+    return !content_attributes_diff_.empty();
 }
 
 const IndexesDiff::ContentDiff& IndexesDiff::content_diff() const
@@ -250,11 +313,73 @@ std::string IndexesDiff::format() const
 {
     IndexesDiff result;
 
-    result.content_diff_            = ContentDiffBuilder::diff(first_index->content_, second_index->content_);
-    result.attributes_diff_         = AttributesDiffBuilder::diff(first_index->attributes_, second_index->attributes_);
-    result.content_attributes_diff_ = ContentAttributesDiffBuilder::diff(first_index->content_attributes_, second_index->content_attributes_);
+    result.attributes_diff_ = AttributesDiffBuilder::diff(first_index->attributes_, second_index->attributes_);
+
+    // Directory ids are compared before the content is expanded.
+    const AssetId *first_root   = first_index->root_directory_id();
+    const AssetId *second_root  = second_index->root_directory_id();
+
+    if (first_root && second_root && *first_root == *second_root)
+    {
+        LOGT << "Equal content trees." << ELOG;
+        return result;
+    }
+
+    if (first_index->expand_storage_ && second_index->expand_storage_)
+    {
+        // Only the sub trees what differ are read.
+        TreeIndex::Content              first_content, second_content;
+        TreeIndex::ContentAttributes    first_content_attributes, second_content_attributes;
+
+        MerkleTree::expand_changed(first_index->expand_storage_, *first_root, first_content, first_content_attributes,
+                                   second_index->expand_storage_, *second_root, second_content, second_content_attributes);
+
+        result.content_diff_            = ContentDiffBuilder::diff(first_content, second_content);
+        result.content_attributes_diff_ = ContentAttributesDiffBuilder::diff(first_content_attributes, second_content_attributes);
+
+        return result;
+    }
+
+    EqualDirectoriesSkip skip(first_index->directory_ids(), second_index->directory_ids());
+
+    result.content_diff_            = ContentDiffBuilder::diff(first_index->content_, second_index->content_, skip);
+    result.content_attributes_diff_ = ContentAttributesDiffBuilder::diff(first_index->content_attributes_, second_index->content_attributes_, skip);
 
     return result;
 }
 
+/*static*/ bool IndexesDiff::has_changes(const TreeIndex::Ptr& first_index, const TreeIndex::Ptr& second_index)
+{
+    // Directory objects cover both the content and the content attributes, so the
+    //tree layout indexes are compared without expanding.
+    const AssetId *first_root   = first_index->root_directory_id();
+    const AssetId *second_root  = second_index->root_directory_id();
+
+    if (first_root && second_root)
+    {
+        return *first_root != *second_root;
+    }
+
+    const TreeIndex::Content& first_content     = first_index->content();
+    const TreeIndex::Content& second_content    = second_index->content();
+
+    if (first_content.size() != second_content.size())
+    {
+        return true;
+    }
+
+    // Cheap checks go first: the content ids are calculated only for the equal paths sets.
+    if (!std::equal(first_content.begin(), first_content.end(), second_content.begin(), EqualKeys()))
+    {
+        return true;
+    }
+
+    if (first_index->content_attributes_ != second_index->content_attributes_)
+    {
+        return true;
+    }
+
+    return !std::equal(first_content.begin(), first_content.end(), second_content.begin(), EqualValues());
+}
+
 } } // namespace piel::lib
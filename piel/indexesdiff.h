@@ -103,8 +103,12 @@ public:
     const ContentAttributesDiff& content_attributes_diff() const;
     AttributesDiff content_item_attributes_diff(const ContentAttributesDiff::const_iterator& element) const;
 
+    //! Diff contains only the changed elements.
     static IndexesDiff diff(const TreeIndex::Ptr& first_index, const TreeIndex::Ptr& second_index);
 
+    //! Same as !diff(first_index, second_index).empty(), but stops on the first difference.
+    static bool has_changes(const TreeIndex::Ptr& first_index, const TreeIndex::Ptr& second_index);
+
     std::string format() const;
 
 private:
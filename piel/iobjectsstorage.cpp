@@ -35,4 +35,56 @@ IObjectsStorage::~IObjectsStorage()
 
 }
 
+AssetId IObjectsStorage::ingest(const Asset& asset)
+{
+    put(asset);
+    return asset.id();
+}
+
+void IObjectsStorage::put_verified(const Asset& asset)
+{
+    if (contains(asset.id()))
+    {
+        return;
+    }
+
+    // Data are read twice, storages what calculate ids while storing override it.
+    boost::shared_ptr<std::istream> isp = asset.istream();
+    if (!isp)
+    {
+        throw errors::attempt_to_put_non_readable_asset();
+    }
+
+    if (AssetId::create_for(*isp) != asset.id())
+    {
+        throw errors::put_data_id_mismatch();
+    }
+
+    put(asset);
+}
+
+std::size_t IObjectsStorage::size_of(const AssetId& id) const
+{
+    return 0;
+}
+
+boost::filesystem::path IObjectsStorage::object_file(const AssetId& id) const
+{
+    return boost::filesystem::path();
+}
+
+std::vector<AssetId> IObjectsStorage::reference_log(const std::string& ref_name) const
+{
+    std::vector<AssetId> result;
+    std::set<refs::Ref> refs = references();
+    for (std::set<refs::Ref>::const_iterator i = refs.begin(), end = refs.end(); i != end; ++i)
+    {
+        if (i->first == ref_name)
+        {
+            result.push_back(i->second);
+        }
+    }
+    return result;
+}
+
 } } // namespace piel::lib
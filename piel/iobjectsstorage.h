@@ -34,6 +34,7 @@
 #include <boost/shared_ptr.hpp>
 #include <set>
 #include <string>
+#include <vector>
 #include <iostream>
 
 namespace piel { namespace lib {
@@ -42,6 +43,7 @@ namespace errors {
     // Common put error
     struct attempt_to_put_non_readable_asset {};
     struct unable_to_insert_new_reference {};
+    struct put_data_id_mismatch {};
 }
 
 namespace refs {
@@ -61,6 +63,16 @@ public:
     virtual void put(const Asset& asset) = 0;
     virtual void put(std::set<Asset> assets) = 0;
 
+    // Put readable asset into storage and return its id. Storage implementation can
+    //calculate not yet calculated asset id while storing the data, so the asset data
+    //will be read only once.
+    virtual AssetId ingest(const Asset& asset);
+
+    // Put readable asset into storage checking its data against the asset id. Used for the
+    //assets from the untrusted sources. Throws put_data_id_mismatch and stores nothing if the
+    //data id differs from the asset id.
+    virtual void put_verified(const Asset& asset);
+
     // Check if readable asset available in storage.
     virtual bool contains(const AssetId& id) const = 0;
 
@@ -71,6 +83,12 @@ public:
     //External code must use get().istream() call sequense.
     virtual boost::shared_ptr<std::istream> istream_for(const AssetId& id) const = 0;
 
+    // Size of the asset data if it is known without reading the data, 0 otherwise.
+    virtual std::size_t size_of(const AssetId& id) const;
+
+    // Local file what holds exactly the asset data, empty path if the storage has no such file.
+    virtual boost::filesystem::path object_file(const AssetId& id) const;
+
     // References related API
     //typedef std::pair<std::string, AssetId> Ref;
     virtual void create_reference(const refs::Ref& ref) = 0;
@@ -80,6 +98,9 @@ public:
     virtual AssetId resolve(const std::string& refName) const = 0;
     virtual std::set<refs::Ref> references() const = 0;
 
+    // Values the reference had, most recent first. Storages without history return current value only.
+    virtual std::vector<AssetId> reference_log(const std::string& ref_name) const;
+
 };
 
 } } // namespace piel::lib
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <layeredstorage.h>
+#include <logging.h>
+
+namespace piel { namespace lib {
+
+LayeredStorage::LayeredStorage(const IObjectsStorage::Ptr& local, const Layers& lower)
+    : IObjectsStorage()
+    , local_(local)
+    , lower_(lower)
+    , promote_(false)
+{
+}
+
+LayeredStorage::~LayeredStorage()
+{
+}
+
+void LayeredStorage::add_layer(const IObjectsStorage::Ptr& storage)
+{
+    lower_.push_back(storage);
+}
+
+void LayeredStorage::set_promotion(bool promote)
+{
+    promote_ = promote;
+}
+
+IObjectsStorage::Ptr LayeredStorage::local() const
+{
+    return local_;
+}
+
+const LayeredStorage::Layers& LayeredStorage::layers() const
+{
+    return lower_;
+}
+
+void LayeredStorage::put(const Asset& asset)
+{
+    if (contains(asset.id()))
+    {
+        LOGT << "Asset: " << asset.id().string() << " is already in storage layers." << ELOG;
+        return;
+    }
+
+    local_->put(asset);
+}
+
+void LayeredStorage::put(std::set<Asset> assets)
+{
+    std::set<Asset> missing;
+    for (std::set<Asset>::const_iterator i = assets.begin(), end = assets.end(); i != end; ++i)
+    {
+        if (!contains(i->id()))
+        {
+            missing.insert(*i);
+        }
+    }
+
+    local_->put(missing);
+}
+
+AssetId LayeredStorage::ingest(const Asset& asset)
+{
+    if (asset.id_calculated() && contains(asset.id()))
+    {
+        return asset.id();
+    }
+
+    return local_->ingest(asset);
+}
+
+void LayeredStorage::put_verified(const Asset& asset)
+{
+    if (contains(asset.id()))
+    {
+        LOGT << "Asset: " << asset.id().string() << " is already in storage layers." << ELOG;
+        return;
+    }
+
+    local_->put_verified(asset);
+}
+
+void LayeredStorage::create_reference(const refs::Ref& ref)
+{
+    local_->create_reference(ref);
+}
+
+void LayeredStorage::destroy_reference(const refs::Ref::first_type& ref_name)
+{
+    local_->destroy_reference(ref_name);
+}
+
+void LayeredStorage::update_reference(const refs::Ref& ref)
+{
+    local_->update_reference(ref);
+}
+
+IObjectsStorage::Ptr LayeredStorage::holder_of(const AssetId& id) const
+{
+    if (local_->contains(id))
+    {
+        return local_;
+    }
+
+    for (Layers::const_iterator i = lower_.begin(), end = lower_.end(); i != end; ++i)
+    {
+        if (!(*i)->contains(id))
+        {
+            continue;
+        }
+
+        if (!promote_)
+        {
+            return *i;
+        }
+
+        LOGT << "Promote object: " << id.string() << " into the local storage." << ELOG;
+
+        local_->put((*i)->asset(*i, id));
+        return local_;
+    }
+
+    return IObjectsStorage::Ptr();
+}
+
+bool LayeredStorage::contains(const AssetId& id) const
+{
+    if (local_->contains(id))
+    {
+        return true;
+    }
+
+    for (Layers::const_iterator i = lower_.begin(), end = lower_.end(); i != end; ++i)
+    {
+        if ((*i)->contains(id))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+Asset LayeredStorage::asset(const IObjectsStorage::Ptr& storage, const AssetId& id) const
+{
+    if (contains(id))
+    {
+        return Asset::create_for(storage, id);
+    }
+    else
+    {
+        return Asset();
+    }
+}
+
+boost::shared_ptr<std::istream> LayeredStorage::istream_for(const AssetId& id) const
+{
+    IObjectsStorage::Ptr holder = holder_of(id);
+    return holder ? holder->istream_for(id) : boost::shared_ptr<std::istream>();
+}
+
+std::size_t LayeredStorage::size_of(const AssetId& id) const
+{
+    if (local_->contains(id))
+    {
+        return local_->size_of(id);
+    }
+
+    for (Layers::const_iterator i = lower_.begin(), end = lower_.end(); i != end; ++i)
+    {
+        if ((*i)->contains(id))
+        {
+            return (*i)->size_of(id);
+        }
+    }
+
+    return 0;
+}
+
+boost::filesystem::path LayeredStorage::object_file(const AssetId& id) const
+{
+    // Lower storages files must not be linked into the working copy, so only the local
+    //storage objects (including just promoted ones) are returned.
+    IObjectsStorage::Ptr holder = holder_of(id);
+    return holder == local_ ? local_->object_file(id) : boost::filesystem::path();
+}
+
+AssetId LayeredStorage::resolve(const std::string& ref) const
+{
+    AssetId id = local_->resolve(ref);
+    if (id != AssetId::empty || ref.length() != AssetId::str_digest_len)
+    {
+        return id;
+    }
+
+    // Attempt to resolve AssetId by string representation.
+    id = AssetId::create(ref);
+    return id != AssetId::empty && contains(id) ? id : AssetId::empty;
+}
+
+std::set<refs::Ref> LayeredStorage::references() const
+{
+    return local_->references();
+}
+
+std::vector<AssetId> LayeredStorage::reference_log(const std::string& ref_name) const
+{
+    return local_->reference_log(ref_name);
+}
+
+} } // namespace piel::lib
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PIEL_LAYEREDSTORAGE_H_
+#define PIEL_LAYEREDSTORAGE_H_
+
+#include <iobjectsstorage.h>
+
+#include <vector>
+
+namespace piel { namespace lib {
+
+//! Objects storage what chains the local storage with the lower (shared) storages.
+//!
+//! New objects and references are always written into the local storage. Objects
+//! lookups fall through the layers in order: local storage first, then each lower
+//! storage. Lower storages are never modified, so they can be shared between the
+//! working copies (host wide cache directory, read only network store).
+//!
+//! If promotion is enabled, objects read from a lower storage are copied into the
+//! local one, so the next reads don't depend on the lower storage.
+class LayeredStorage : public IObjectsStorage
+{
+public:
+    typedef std::vector<IObjectsStorage::Ptr> Layers;
+
+    LayeredStorage(const IObjectsStorage::Ptr& local, const Layers& lower = Layers());
+    virtual ~LayeredStorage();
+
+    //! Append storage to the end of the lookup chain.
+    void add_layer(const IObjectsStorage::Ptr& storage);
+    //! Copy objects found in the lower storages into the local one.
+    void set_promotion(bool promote);
+
+    IObjectsStorage::Ptr local() const;
+    const Layers& layers() const;
+
+    // Put readable asset(s) into storage.
+    void put(const Asset& asset);
+    void put(std::set<Asset> assets);
+    AssetId ingest(const Asset& asset);
+    void put_verified(const Asset& asset);
+    void create_reference(const refs::Ref& ref);
+    void destroy_reference(const refs::Ref::first_type& ref_name);
+    void update_reference(const refs::Ref& ref);
+
+    // Check if readable asset available in storage.
+    bool contains(const AssetId& id) const;
+
+    // Make attempt to get readable asset from storage. Non readable Asset will be returned on fail.
+    Asset asset(const IObjectsStorage::Ptr& storage, const AssetId& id) const;
+
+    // Get input stream for reading asset data. Low level API used by Asset implementation.
+    //External code must use get().istream() call sequense.
+    boost::shared_ptr<std::istream> istream_for(const AssetId& id) const;
+    std::size_t size_of(const AssetId& id) const;
+    boost::filesystem::path object_file(const AssetId& id) const;
+
+    AssetId resolve(const std::string& ref) const;
+    std::set<refs::Ref> references() const;
+    std::vector<AssetId> reference_log(const std::string& ref_name) const;
+
+protected:
+    //! Storage what contains the object: local storage, lower storage or empty pointer.
+    //! Promotes the object into the local storage if promotion is enabled.
+    IObjectsStorage::Ptr holder_of(const AssetId& id) const;
+
+private:
+    IObjectsStorage::Ptr    local_;         //!< Storage for the new objects and references.
+    Layers                  lower_;         //!< Read only storages in lookup order.
+    bool                    promote_;       //!< Copy lower storages objects into the local one.
+};
+
+} } // namespace piel::lib
+
+#endif /* PIEL_LAYEREDSTORAGE_H_ */
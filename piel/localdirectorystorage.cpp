@@ -27,9 +27,16 @@
  */
 
 #include <localdirectorystorage.h>
+#include <checksumsdigestbuilder.hpp>
 #include <logging.h>
 #include <boost/algorithm/string.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <boost/iostreams/device/array.hpp>
 
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 
 namespace piel { namespace lib {
@@ -41,12 +48,18 @@ namespace layout {
     struct L {
         static const std::string objects;
         static const std::string references;
+        static const std::string refs;
+        static const std::string logs;
+        static const std::string tmp;
         static const unsigned objects_storage_depth;
         static const unsigned objects_subdirs_names_length;
     };
 
     /*static*/ const std::string   L::objects                        = "objects";
     /*static*/ const std::string   L::references                     = "references.properties";
+    /*static*/ const std::string   L::refs                           = "refs";
+    /*static*/ const std::string   L::logs                           = "logs";
+    /*static*/ const std::string   L::tmp                            = "tmp";
     /*static*/ const unsigned      L::objects_storage_depth          = 3;
     /*static*/ const unsigned      L::objects_subdirs_names_length   = 2;
 
@@ -102,8 +115,71 @@ namespace layout {
         return asset_path(root_dir, asset.id());
     }
 
+    //! Reference file name. Characters unsafe for file names are written as %XX.
+    std::string ref_file_name(const std::string& ref_name)
+    {
+        static const char *hex = "0123456789abcdef";
+
+        std::string result;
+        for (std::string::size_type i = 0; i < ref_name.size(); ++i)
+        {
+            unsigned char c = static_cast<unsigned char>(ref_name[i]);
+            if (std::isalnum(c) || c == '_' || c == '-' || (c == '.' && i > 0))
+            {
+                result.push_back(static_cast<char>(c));
+            }
+            else
+            {
+                result.push_back('%');
+                result.push_back(hex[c >> 4]);
+                result.push_back(hex[c & 0x0f]);
+            }
+        }
+        return result;
+    }
+
+    //! Reference name for the reference file name.
+    std::string ref_name_for(const std::string& file_name)
+    {
+        std::string result;
+        for (std::string::size_type i = 0; i < file_name.size(); ++i)
+        {
+            if (file_name[i] == '%' && i + 2 < file_name.size())
+            {
+                result.push_back(static_cast<char>(std::strtoul(file_name.substr(i + 1, 2).c_str(), 0, 16)));
+                i += 2;
+            }
+            else
+            {
+                result.push_back(file_name[i]);
+            }
+        }
+        return result;
+    }
+
+    //! First line of the file, empty string if the file can't be read.
+    std::string read_line(const fs::path& path)
+    {
+        std::ifstream is(path.c_str());
+        std::string result;
+        std::getline(is, result);
+        return result;
+    }
+
 };
 
+namespace {
+
+    //! Read object header from the stream begin.
+    bool read_header(std::istream& is, ObjectCompression::Header& header)
+    {
+        char data[ObjectCompression::header_size];
+        std::streamsize readed = is.read(data, sizeof(data)).gcount();
+        return ObjectCompression::parse_header(data, static_cast<std::size_t>(readed), header);
+    }
+
+} // namespace
+
 namespace constants {
     struct C {
         static const std::string ref_ids_delimiter;
@@ -112,23 +188,34 @@ namespace constants {
     /*static*/ const std::string C::ref_ids_delimiter = ",";
 };
 
-LocalDirectoryStorage::LocalDirectoryStorage(const boost::filesystem::path& root_dir)
+LocalDirectoryStorage::LocalDirectoryStorage(const boost::filesystem::path& root_dir, bool read_only)
     : IObjectsStorage()
     , root_dir_(root_dir)
+    , compression_(ObjectCompression::Method_none)
+    , chunking_(false)
+    , read_only_(read_only)
 {
     objects_    = root_dir_ / layout::L::objects;
     references_ = root_dir_ / layout::L::references;
+    refs_dir_   = root_dir_ / layout::L::refs;
+    logs_dir_   = root_dir_ / layout::L::logs;
+    tmp_        = root_dir_ / layout::L::tmp;
 
-    LOGT << "Objects path: " << objects_ << " References: " << references_ << ELOG;
+    LOGT << "Objects path: " << objects_ << " References: " << refs_dir_ << ELOG;
 
-    if (!fs::exists(objects_) || !fs::exists(references_))
+    if (read_only_)
+    {
+        LOGT << "Attach read only. Objects path: " << objects_ << " References: " << refs_dir_ << ELOG;
+        attach();
+    }
+    else if (!fs::exists(objects_) || (!fs::exists(refs_dir_) && !fs::exists(references_)))
     {
-        LOGT << "Init. Objects path: " << objects_ << " References: " << references_ << ELOG;
+        LOGT << "Init. Objects path: " << objects_ << " References: " << refs_dir_ << ELOG;
         init();
     }
     else
     {
-        LOGT << "Attach. Objects path: " << objects_ << " References: " << references_ << ELOG;
+        LOGT << "Attach. Objects path: " << objects_ << " References: " << refs_dir_ << ELOG;
         attach();
     }
 }
@@ -139,9 +226,103 @@ LocalDirectoryStorage::~LocalDirectoryStorage()
 
 void LocalDirectoryStorage::attach()
 {
-    LOGT << "Loading references from: " << references_ << ELOG;
+    refs_.clear();
+
+    if (fs::exists(references_))
+    {
+        if (read_only_)
+        {
+            load_legacy_references();
+            return;
+        }
 
-    refs_ = Properties::load(*fs::istream(references_).get());
+        migrate_references();
+    }
+
+    LOGT << "Loading references from: " << refs_dir_ << ELOG;
+
+    if (!fs::exists(refs_dir_))
+    {
+        return;
+    }
+
+    for (fs::directory_iterator i(refs_dir_), end; i != end; ++i)
+    {
+        if (!fs::is_regular_file(i->status()))
+        {
+            continue;
+        }
+
+        std::string ref_name = layout::ref_name_for(i->path().filename().string());
+        std::string id_str   = layout::read_line(i->path());
+
+        if (id_str.length() != AssetId::str_digest_len)
+        {
+            LOGW << "Skip broken reference file: " << i->path() << ELOG;
+            continue;
+        }
+
+        refs_[ref_name] = AssetId::create(id_str);
+    }
+}
+
+void LocalDirectoryStorage::migrate_references()
+{
+    LOGI << "Converting references: " << references_ << ELOG;
+
+    Properties legacy = Properties::load(*fs::istream(references_).get());
+
+    for (Properties::MapType::const_iterator i = legacy.data().begin(), end = legacy.data().end(); i != end; ++i)
+    {
+        std::vector<std::string> ids;
+        boost::split(ids, i->second, boost::is_any_of(constants::C::ref_ids_delimiter));
+
+        // Legacy history is most recent first, the log is in order of updates.
+        fs::path log_path = logs_dir_ / layout::ref_file_name(i->first);
+        if (fs::exists(log_path))
+        {
+            fs::remove(log_path);
+        }
+        for (std::vector<std::string>::const_reverse_iterator id = ids.rbegin(), ids_end = ids.rend(); id != ids_end; ++id)
+        {
+            append_reference_log(std::make_pair(i->first, AssetId::create(*id)));
+        }
+
+        write_reference(std::make_pair(i->first, AssetId::create(ids[0])));
+    }
+
+    fs::remove(references_);
+}
+
+void LocalDirectoryStorage::load_legacy_references()
+{
+    LOGT << "Loading legacy references from: " << references_ << ELOG;
+
+    Properties legacy = Properties::load(*fs::istream(references_).get());
+
+    for (Properties::MapType::const_iterator i = legacy.data().begin(), end = legacy.data().end(); i != end; ++i)
+    {
+        std::vector<std::string> ids;
+        boost::split(ids, i->second, boost::is_any_of(constants::C::ref_ids_delimiter));
+
+        // Legacy history is most recent first.
+        refs_[i->first] = AssetId::create(ids[0]);
+    }
+}
+
+void LocalDirectoryStorage::check_writable() const
+{
+    if (read_only_)
+    {
+        LOGE << "Attempt to modify read only storage: " << root_dir_ << ELOG;
+
+        throw errors::attempt_to_modify_read_only_storage();
+    }
+}
+
+bool LocalDirectoryStorage::read_only() const
+{
+    return read_only_;
 }
 
 void LocalDirectoryStorage::init()
@@ -153,14 +334,76 @@ void LocalDirectoryStorage::init()
         throw errors::unable_to_create_directory();
     }
 
-    LOGT << "Init empty references: " << references_ << ELOG;
+    LOGT << "Init empty references: " << refs_dir_ << ELOG;
+
+    if (!fs::exists(refs_dir_) && !fs::create_directories(refs_dir_))
+    {
+        LOGF << "Unable to create references directory: " << refs_dir_ << ELOG;
+
+        throw errors::unable_to_create_directory();
+    }
+
+    refs_.clear();
+}
+
+void LocalDirectoryStorage::write_reference(const refs::Ref& ref) const
+{
+    if (!fs::exists(refs_dir_) && !fs::create_directories(refs_dir_))
+    {
+        LOGF << "Unable to create references directory: " << refs_dir_ << ELOG;
+
+        throw errors::unable_to_create_directory();
+    }
+
+    if (!fs::exists(tmp_) && !fs::create_directories(tmp_))
+    {
+        LOGF << "Unable to create temporary directory: " << tmp_ << ELOG;
+
+        throw errors::unable_to_create_directory();
+    }
+
+    fs::path tmp_path = tmp_ / fs::unique_path();
+    {
+        std::ofstream os(tmp_path.c_str(), std::ofstream::out|std::ofstream::trunc);
+        os << ref.second.string() << std::endl;
+        if (!os)
+        {
+            LOGF << "Unable to write reference: " << ref.first << ELOG;
+
+            throw errors::unable_to_write_reference();
+        }
+    }
+
+    // Rename is atomic, readers see either old or new reference value.
+    fs::rename(tmp_path, refs_dir_ / layout::ref_file_name(ref.first));
+}
+
+void LocalDirectoryStorage::append_reference_log(const refs::Ref& ref) const
+{
+    if (!fs::exists(logs_dir_) && !fs::create_directories(logs_dir_))
+    {
+        LOGF << "Unable to create reference logs directory: " << logs_dir_ << ELOG;
+
+        throw errors::unable_to_create_directory();
+    }
+
+    fs::path log_path = logs_dir_ / layout::ref_file_name(ref.first);
+
+    std::ofstream os(log_path.c_str(), std::ofstream::out|std::ofstream::app);
+    os << ref.second.string() << std::endl;
+    if (!os)
+    {
+        LOGF << "Unable to write reference log: " << log_path << ELOG;
 
-    refs_.store(*fs::ostream(references_).get());
+        throw errors::unable_to_write_reference();
+    }
 }
 
 // Put readable asset(s) into storage.
 void LocalDirectoryStorage::put(const Asset& asset)
 {
+    check_writable();
+
     if (asset.id() == AssetId::empty || contains(asset.id()))
     {
         return;
@@ -186,9 +429,7 @@ void LocalDirectoryStorage::put(const Asset& asset)
             }
         }
 
-        boost::shared_ptr<std::ostream> osp = fs::ostream(asset_path);
-
-        boost::filesystem::copy_into(osp, isp);
+        store_object(asset, isp, asset_path);
     }
     else
     {
@@ -198,8 +439,200 @@ void LocalDirectoryStorage::put(const Asset& asset)
     }
 }
 
+AssetId LocalDirectoryStorage::ingest(const Asset& asset)
+{
+    check_writable();
+
+    if (asset.id_calculated())
+    {
+        put(asset);
+        return asset.id();
+    }
+
+    return ingest_object(asset, AssetId::not_calculated);
+}
+
+void LocalDirectoryStorage::put_verified(const Asset& asset)
+{
+    check_writable();
+
+    if (asset.id() == AssetId::empty || contains(asset.id()))
+    {
+        return;
+    }
+
+    ingest_object(asset, asset.id());
+}
+
+AssetId LocalDirectoryStorage::ingest_object(const Asset& asset, const AssetId& expected)
+{
+    boost::shared_ptr<std::istream> isp = asset.istream();
+    if (!isp)
+    {
+        LOGF << "Asset is not readable!" << ELOG;
+
+        throw errors::attempt_to_put_non_readable_asset();
+    }
+
+    if (!fs::exists(tmp_) && !fs::create_directories(tmp_))
+    {
+        LOGF << "Unable to create temporary directory: " << tmp_ << ELOG;
+
+        throw errors::unable_to_create_directory();
+    }
+
+    // 1. Copy data into temporary object and calculate id at the same time.
+    fs::path tmp_path = tmp_ / fs::unique_path();
+
+    AssetId id = store_object(asset, isp, tmp_path);
+
+    if (expected != AssetId::not_calculated && id != expected)
+    {
+        LOGE << "Asset data id: " << id.string() << " doesn't match asset id: " << expected.string() << ELOG;
+
+        fs::remove(tmp_path);
+        throw errors::put_data_id_mismatch();
+    }
+
+    if (contains(id))
+    {
+        LOGT << "Asset: " << id.string() << " already in storage." << ELOG;
+
+        fs::remove(tmp_path);
+        return id;
+    }
+
+    // 2. Move temporary object into place.
+    fs::path asset_path             = layout::asset_path(objects_, id);
+    fs::path asset_parent_path      = asset_path.parent_path();
+
+    LOGT << "Asset path: " << asset_path << " Parent path: " << asset_parent_path << ELOG;
+
+    if (!fs::exists(asset_parent_path) && !fs::create_directories(asset_parent_path))
+    {
+        LOGF << "Unable to create parent directory: " << asset_parent_path << " for the asset: " << id.string() << ELOG;
+
+        fs::remove(tmp_path);
+        throw errors::unable_to_create_directory();
+    }
+
+    fs::rename(tmp_path, asset_path);
+
+    return id;
+}
+
+AssetId LocalDirectoryStorage::store_object(const Asset& asset, const boost::shared_ptr<std::istream>& isp, const fs::path& object_path) const
+{
+    // Archives and media are not compressible, do not spend time on them.
+    ObjectCompression::Method method = compression_;
+    if (method != ObjectCompression::Method_none && ObjectCompression::is_compressed_format(asset.file_path()))
+    {
+        method = ObjectCompression::Method_none;
+    }
+
+    if (chunking_ && asset.size() >= ObjectChunks::min_file_size)
+    {
+        return store_chunks(isp, object_path, method);
+    }
+
+    boost::shared_ptr<std::ostream> osp = fs::ostream(object_path);
+    return ObjectCompression::store(*osp, *isp, method);
+}
+
+AssetId LocalDirectoryStorage::store_chunks(const boost::shared_ptr<std::istream>& isp, const fs::path& object_path, ObjectCompression::Method method) const
+{
+    AssetId::Algorithm algorithm = AssetId::algorithm();
+    ChecksumsDigestBuilder digest_builder(AssetId::algorithm_digest(algorithm));
+    digest_builder.init();
+
+    ObjectChunks::Manifest manifest;
+    boost::uint64_t size = 0;
+
+    // Buffer always holds max chunk size bytes, if the data are not over.
+    std::vector<char> buffer(ObjectChunks::max_size);
+    std::size_t filled = 0;
+    bool more = true;
+    for (;;)
+    {
+        if (more)
+        {
+            std::size_t readed = static_cast<std::size_t>(isp->read(buffer.data() + filled, buffer.size() - filled).gcount());
+            more = !isp->eof() & !isp->fail() & !isp->bad();
+
+            digest_builder.update(buffer.data() + filled, readed);
+            filled += readed;
+        }
+
+        if (!filled)
+        {
+            break;
+        }
+
+        std::size_t chunk_size = ObjectChunks::cut(buffer.data(), filled);
+        manifest.push_back(put_chunk(buffer.data(), chunk_size, method));
+        size += chunk_size;
+
+        std::memmove(buffer.data(), buffer.data() + chunk_size, filled - chunk_size);
+        filled -= chunk_size;
+    }
+
+    if (isp->bad())
+    {
+        throw errors::unable_to_compress_object();
+    }
+
+    ObjectChunks::store_manifest(*fs::ostream(object_path), manifest, size);
+
+    ChecksumsDigestBuilder::Digests digests = digest_builder.finalize<ChecksumsDigestBuilder::Digests>();
+    return AssetId::create(digests[AssetId::algorithm_name(algorithm)].data());
+}
+
+ObjectChunks::Chunk LocalDirectoryStorage::put_chunk(const char *data, std::size_t size, ObjectCompression::Method method) const
+{
+    typedef boost::iostreams::stream<boost::iostreams::array_source> ArrayStream;
+
+    ObjectChunks::Chunk result;
+    result.size = size;
+    {
+        ArrayStream is(data, size);
+        result.id = AssetId::create_for(is);
+    }
+
+    if (contains(result.id))
+    {
+        return result;
+    }
+
+    fs::path chunk_path = object_path(result.id);
+    if (!fs::exists(chunk_path.parent_path()) && !fs::create_directories(chunk_path.parent_path()))
+    {
+        LOGF << "Unable to create parent directory: " << chunk_path.parent_path() << " for the chunk: " << result.id.string() << ELOG;
+
+        throw errors::unable_to_create_directory();
+    }
+
+    if (!fs::exists(tmp_) && !fs::create_directories(tmp_))
+    {
+        LOGF << "Unable to create temporary directory: " << tmp_ << ELOG;
+
+        throw errors::unable_to_create_directory();
+    }
+
+    // Chunk appears in place only when it is completely written.
+    fs::path tmp_path = tmp_ / fs::unique_path();
+    {
+        ArrayStream is(data, size);
+        ObjectCompression::store(*fs::ostream(tmp_path), is, method);
+    }
+    fs::rename(tmp_path, chunk_path);
+
+    return result;
+}
+
 void LocalDirectoryStorage::put(std::set<Asset> assets)
 {
+    check_writable();
+
     typedef std::set<Asset>::const_iterator ConstIter;
     for(ConstIter i = assets.begin(), end = assets.end(); i != end; ++i)
     {
@@ -210,24 +643,39 @@ void LocalDirectoryStorage::put(std::set<Asset> assets)
 
 void LocalDirectoryStorage::create_reference(const refs::Ref& ref)
 {
-    if (!refs_.data().insert(std::make_pair(ref.first, ref.second.string())).second)
+    check_writable();
+
+    if (!refs_.insert(ref).second)
     {
         throw errors::unable_to_insert_new_reference();
     }
-    refs_.store(*fs::ostream(references_).get());
+    write_reference(ref);
+    append_reference_log(ref);
 }
 
 void LocalDirectoryStorage::destroy_reference(const refs::Ref::first_type& ref_name)
 {
-    refs_.data().erase(ref_name);
-    refs_.store(*fs::ostream(references_).get());
+    check_writable();
+
+    refs_.erase(ref_name);
+
+    std::string file_name = layout::ref_file_name(ref_name);
+    fs::remove(refs_dir_ / file_name);
+    fs::remove(logs_dir_ / file_name);
 }
 
 void LocalDirectoryStorage::update_reference(const refs::Ref& ref)
 {
-    std::string prev_value = refs_.data().at(ref.first);
-    refs_.data()[ref.first] = ref.second.string() + constants::C::ref_ids_delimiter + prev_value;
-    refs_.store(*fs::ostream(references_).get());
+    check_writable();
+
+    refs_.at(ref.first) = ref.second;
+    write_reference(ref);
+    append_reference_log(ref);
+}
+
+boost::filesystem::path LocalDirectoryStorage::object_path(const AssetId& id) const
+{
+    return layout::asset_path(objects_, id);
 }
 
 // Check if readable asset available in storage.
@@ -242,7 +690,8 @@ Asset LocalDirectoryStorage::asset(const IObjectsStorage::Ptr& storage, const As
     fs::path asset_path = layout::asset_path(objects_, id);
     if (fs::exists(asset_path))
     {
-        return Asset::create_for(asset_path);
+        // Object file may be compressed, so the data are read through the storage.
+        return Asset::create_for(storage, id);
     }
     else
     {
@@ -259,25 +708,112 @@ boost::shared_ptr<std::istream> LocalDirectoryStorage::istream_for(const AssetId
     fs::path asset_path = layout::asset_path(objects_, id);
     if (fs::exists(asset_path))
     {
-        return result = fs::istream(asset_path);
+        result = fs::istream(asset_path);
+
+        ObjectCompression::Header header;
+        if (read_header(*result, header))
+        {
+            return decoded(result, header);
+        }
+
+        result->clear();
+        result->seekg(0);
     }
 
     return result;
 }
 
-AssetId LocalDirectoryStorage::resolve(const std::string& ref) const
+std::size_t LocalDirectoryStorage::size_of(const AssetId& id) const
 {
-    Properties::MapType::const_iterator i = refs_.data().find(ref);
-    if (i != refs_.data().end())
+    fs::path asset_path = layout::asset_path(objects_, id);
+
+    boost::system::error_code ec;
+    boost::uintmax_t size = fs::file_size(asset_path, ec);
+    if (ec)
     {
-        std::string ref_indexes_list = i->second;
+        return 0;
+    }
 
-        std::vector<std::string> ids;
-        boost::split(ids, ref_indexes_list, boost::is_any_of(constants::C::ref_ids_delimiter));
+    ObjectCompression::Header header;
+    if (size >= ObjectCompression::header_size && read_header(*fs::istream(asset_path), header))
+    {
+        return static_cast<std::size_t>(header.size);
+    }
+
+    return static_cast<std::size_t>(size);
+}
+
+boost::filesystem::path LocalDirectoryStorage::object_file(const AssetId& id) const
+{
+    // Only raw objects can be cloned or linked into the working copy.
+    fs::path asset_path = object_path(id);
+    ObjectCompression::Header header;
+    if (!fs::is_regular_file(asset_path) || read_header(*fs::istream(asset_path), header))
+    {
+        return fs::path();
+    }
+    return asset_path;
+}
+
+void LocalDirectoryStorage::set_compression(ObjectCompression::Method compression)
+{
+    compression_ = compression;
+}
+
+void LocalDirectoryStorage::set_chunking(bool chunking)
+{
+    chunking_ = chunking;
+}
+
+bool LocalDirectoryStorage::object_location(const AssetId& id, ObjectChunks::Location& location) const
+{
+    fs::path asset_path = object_path(id);
+
+    boost::system::error_code ec;
+    boost::uintmax_t length = fs::file_size(asset_path, ec);
+    if (ec)
+    {
+        return false;
+    }
+
+    location.file   = asset_path;
+    location.offset = 0;
+    location.length = length;
+    return true;
+}
+
+boost::shared_ptr<std::istream> LocalDirectoryStorage::decoded(const boost::shared_ptr<std::istream>& object, const ObjectCompression::Header& header) const
+{
+    if (header.method != ObjectCompression::Method_chunks)
+    {
+        return ObjectCompression::decoded(object, header);
+    }
+
+    // Chunks are located now, so the data are read without the storage calls.
+    ObjectChunks::Manifest manifest = ObjectChunks::load_manifest(*object);
+    ObjectChunks::Locations locations(manifest.size());
+    for (std::size_t i = 0; i < manifest.size(); ++i)
+    {
+        if (!object_location(manifest[i].id, locations[i]))
+        {
+            LOGE << "Missing object chunk: " << manifest[i].id.string() << ELOG;
 
-        LOGT << "Ref: " << ref << " resolved to id: " << ids[0] << ELOG;
+            throw errors::missing_object_chunk();
+        }
+        locations[i].size = manifest[i].size;
+    }
 
-        return AssetId::create(ids[0]);
+    return ObjectChunks::assemble(locations);
+}
+
+AssetId LocalDirectoryStorage::resolve(const std::string& ref) const
+{
+    References::const_iterator i = refs_.find(ref);
+    if (i != refs_.end())
+    {
+        LOGT << "Ref: " << ref << " resolved to id: " << i->second.string() << ELOG;
+
+        return i->second;
     }
     else if (ref.length() == AssetId::str_digest_len)
     {
@@ -303,11 +839,29 @@ AssetId LocalDirectoryStorage::resolve(const std::string& ref) const
 std::set<refs::Ref> LocalDirectoryStorage::references() const
 {
     std::set<refs::Ref> result;
-    for(Properties::MapType::const_iterator i = refs_.data().begin(), end = refs_.data().end(); i != end; ++i)
+    for(References::const_iterator i = refs_.begin(), end = refs_.end(); i != end; ++i)
     {
         result.insert(*i);
     }
     return result;
 }
 
+std::vector<AssetId> LocalDirectoryStorage::reference_log(const std::string& ref_name) const
+{
+    std::vector<AssetId> result;
+
+    std::ifstream is((logs_dir_ / layout::ref_file_name(ref_name)).c_str());
+    std::string line;
+    while (std::getline(is, line))
+    {
+        if (line.length() == AssetId::str_digest_len)
+        {
+            result.push_back(AssetId::create(line));
+        }
+    }
+
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
 } } // namespace piel::lib
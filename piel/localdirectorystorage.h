@@ -31,23 +31,33 @@
 
 #include <boost_filesystem_ext.hpp>
 #include <iobjectsstorage.h>
+#include <objectchunks.h>
+#include <objectcompression.h>
 #include <properties.h>
 
+#include <map>
+
 namespace piel { namespace lib {
 
 namespace errors {
     struct unable_to_create_directory {};
+    struct unable_to_write_reference {};
+    struct attempt_to_modify_read_only_storage {};
 }
 
 class LocalDirectoryStorage : public IObjectsStorage
 {
 public:
-    LocalDirectoryStorage(const boost::filesystem::path& root_dir);
+    //! \param read_only Open existing storage without any modifications: the layout is not
+    //!  initialized, legacy references are not converted, puts and references changes throw.
+    LocalDirectoryStorage(const boost::filesystem::path& root_dir, bool read_only = false);
     virtual ~LocalDirectoryStorage();
 
     // Put readable asset(s) into storage.
     void put(const Asset& asset);
     void put(std::set<Asset> assets);
+    AssetId ingest(const Asset& asset);
+    void put_verified(const Asset& asset);
     void create_reference(const refs::Ref& ref);
     void destroy_reference(const refs::Ref::first_type& ref_name);
     void update_reference(const refs::Ref& ref);
@@ -61,19 +71,68 @@ public:
     // Get input stream for reading asset data. Low level API used by Asset implementation.
     //External code must use get().istream() call sequense.
     boost::shared_ptr<std::istream> istream_for(const AssetId& id) const;
+    std::size_t size_of(const AssetId& id) const;
+    boost::filesystem::path object_file(const AssetId& id) const;
 
     AssetId resolve(const std::string& ref) const;
     std::set<refs::Ref> references() const;
+    std::vector<AssetId> reference_log(const std::string& ref_name) const;
+
+    //! Compression of the new objects. Objects are readable whatever method they were stored with.
+    void set_compression(ObjectCompression::Method compression);
+    //! Split the new large objects into the content defined chunks.
+    void set_chunking(bool chunking);
+
+    bool read_only() const;
 
 protected:
+    typedef std::map<refs::Ref::first_type, AssetId> References;
+
     void init();
     void attach();
 
-private:
+    // Convert legacy references.properties into the reference files and logs.
+    void migrate_references();
+    // Load legacy references.properties without conversion.
+    void load_legacy_references();
+    // Throw if storage is opened in read only mode.
+    void check_writable() const;
+    // Replace the reference file content with given id.
+    void write_reference(const refs::Ref& ref) const;
+    // Append id to the reference log.
+    void append_reference_log(const refs::Ref& ref) const;
+
+    // Store asset data into temporary object and move it into place. If expected id is
+    // calculated and the data id differs, temporary object is removed and put_data_id_mismatch is thrown.
+    AssetId ingest_object(const Asset& asset, const AssetId& expected);
+
+    // Path of the loose object file for given id.
+    boost::filesystem::path object_path(const AssetId& id) const;
+
+    // Write asset data into the object file. Returns asset data id.
+    AssetId store_object(const Asset& asset, const boost::shared_ptr<std::istream>& isp, const boost::filesystem::path& object_path) const;
+    // Store data chunks and write the chunks manifest into the object file. Returns asset data id.
+    AssetId store_chunks(const boost::shared_ptr<std::istream>& isp, const boost::filesystem::path& object_path, ObjectCompression::Method method) const;
+    // Store chunk object if it is not in storage yet.
+    ObjectChunks::Chunk put_chunk(const char *data, std::size_t size, ObjectCompression::Method method) const;
+
+    // Location of the object data. Used to read chunks without storage calls.
+    virtual bool object_location(const AssetId& id, ObjectChunks::Location& location) const;
+
+    // Stream of the object data after the object header.
+    boost::shared_ptr<std::istream> decoded(const boost::shared_ptr<std::istream>& object, const ObjectCompression::Header& header) const;
+
+protected:
     boost::filesystem::path root_dir_;
     boost::filesystem::path objects_;
     boost::filesystem::path references_;
-    Properties refs_;
+    boost::filesystem::path refs_dir_;
+    boost::filesystem::path logs_dir_;
+    boost::filesystem::path tmp_;
+    References refs_;
+    ObjectCompression::Method compression_;
+    bool chunking_;
+    bool read_only_;
 };
 
 } } // namespace piel::lib
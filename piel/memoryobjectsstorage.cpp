@@ -27,20 +27,12 @@
  */
 
 #include <memoryobjectsstorage.h>
+#include <boost_filesystem_ext.hpp>
 
 #include <boost/interprocess/streams/vectorstream.hpp>
-#include <boost/algorithm/string.hpp>
 
 namespace piel { namespace lib {
 
-namespace constants {
-    struct C {
-        static const std::string ref_ids_delimiter;
-    };
-
-    /*static*/ const std::string C::ref_ids_delimiter = ",";
-};
-
 typedef boost::interprocess::basic_ivectorstream<MemoryObjectsStorage::Object> ivectorstream;
 typedef boost::interprocess::basic_ovectorstream<MemoryObjectsStorage::Object> ovectorstream;
 
@@ -77,6 +69,32 @@ void MemoryObjectsStorage::put(const Asset& asset)
     }
 }
 
+AssetId MemoryObjectsStorage::ingest(const Asset& asset)
+{
+    if (asset.id_calculated())
+    {
+        put(asset);
+        return asset.id();
+    }
+
+    boost::shared_ptr<std::istream> asset_istream = asset.istream();
+    if (!asset_istream)
+    {
+        throw errors::attempt_to_put_non_readable_asset();
+    }
+
+    ovectorstream *os = new ovectorstream();
+    boost::shared_ptr<std::ostream> osp(os);
+
+    AssetId id = boost::filesystem::copy_into(osp, asset_istream);
+    if (!contains(id))
+    {
+        assets_.insert(std::make_pair(id, os->vector()));
+    }
+
+    return id;
+}
+
 void MemoryObjectsStorage::put(std::set<Asset> assets)
 {
     for(std::set<Asset>::const_iterator i = assets.begin(), end = assets.end(); i != end; ++i)
@@ -87,7 +105,7 @@ void MemoryObjectsStorage::put(std::set<Asset> assets)
 
 void MemoryObjectsStorage::create_reference(const refs::Ref& ref)
 {
-    if (!refs_.insert(std::make_pair(ref.first, ref.second.string())).second)
+    if (!refs_.insert(std::make_pair(ref.first, std::vector<AssetId>(1, ref.second))).second)
     {
         throw errors::unable_to_insert_new_reference();
     }
@@ -100,8 +118,7 @@ void MemoryObjectsStorage::destroy_reference(const refs::Ref::first_type& ref_na
 
 void MemoryObjectsStorage::update_reference(const refs::Ref& ref)
 {
-    std::string prev_value = refs_.at(ref.first);
-    refs_[ref.first] = ref.second.string() + constants::C::ref_ids_delimiter + prev_value;
+    refs_.at(ref.first).push_back(ref.second);
 }
 
 // Check if readable asset available in storage.
@@ -137,16 +154,18 @@ boost::shared_ptr<std::istream> MemoryObjectsStorage::istream_for(const AssetId&
     }
 }
 
+std::size_t MemoryObjectsStorage::size_of(const AssetId& id) const
+{
+    Storage::const_iterator i = assets_.find(id);
+    return i != assets_.end() ? i->second.size() : 0;
+}
+
 AssetId MemoryObjectsStorage::resolve(const std::string& ref) const
 {
-    if (refs_.find(ref) != refs_.end())
+    References::const_iterator i = refs_.find(ref);
+    if (i != refs_.end())
     {
-        std::string ref_indexes_list = refs_.at(ref);
-
-        std::vector<std::string> ids;
-        boost::split(ids, ref_indexes_list, boost::is_any_of(constants::C::ref_ids_delimiter));
-
-        return AssetId::create(ids[0]);
+        return i->second.back();
     }
     else if (ref.length() == AssetId::str_digest_len)
     {
@@ -172,9 +191,19 @@ std::set<refs::Ref> MemoryObjectsStorage::references() const
     std::set<refs::Ref> result;
     for (References::const_iterator i = refs_.begin(), end = refs_.end(); i != end; ++i)
     {
-        result.insert(*i);
+        result.insert(std::make_pair(i->first, i->second.back()));
     }
     return result;
 }
 
+std::vector<AssetId> MemoryObjectsStorage::reference_log(const std::string& ref_name) const
+{
+    References::const_iterator i = refs_.find(ref_name);
+    if (i == refs_.end())
+    {
+        return std::vector<AssetId>();
+    }
+    return std::vector<AssetId>(i->second.rbegin(), i->second.rend());
+}
+
 } } // namespace piel::lib
@@ -32,6 +32,7 @@
 #include <iobjectsstorage.h>
 #include <vector>
 #include <map>
+#include <unordered_map>
 
 namespace piel { namespace lib {
 
@@ -40,8 +41,8 @@ class MemoryObjectsStorage: public IObjectsStorage
 public:
     typedef char                                                    Byte;
     typedef std::vector<Byte>                                       Object;
-    typedef std::map<AssetId,Object>                                Storage;
-    typedef std::map<refs::Ref::first_type,std::string>             References;
+    typedef std::unordered_map<AssetId,Object>                      Storage;
+    typedef std::map<refs::Ref::first_type,std::vector<AssetId> >   References;
 
     MemoryObjectsStorage();
     virtual ~MemoryObjectsStorage();
@@ -49,6 +50,7 @@ public:
     // Put readable asset(s) into storage.
     void put(const Asset& asset);
     void put(std::set<Asset> assets);
+    AssetId ingest(const Asset& asset);
     void create_reference(const refs::Ref& ref);
     void destroy_reference(const refs::Ref::first_type& ref_name);
     void update_reference(const refs::Ref& ref);
@@ -62,9 +64,11 @@ public:
     // Get input stream for reading asset data. Low level API used by Asset implementation.
     //External code must use get().istream() call sequense.
     boost::shared_ptr<std::istream> istream_for(const AssetId& id) const;
+    std::size_t size_of(const AssetId& id) const;
 
     AssetId resolve(const std::string& ref) const;
     std::set<refs::Ref> references() const;
+    std::vector<AssetId> reference_log(const std::string& ref_name) const;
 
 private:
     Storage     assets_;
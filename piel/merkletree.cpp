@@ -0,0 +1,414 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <merkletree.h>
+#include <binaryio.hpp>
+#include <logging.h>
+
+#include <iterator>
+
+namespace piel { namespace lib {
+
+namespace directory_format {
+
+    struct F {
+        static const char       magic[4];
+        static const uint32_t   version;
+        static const uint8_t    entry_file;         //!< File entry.
+        static const uint8_t    entry_directory;    //!< Sub directory entry.
+        static const uint8_t    entry_attributes;   //!< Entry what has only attributes.
+    };
+
+    /*static*/ const char       F::magic[4]         = { 'P', 'D', 'I', 'R' };
+    /*static*/ const uint32_t   F::version          = 1;
+    /*static*/ const uint8_t    F::entry_file       = 0;
+    /*static*/ const uint8_t    F::entry_directory  = 1;
+    /*static*/ const uint8_t    F::entry_attributes = 2;
+
+    struct Entry {
+        Entry()
+            : type(F::entry_attributes)
+            , id(AssetId::empty)
+            , attributes(0)
+        {
+        }
+
+        uint8_t                         type;
+        AssetId                         id;
+        const TreeIndex::Attributes     *attributes;
+    };
+
+    typedef std::map<std::string, Entry>        Directory;
+    typedef std::map<std::string, Directory>    Directories;
+
+    //! Split index path into the directory path and name.
+    void split(const std::string& path, std::string& dir, std::string& name)
+    {
+        std::string::size_type pos = path.rfind('/');
+        if (pos == std::string::npos)
+        {
+            dir     = MerkleTree::root;
+            name    = path;
+        }
+        else
+        {
+            dir     = path.substr(0, pos);
+            name    = path.substr(pos + 1);
+        }
+    }
+
+    std::string join(const std::string& dir, const std::string& name)
+    {
+        return dir.empty() ? name : dir + "/" + name;
+    }
+
+    //! Register directory and all its parents.
+    Directory& directory(Directories& dirs, const std::string& path)
+    {
+        Directories::iterator i = dirs.find(path);
+        if (i != dirs.end())
+        {
+            return i->second;
+        }
+
+        Directory& result = dirs[path];
+        if (path != MerkleTree::root)
+        {
+            std::string parent, name;
+            split(path, parent, name);
+            directory(dirs, parent)[name].type = F::entry_directory;
+        }
+        return result;
+    }
+
+    std::string serialize(const Directory& dir)
+    {
+        std::string result;
+        binaryio::Writer w(result);
+
+        w.bytes(F::magic, sizeof(F::magic));
+        w.u32(F::version);
+        w.varint(dir.size());
+
+        for (Directory::const_iterator i = dir.begin(), end = dir.end(); i != end; ++i)
+        {
+            w.string(i->first);
+            w.u8(i->second.type);
+
+            if (i->second.type != F::entry_attributes)
+            {
+                w.id(i->second.id);
+            }
+
+            if (i->second.attributes)
+            {
+                w.varint(i->second.attributes->size());
+                for (TreeIndex::Attributes::const_iterator j = i->second.attributes->begin(), end2 = i->second.attributes->end(); j != end2; ++j)
+                {
+                    w.string(j->first);
+                    w.string(j->second);
+                }
+            }
+            else
+            {
+                w.varint(0);
+            }
+        }
+
+        return result;
+    }
+
+} // namespace directory_format
+
+/*static*/ const std::string MerkleTree::root = std::string();
+
+/*static*/ void MerkleTree::build(const TreeIndex::Content& content,
+                                  const TreeIndex::ContentAttributes& content_attributes,
+                                  TreeIndex::Content& objects,
+                                  TreeIndex::DirectoryIds& ids)
+{
+    using namespace directory_format;
+
+    objects.clear();
+    ids.clear();
+
+    Directories dirs;
+    directory(dirs, root);
+
+    std::string dir, name;
+    for (TreeIndex::Content::const_iterator i = content.begin(), end = content.end(); i != end; ++i)
+    {
+        split(i->first, dir, name);
+
+        Entry& entry = directory(dirs, dir)[name];
+        entry.type  = F::entry_file;
+        entry.id    = i->second.id();
+    }
+
+    for (TreeIndex::ContentAttributes::const_iterator i = content_attributes.begin(), end = content_attributes.end(); i != end; ++i)
+    {
+        split(i->first, dir, name);
+        directory(dirs, dir)[name].attributes = &i->second;
+    }
+
+    // Sub directories paths are greater than parent path, so reverse order
+    // guarantees what children ids are calculated before parents.
+    for (Directories::reverse_iterator i = dirs.rbegin(), end = dirs.rend(); i != end; ++i)
+    {
+        Asset object = Asset::create_for(serialize(i->second));
+        objects.insert(std::make_pair(i->first, object));
+        ids.insert(std::make_pair(i->first, object.id()));
+
+        if (i->first != root)
+        {
+            split(i->first, dir, name);
+            dirs[dir][name].id = object.id();
+        }
+    }
+}
+
+namespace {
+
+    using directory_format::F;
+
+    //! Stored directory entry.
+    struct StoredEntry {
+        uint8_t                 type;
+        AssetId                 id;
+        TreeIndex::Attributes   attributes;
+    };
+
+    typedef std::map<std::string, StoredEntry> StoredDirectory;
+
+    StoredDirectory read_directory(const IObjectsStorage::Ptr& storage, const std::string& path, const AssetId& id)
+    {
+        boost::shared_ptr<std::istream> is = storage->istream_for(id);
+        if (!is)
+        {
+            LOGF << "Unable to load directory object: " << id.string() << " for: " << path << ELOG;
+
+            throw errors::unable_to_load_directory_object();
+        }
+
+        std::string data((std::istreambuf_iterator<char>(*is)), std::istreambuf_iterator<char>());
+        binaryio::Reader<errors::corrupted_directory_object> r(data.data(), data.size());
+
+        if (std::memcmp(r.bytes(sizeof(F::magic)), F::magic, sizeof(F::magic)) != 0 || r.u32() != F::version)
+        {
+            throw errors::corrupted_directory_object();
+        }
+
+        StoredDirectory result;
+        for (uint64_t i = 0, count = r.varint(); i < count; ++i)
+        {
+            std::string name    = r.string();
+            StoredEntry& entry  = result[name];
+            entry.type          = r.u8();
+
+            if (entry.type == F::entry_file || entry.type == F::entry_directory)
+            {
+                entry.id = r.id();
+            }
+            else if (entry.type != F::entry_attributes)
+            {
+                throw errors::corrupted_directory_object();
+            }
+
+            for (uint64_t j = 0, attrs_count = r.varint(); j < attrs_count; ++j)
+            {
+                std::string attr_name = r.string();
+                entry.attributes.insert(entry.attributes.end(), std::make_pair(attr_name, r.string()));
+            }
+        }
+
+        if (!r.at_end())
+        {
+            throw errors::corrupted_directory_object();
+        }
+
+        return result;
+    }
+
+    //! Put file and attributes of the entry into the content. Sub directories are
+    //!expanded by the caller.
+    void add_entry(const IObjectsStorage::Ptr& storage,
+                   const std::string& path,
+                   const StoredEntry& entry,
+                   TreeIndex::Content& content,
+                   TreeIndex::ContentAttributes& content_attributes)
+    {
+        if (entry.type == F::entry_file)
+        {
+            content.insert(std::make_pair(path, Asset::create_for(storage, entry.id)));
+        }
+
+        if (!entry.attributes.empty())
+        {
+            content_attributes[path] = entry.attributes;
+        }
+    }
+
+    void expand_directory(const IObjectsStorage::Ptr& storage,
+                          const std::string& path,
+                          const AssetId& id,
+                          TreeIndex::Content& content,
+                          TreeIndex::ContentAttributes& content_attributes,
+                          TreeIndex::DirectoryIds& ids)
+    {
+        using directory_format::join;
+
+        StoredDirectory dir = read_directory(storage, path, id);
+
+        ids.insert(std::make_pair(path, id));
+
+        for (StoredDirectory::const_iterator i = dir.begin(), end = dir.end(); i != end; ++i)
+        {
+            std::string entry_path = join(path, i->first);
+
+            if (i->second.type == F::entry_directory)
+            {
+                expand_directory(storage, entry_path, i->second.id, content, content_attributes, ids);
+            }
+
+            add_entry(storage, entry_path, i->second, content, content_attributes);
+        }
+    }
+
+    //! One of the compared trees.
+    struct ExpandedTree {
+        ExpandedTree(const IObjectsStorage::Ptr& s, TreeIndex::Content& c, TreeIndex::ContentAttributes& a)
+            : storage(s)
+            , content(c)
+            , content_attributes(a)
+            , ids()
+        {
+        }
+
+        IObjectsStorage::Ptr            storage;
+        TreeIndex::Content&             content;
+        TreeIndex::ContentAttributes&   content_attributes;
+        TreeIndex::DirectoryIds         ids;
+    };
+
+    //! Expand the directory of both trees. AssetId::empty means what the directory is absent
+    //!in the tree. Directories with equal ids are not read.
+    void expand_changed_directory(const std::string& path,
+                                  const AssetId& first_id, ExpandedTree& first,
+                                  const AssetId& second_id, ExpandedTree& second)
+    {
+        using directory_format::join;
+
+        if (first_id == second_id)
+        {
+            return;
+        }
+
+        if (first_id == AssetId::empty)
+        {
+            expand_directory(second.storage, path, second_id, second.content, second.content_attributes, second.ids);
+            return;
+        }
+
+        if (second_id == AssetId::empty)
+        {
+            expand_directory(first.storage, path, first_id, first.content, first.content_attributes, first.ids);
+            return;
+        }
+
+        StoredDirectory first_dir   = read_directory(first.storage, path, first_id);
+        StoredDirectory second_dir  = read_directory(second.storage, path, second_id);
+
+        for (StoredDirectory::const_iterator i = first_dir.begin(), end = first_dir.end(); i != end; ++i)
+        {
+            std::string entry_path = join(path, i->first);
+
+            if (i->second.type == F::entry_directory)
+            {
+                StoredDirectory::const_iterator other = second_dir.find(i->first);
+                bool other_is_directory = other != second_dir.end() && other->second.type == F::entry_directory;
+
+                expand_changed_directory(entry_path, i->second.id, first,
+                        other_is_directory ? other->second.id : AssetId::empty, second);
+            }
+
+            add_entry(first.storage, entry_path, i->second, first.content, first.content_attributes);
+        }
+
+        for (StoredDirectory::const_iterator i = second_dir.begin(), end = second_dir.end(); i != end; ++i)
+        {
+            std::string entry_path = join(path, i->first);
+
+            if (i->second.type == F::entry_directory)
+            {
+                StoredDirectory::const_iterator other = first_dir.find(i->first);
+                if (other == first_dir.end() || other->second.type != F::entry_directory)
+                {
+                    expand_changed_directory(entry_path, AssetId::empty, first, i->second.id, second);
+                }
+            }
+
+            add_entry(second.storage, entry_path, i->second, second.content, second.content_attributes);
+        }
+    }
+
+} // namespace
+
+/*static*/ void MerkleTree::expand(const IObjectsStorage::Ptr& storage,
+                                   const AssetId& root_id,
+                                   TreeIndex::Content& content,
+                                   TreeIndex::ContentAttributes& content_attributes,
+                                   TreeIndex::DirectoryIds& ids)
+{
+    content.clear();
+    content_attributes.clear();
+    ids.clear();
+
+    expand_directory(storage, root, root_id, content, content_attributes, ids);
+}
+
+/*static*/ void MerkleTree::expand_changed(const IObjectsStorage::Ptr& first_storage,
+                                           const AssetId& first_root,
+                                           TreeIndex::Content& first_content,
+                                           TreeIndex::ContentAttributes& first_content_attributes,
+                                           const IObjectsStorage::Ptr& second_storage,
+                                           const AssetId& second_root,
+                                           TreeIndex::Content& second_content,
+                                           TreeIndex::ContentAttributes& second_content_attributes)
+{
+    first_content.clear();
+    first_content_attributes.clear();
+    second_content.clear();
+    second_content_attributes.clear();
+
+    ExpandedTree first(first_storage, first_content, first_content_attributes);
+    ExpandedTree second(second_storage, second_content, second_content_attributes);
+
+    expand_changed_directory(root, first_root, first, second_root, second);
+}
+
+} } // namespace piel::lib
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PIEL_MERKLETREE_H_
+#define PIEL_MERKLETREE_H_
+
+#include <treeindex.h>
+
+namespace piel { namespace lib {
+
+namespace errors {
+    struct corrupted_directory_object {};
+    struct unable_to_load_directory_object {};
+};
+
+//! Hierarchical representation of the index content. Each directory is stored
+//! as separate content addressed object what contains names, ids and attributes
+//! of its elements (files and sub directories). Unchanged sub trees have the same
+//! ids, so they are shared between indexes and can be skipped on compare.
+//!
+//! Directory paths are index paths without trailing '/'. Root directory path is "".
+class MerkleTree
+{
+public:
+    //! Build directory objects for the index content.
+    //! \param content Index content.
+    //! \param content_attributes Index content attributes.
+    //! \param objects Directory objects (directory path -> object asset).
+    //! \param ids Directory ids (directory path -> object id).
+    static void build(const TreeIndex::Content& content,
+                      const TreeIndex::ContentAttributes& content_attributes,
+                      TreeIndex::Content& objects,
+                      TreeIndex::DirectoryIds& ids);
+
+    //! Expand directory objects into the flat index content.
+    //! \param storage Storage with the directory objects.
+    //! \param root Root directory id.
+    //! \param content Index content.
+    //! \param content_attributes Index content attributes.
+    //! \param ids Directory ids (directory path -> object id).
+    static void expand(const IObjectsStorage::Ptr& storage,
+                       const AssetId& root,
+                       TreeIndex::Content& content,
+                       TreeIndex::ContentAttributes& content_attributes,
+                       TreeIndex::DirectoryIds& ids);
+
+    //! Expand only the sub trees what differ in two trees: sub directories with equal
+    //!ids are not read. Contents have all elements of the changed directories, so the
+    //!equal elements are dropped by the contents compare.
+    static void expand_changed(const IObjectsStorage::Ptr& first_storage,
+                               const AssetId& first_root,
+                               TreeIndex::Content& first_content,
+                               TreeIndex::ContentAttributes& first_content_attributes,
+                               const IObjectsStorage::Ptr& second_storage,
+                               const AssetId& second_root,
+                               TreeIndex::Content& second_content,
+                               TreeIndex::ContentAttributes& second_content_attributes);
+
+    //! Root directory path.
+    static const std::string root;
+};
+
+} } // namespace piel::lib
+
+#endif /* PIEL_MERKLETREE_H_ */
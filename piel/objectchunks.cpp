@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <objectchunks.h>
+#include <objectcompression.h>
+#include <logging.h>
+
+#include <boost/iostreams/stream.hpp>
+#include <boost/iostreams/categories.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+
+namespace piel { namespace lib {
+
+namespace {
+
+    struct F {
+        static const std::size_t    entry_size = AssetId::digest_len + 8;  //!< Manifest entry: binary id, size.
+        static const std::size_t    read_ahead;     //!< Count of the chunks read ahead.
+        static const boost::uint64_t mask_s;        //!< Mask used before the expected chunk size.
+        static const boost::uint64_t mask_l;        //!< Mask used after the expected chunk size.
+    };
+
+    /*static*/ const std::size_t    F::entry_size;
+    /*static*/ const std::size_t    F::read_ahead   = 4;
+    // Normalized chunking: 2 bits more than log2(avg_size) before and 2 bits less after
+    //the expected size. Hash high bits depend on the last 64 bytes, so the masks use them.
+    /*static*/ const boost::uint64_t F::mask_s      = ~boost::uint64_t(0) << (64 - 22);
+    /*static*/ const boost::uint64_t F::mask_l      = ~boost::uint64_t(0) << (64 - 18);
+
+    //! Gear hash table. Generated by splitmix64 from the fixed seed: chunk boundaries
+    //!must not change between the versions.
+    struct GearTable {
+        boost::uint64_t values[256];
+
+        GearTable()
+        {
+            boost::uint64_t state = 0x7069652d63686e6bULL;
+            for (std::size_t i = 0; i < 256; ++i)
+            {
+                boost::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+                values[i] = z ^ (z >> 31);
+            }
+        }
+    };
+
+    const GearTable gear;
+
+    void write_u64(std::ostream& os, boost::uint64_t value)
+    {
+        char data[8];
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+            data[i] = static_cast<char>(value >> (i * 8));
+        }
+        os.write(data, sizeof(data));
+    }
+
+    boost::uint64_t read_u64(const char *data)
+    {
+        boost::uint64_t result = 0;
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+            result |= boost::uint64_t(static_cast<unsigned char>(data[i])) << (i * 8);
+        }
+        return result;
+    }
+
+    //! Ask the kernel to read object data in background.
+    void read_ahead(const ObjectChunks::Location& location)
+    {
+#if defined(POSIX_FADV_WILLNEED)
+        int fd = ::open(location.file.c_str(), O_RDONLY);
+        if (fd >= 0)
+        {
+            ::posix_fadvise(fd, static_cast<off_t>(location.offset), static_cast<off_t>(location.length), POSIX_FADV_WILLNEED);
+            ::close(fd);
+        }
+#endif
+    }
+
+    //! Open chunk object data. Chunks can be compressed.
+    boost::shared_ptr<std::istream> open_chunk(const ObjectChunks::Location& location)
+    {
+        boost::shared_ptr<std::istream> result(new std::ifstream(location.file.c_str(), std::ifstream::in|std::ifstream::binary));
+        result->seekg(static_cast<std::streamoff>(location.offset));
+
+        char data[ObjectCompression::header_size];
+        std::streamsize readed = result->read(data, std::min<boost::uint64_t>(sizeof(data), location.length)).gcount();
+
+        ObjectCompression::Header header;
+        if (ObjectCompression::parse_header(data, static_cast<std::size_t>(readed), header) &&
+                header.method != ObjectCompression::Method_chunks)
+        {
+            return ObjectCompression::decoded(result, header);
+        }
+
+        result->clear();
+        result->seekg(static_cast<std::streamoff>(location.offset));
+        return result;
+    }
+
+    //! Data source used to read chunked objects. Exactly chunk size bytes are read from
+    //!each chunk, so the packed chunks are not read past their end.
+    class ChunksSource
+    {
+    public:
+        typedef char char_type;                                         //!< Stream char_type. See boost::istreams docs for the details.
+        typedef boost::iostreams::source_tag category;                  //!< Stream category. See boost::istreams docs for the details.
+        typedef boost::iostreams::stream<ChunksSource> istream;         //!< Chunked object input stream.
+
+        ChunksSource(const ObjectChunks::Locations& locations)
+            : state_(new State(locations))
+        {
+        }
+
+        std::streamsize read(char* buffer, std::streamsize n)
+        {
+            State& state = *state_;
+            while (!state.chunk || state.remaining == 0)
+            {
+                if (state.next == state.locations.size())
+                {
+                    return -1;
+                }
+
+                // Kernel reads next chunks while the current one is consumed.
+                std::size_t ahead_end = std::min(state.locations.size(), state.next + 1 + F::read_ahead);
+                for (std::size_t i = std::max(state.ahead, state.next + 1); i < ahead_end; ++i)
+                {
+                    read_ahead(state.locations[i]);
+                }
+                state.ahead = std::max(state.ahead, ahead_end);
+
+                state.chunk     = open_chunk(state.locations[state.next]);
+                state.remaining = state.locations[state.next].size;
+                ++state.next;
+            }
+
+            std::streamsize to_read = static_cast<std::streamsize>(std::min<boost::uint64_t>(state.remaining, n));
+            std::streamsize readed = state.chunk->read(buffer, to_read).gcount();
+            if (readed != to_read)
+            {
+                throw errors::missing_object_chunk();
+            }
+
+            state.remaining -= readed;
+            return readed;
+        }
+
+    private:
+        //! Shared state, source is copied by the boost::iostreams::stream.
+        struct State {
+            ObjectChunks::Locations         locations;
+            std::size_t                     next;       //!< Next chunk to open.
+            std::size_t                     ahead;      //!< Chunks before are already read ahead.
+            boost::shared_ptr<std::istream> chunk;      //!< Current chunk.
+            boost::uint64_t                 remaining;  //!< Current chunk remaining data size.
+
+            State(const ObjectChunks::Locations& chunks_locations)
+                : locations(chunks_locations)
+                , next(0)
+                , ahead(0)
+                , chunk()
+                , remaining(0)
+            {
+            }
+        };
+
+        boost::shared_ptr<State> state_;
+    };
+
+} // namespace
+
+/*static*/ const std::size_t ObjectChunks::min_size         = 256 * 1024;
+/*static*/ const std::size_t ObjectChunks::avg_size         = 1024 * 1024;
+/*static*/ const std::size_t ObjectChunks::max_size         = 4 * 1024 * 1024;
+/*static*/ const std::size_t ObjectChunks::min_file_size    = 4 * 1024 * 1024;
+
+/*static*/ bool ObjectChunks::chunking_for(const std::string& name)
+{
+    if (name.empty() || name == "none")
+    {
+        return false;
+    }
+    else if (name == "cdc")
+    {
+        return true;
+    }
+
+    LOGE << "Unknown objects chunking method: " << name << ELOG;
+
+    throw errors::unknown_chunking_method();
+}
+
+/*static*/ std::size_t ObjectChunks::cut(const char *data, std::size_t size)
+{
+    if (size <= min_size)
+    {
+        return size;
+    }
+
+    const unsigned char *bytes = reinterpret_cast<const unsigned char*>(data);
+    std::size_t end     = std::min(size, max_size);
+    std::size_t normal  = std::min(end, avg_size);
+
+    boost::uint64_t hash = 0;
+    std::size_t i = min_size;
+    for (; i < normal; ++i)
+    {
+        hash = (hash << 1) + gear.values[bytes[i]];
+        if (!(hash & F::mask_s))
+        {
+            return i + 1;
+        }
+    }
+    for (; i < end; ++i)
+    {
+        hash = (hash << 1) + gear.values[bytes[i]];
+        if (!(hash & F::mask_l))
+        {
+            return i + 1;
+        }
+    }
+    return end;
+}
+
+/*static*/ void ObjectChunks::store_manifest(std::ostream& os, const Manifest& manifest, boost::uint64_t size)
+{
+    ObjectCompression::write_header(os, ObjectCompression::Method_chunks, size);
+    for (Manifest::const_iterator i = manifest.begin(), end = manifest.end(); i != end; ++i)
+    {
+        os.write(reinterpret_cast<const char*>(i->id.data()), AssetId::digest_len);
+        write_u64(os, i->size);
+    }
+}
+
+/*static*/ ObjectChunks::Manifest ObjectChunks::load_manifest(std::istream& is)
+{
+    Manifest result;
+
+    char entry[F::entry_size];
+    for (;;)
+    {
+        std::streamsize readed = is.read(entry, sizeof(entry)).gcount();
+        if (readed == 0)
+        {
+            break;
+        }
+        else if (readed != static_cast<std::streamsize>(sizeof(entry)))
+        {
+            throw errors::corrupted_chunks_manifest();
+        }
+
+        Chunk chunk;
+        chunk.id    = AssetId::create(reinterpret_cast<const unsigned char*>(entry));
+        chunk.size  = read_u64(entry + AssetId::digest_len);
+        result.push_back(chunk);
+    }
+
+    return result;
+}
+
+/*static*/ boost::shared_ptr<std::istream> ObjectChunks::assemble(const Locations& locations)
+{
+    return boost::shared_ptr<std::istream>(new ChunksSource::istream(ChunksSource(locations)));
+}
+
+} } // namespace piel::lib
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PIEL_OBJECTCHUNKS_H_
+#define PIEL_OBJECTCHUNKS_H_
+
+#include <assetid.h>
+
+#include <boost/cstdint.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace piel { namespace lib {
+
+namespace errors {
+    struct unknown_chunking_method {};
+    struct corrupted_chunks_manifest {};
+    struct missing_object_chunk {};
+};
+
+//! Chunked storage objects.
+//!
+//! Large files are split by the content defined chunker (FastCDC), so the chunk boundaries
+//!move together with the data and unchanged parts of the modified file produce the same
+//!chunks. Chunks are stored as separate objects, file object is the manifest: list of
+//!the chunks ids and sizes after the ObjectCompression header (Method_chunks).
+struct ObjectChunks {
+    static const std::size_t min_size;          //!< Minimal chunk size.
+    static const std::size_t avg_size;          //!< Expected chunk size.
+    static const std::size_t max_size;          //!< Maximal chunk size.
+    static const std::size_t min_file_size;     //!< Smaller files are stored as the single objects.
+
+    //! Manifest item.
+    struct Chunk {
+        AssetId         id;
+        boost::uint64_t size;   //!< Chunk data size.
+    };
+    typedef std::vector<Chunk> Manifest;
+
+    //! Chunk object data location. Storage resolves the chunks locations before reading,
+    //!so chunks are read without the storage calls.
+    struct Location {
+        boost::filesystem::path file;   //!< Loose object or pack file.
+        boost::uint64_t         offset; //!< Object data offset in the file.
+        boost::uint64_t         length; //!< Object data length in the file.
+        boost::uint64_t         size;   //!< Chunk data size.
+    };
+    typedef std::vector<Location> Locations;
+
+    //! Check chunking method config value: none (or empty) or cdc. Throws errors::unknown_chunking_method.
+    //! \return true if files must be chunked.
+    static bool chunking_for(const std::string& name);
+
+    //! Find chunk boundary.
+    //! \param data Data to chunk.
+    //! \param size Data size. Data end is a chunk end as well.
+    //! \return First chunk size.
+    static std::size_t cut(const char *data, std::size_t size);
+
+    //! Store manifest object.
+    //! \param size Raw data size.
+    static void store_manifest(std::ostream& os, const Manifest& manifest, boost::uint64_t size);
+
+    //! Load manifest. Throws errors::corrupted_chunks_manifest.
+    //! \param is Manifest object stream positioned after the header.
+    static Manifest load_manifest(std::istream& is);
+
+    //! Stream of the chunks data. Next chunks are read ahead while the current one is read.
+    static boost::shared_ptr<std::istream> assemble(const Locations& locations);
+};
+
+} } // namespace piel::lib
+
+#endif /* PIEL_OBJECTCHUNKS_H_ */
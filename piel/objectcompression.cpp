@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <objectcompression.h>
+#include <checksumsdigestbuilder.hpp>
+#include <commonconstants.h>
+#include <logging.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <boost/iostreams/categories.hpp>
+#include <boost/scoped_ptr.hpp>
+
+#include <zlib.h>
+
+#include <cstring>
+#include <set>
+#include <vector>
+
+namespace piel { namespace lib {
+
+namespace {
+
+    struct F {
+        static const char           magic[4];
+        static const std::size_t    size_offset;
+        static const double         probe_ratio;        //!< Max compressed/raw ratio of the first block.
+        static const std::size_t    zlib_buffer_size;
+    };
+
+    /*static*/ const char           F::magic[4]         = { 'P', 'Z', 'O', 'B' };
+    /*static*/ const std::size_t    F::size_offset      = 8;
+    /*static*/ const double         F::probe_ratio      = 0.9;
+    /*static*/ const std::size_t    F::zlib_buffer_size = 64 * 1024;
+
+    //! Deflate stream wrapper.
+    class Deflater
+    {
+    public:
+        Deflater()
+            : stream_()
+            , finished_(false)
+        {
+            if (deflateInit(&stream_, Z_DEFAULT_COMPRESSION) != Z_OK)
+            {
+                throw errors::unable_to_compress_object();
+            }
+        }
+
+        ~Deflater()
+        {
+            deflateEnd(&stream_);
+        }
+
+        bool finished() const
+        {
+            return finished_;
+        }
+
+        //! Deflate data block.
+        //! \param data Data block.
+        //! \param size Data block size.
+        //! \param finish true for the last block.
+        //! \param out Compressed data are appended to.
+        void deflate(const char *data, std::size_t size, bool finish, std::vector<char>& out)
+        {
+            stream_.next_in     = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+            stream_.avail_in    = static_cast<uInt>(size);
+
+            int ret;
+            do {
+                std::size_t pos = out.size();
+                out.resize(pos + F::zlib_buffer_size);
+
+                stream_.next_out    = reinterpret_cast<Bytef*>(out.data() + pos);
+                stream_.avail_out   = static_cast<uInt>(F::zlib_buffer_size);
+
+                ret = ::deflate(&stream_, finish ? Z_FINISH : Z_NO_FLUSH);
+                if (ret == Z_STREAM_ERROR)
+                {
+                    throw errors::unable_to_compress_object();
+                }
+
+                out.resize(out.size() - stream_.avail_out);
+            } while (stream_.avail_out == 0);
+
+            finished_ = finish && ret == Z_STREAM_END;
+        }
+
+    private:
+        Deflater(const Deflater&);
+        void operator=(const Deflater&);
+
+        z_stream    stream_;
+        bool        finished_;
+    };
+
+    //! Data source used to read the zlib compressed objects.
+    class InflateSource
+    {
+    public:
+        typedef char char_type;                                         //!< Stream char_type. See boost::istreams docs for the details.
+        typedef boost::iostreams::source_tag category;                  //!< Stream category. See boost::istreams docs for the details.
+        typedef boost::iostreams::stream<InflateSource> istream;        //!< Decompressed object input stream.
+
+        InflateSource(const boost::shared_ptr<std::istream>& object)
+            : state_(new State(object))
+        {
+        }
+
+        std::streamsize read(char* buffer, std::streamsize n)
+        {
+            z_stream& stream = state_->stream;
+            if (state_->finished)
+            {
+                return -1;
+            }
+
+            stream.next_out     = reinterpret_cast<Bytef*>(buffer);
+            stream.avail_out    = static_cast<uInt>(n);
+
+            while (stream.avail_out > 0)
+            {
+                if (stream.avail_in == 0)
+                {
+                    std::streamsize readed = state_->object->read(state_->input.data(), state_->input.size()).gcount();
+                    if (readed <= 0)
+                    {
+                        throw errors::corrupted_compressed_object();
+                    }
+                    stream.next_in  = reinterpret_cast<Bytef*>(state_->input.data());
+                    stream.avail_in = static_cast<uInt>(readed);
+                }
+
+                int ret = inflate(&stream, Z_NO_FLUSH);
+                if (ret == Z_STREAM_END)
+                {
+                    state_->finished = true;
+                    break;
+                }
+                else if (ret != Z_OK)
+                {
+                    throw errors::corrupted_compressed_object();
+                }
+            }
+
+            std::streamsize produced = n - static_cast<std::streamsize>(stream.avail_out);
+            return produced ? produced : -1;
+        }
+
+    private:
+        //! Shared state, source is copied by the boost::iostreams::stream.
+        struct State {
+            boost::shared_ptr<std::istream> object;
+            std::vector<char>               input;
+            z_stream                        stream;
+            bool                            finished;
+
+            State(const boost::shared_ptr<std::istream>& object_stream)
+                : object(object_stream)
+                , input(F::zlib_buffer_size)
+                , stream()
+                , finished(false)
+            {
+                if (inflateInit(&stream) != Z_OK)
+                {
+                    throw errors::corrupted_compressed_object();
+                }
+            }
+
+            ~State()
+            {
+                inflateEnd(&stream);
+            }
+        };
+
+        boost::shared_ptr<State> state_;
+    };
+
+} // namespace
+
+const std::size_t ObjectCompression::header_size;
+
+/*static*/ ObjectCompression::Method ObjectCompression::method_for(const std::string& name)
+{
+    if (name.empty() || name == "none")
+    {
+        return Method_none;
+    }
+    else if (name == "zlib")
+    {
+        return Method_zlib;
+    }
+
+    LOGE << "Unknown objects compression method: " << name << ELOG;
+
+    throw errors::unknown_compression_method();
+}
+
+/*static*/ bool ObjectCompression::is_compressed_format(const boost::filesystem::path& path)
+{
+    static const char *extensions[] = {
+        ".zip", ".jar", ".war", ".apk", ".gz", ".tgz", ".bz2", ".xz", ".zst", ".7z", ".rar",
+        ".jpg", ".jpeg", ".png", ".gif", ".webp", ".mp3", ".mp4", ".mkv", ".avi", ".mov",
+    };
+    static const std::set<std::string> compressed(extensions, extensions + sizeof(extensions) / sizeof(extensions[0]));
+
+    return compressed.count(boost::algorithm::to_lower_copy(path.extension().string())) != 0;
+}
+
+/*static*/ void ObjectCompression::write_header(std::ostream& os, Method method, boost::uint64_t size)
+{
+    char header[header_size] = { 0 };
+    std::memcpy(header, F::magic, sizeof(F::magic));
+    header[sizeof(F::magic)] = static_cast<char>(method);
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        header[F::size_offset + i] = static_cast<char>(size >> (i * 8));
+    }
+    os.write(header, sizeof(header));
+}
+
+/*static*/ bool ObjectCompression::parse_header(const char *data, std::size_t size, Header& header)
+{
+    if (size < header_size || std::memcmp(data, F::magic, sizeof(F::magic)) != 0)
+    {
+        return false;
+    }
+
+    unsigned char method = static_cast<unsigned char>(data[sizeof(F::magic)]);
+    if (method != Method_none && method != Method_zlib && method != Method_chunks)
+    {
+        return false;
+    }
+
+    header.method   = static_cast<Method>(method);
+    header.size     = 0;
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        header.size |= boost::uint64_t(static_cast<unsigned char>(data[F::size_offset + i])) << (i * 8);
+    }
+    return true;
+}
+
+/*static*/ AssetId ObjectCompression::store(std::ostream& os, std::istream& is, Method method)
+{
+    AssetId::Algorithm algorithm = AssetId::algorithm();
+    ChecksumsDigestBuilder digest_builder(AssetId::algorithm_digest(algorithm));
+    digest_builder.init();
+
+    std::streampos start = os.tellp();
+    std::vector<char> buffer(CommonConstants::io_buffer_size);
+    std::vector<char> compressed;
+
+    // Probe the first block: badly compressible data are stored raw.
+    std::size_t readed = static_cast<std::size_t>(is.read(buffer.data(), buffer.size()).gcount());
+    bool more = !is.eof() & !is.fail() & !is.bad();
+    digest_builder.update(buffer.data(), readed);
+
+    boost::scoped_ptr<Deflater> deflater;
+    if (method == Method_zlib && readed)
+    {
+        deflater.reset(new Deflater());
+        deflater->deflate(buffer.data(), readed, !more, compressed);
+        if (compressed.size() + header_size >= readed * F::probe_ratio)
+        {
+            method = Method_none;
+        }
+    }
+    else
+    {
+        method = Method_none;
+    }
+
+    bool has_header = method != Method_none || (readed >= sizeof(F::magic) && std::memcmp(buffer.data(), F::magic, sizeof(F::magic)) == 0);
+    if (has_header)
+    {
+        // Size is not known yet, it is written after the data.
+        write_header(os, method, 0);
+    }
+
+    if (method == Method_zlib)
+    {
+        os.write(compressed.data(), compressed.size());
+    }
+    else
+    {
+        os.write(buffer.data(), readed);
+    }
+
+    boost::uint64_t size = readed;
+    while (more)
+    {
+        readed = static_cast<std::size_t>(is.read(buffer.data(), buffer.size()).gcount());
+        more = !is.eof() & !is.fail() & !is.bad();
+
+        digest_builder.update(buffer.data(), readed);
+        size += readed;
+
+        if (method == Method_zlib)
+        {
+            compressed.clear();
+            deflater->deflate(buffer.data(), readed, !more, compressed);
+            os.write(compressed.data(), compressed.size());
+        }
+        else
+        {
+            os.write(buffer.data(), readed);
+        }
+    }
+
+    if (method == Method_zlib && !deflater->finished())
+    {
+        compressed.clear();
+        deflater->deflate(0, 0, true, compressed);
+        os.write(compressed.data(), compressed.size());
+    }
+
+    if (has_header)
+    {
+        std::streampos end = os.tellp();
+        os.seekp(start);
+        write_header(os, method, size);
+        os.seekp(end);
+    }
+
+    if (is.bad() || !os)
+    {
+        throw errors::unable_to_compress_object();
+    }
+
+    ChecksumsDigestBuilder::Digests digests = digest_builder.finalize<ChecksumsDigestBuilder::Digests>();
+    return AssetId::create(digests[AssetId::algorithm_name(algorithm)].data());
+}
+
+/*static*/ boost::shared_ptr<std::istream> ObjectCompression::decoded(const boost::shared_ptr<std::istream>& object, const Header& header)
+{
+    if (header.method == Method_zlib)
+    {
+        return boost::shared_ptr<std::istream>(new InflateSource::istream(InflateSource(object)));
+    }
+    return object;
+}
+
+} } // namespace piel::lib
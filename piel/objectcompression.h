@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PIEL_OBJECTCOMPRESSION_H_
+#define PIEL_OBJECTCOMPRESSION_H_
+
+#include <assetid.h>
+
+#include <boost/cstdint.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <iostream>
+#include <string>
+
+namespace piel { namespace lib {
+
+namespace errors {
+    struct unknown_compression_method {};
+    struct unable_to_compress_object {};
+    struct corrupted_compressed_object {};
+};
+
+//! Storage objects encoding.
+//!
+//! Objects are stored either as the raw data (all objects stored before the compression
+//! support), or as the header followed by the object data. Header holds the encoding
+//! method and the raw data size. Raw data what starts with the header magic is stored
+//! with the header too, so the raw objects are never misinterpreted.
+struct ObjectCompression {
+    //! Object encoding methods.
+    enum Method {
+        Method_none = 0,    //!< Raw data (after the header if it is present).
+        Method_zlib = 1,    //!< zlib stream.
+        Method_chunks = 2,  //!< Chunks manifest (see ObjectChunks).
+    };
+
+    //! Object header.
+    struct Header {
+        Method          method;
+        boost::uint64_t size;   //!< Raw data size.
+    };
+
+    static const std::size_t header_size = 16;   //!< Object header size.
+
+    //! Method by the config value: none (or empty) or zlib. Throws errors::unknown_compression_method.
+    static Method method_for(const std::string& name);
+
+    //! Check if file content is already compressed (archives, media). Such files are
+    //!stored without compression attempts.
+    static bool is_compressed_format(const boost::filesystem::path& path);
+
+    //! Parse object header.
+    //! \param data Object data begin.
+    //! \param size Available data size.
+    //! \param header Parse result.
+    //! \return false for the raw objects.
+    static bool parse_header(const char *data, std::size_t size, Header& header);
+
+    //! Write object header.
+    static void write_header(std::ostream& os, Method method, boost::uint64_t size);
+
+    //! Copy data into the object stream and calculate the data id at the same time.
+    //! First data block is probed: if it is badly compressible the object is stored raw.
+    //! \param os Seekable object output stream.
+    //! \param is Data.
+    //! \param method Compression method.
+    //! \return Id of the raw data.
+    static AssetId store(std::ostream& os, std::istream& is, Method method);
+
+    //! Stream of the raw object data. Chunks manifests are decoded by the storage.
+    //! \param object Object stream positioned after the header.
+    //! \param header Object header.
+    static boost::shared_ptr<std::istream> decoded(const boost::shared_ptr<std::istream>& object, const Header& header);
+};
+
+} } // namespace piel::lib
+
+#endif /* PIEL_OBJECTCOMPRESSION_H_ */
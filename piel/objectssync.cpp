@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <objectssync.h>
+#include <remoteobjectsstorage.h>
+#include <logging.h>
+
+namespace piel { namespace lib {
+
+namespace {
+
+    void copy_object(const Asset& asset, const IObjectsStorage::Ptr& to, bool verify)
+    {
+        if (!verify)
+        {
+            to->put(asset);
+            return;
+        }
+
+        try
+        {
+            to->put_verified(asset);
+        }
+        catch (const errors::put_data_id_mismatch&)
+        {
+            LOGE << "Received object data doesn't match id: " << asset.id().string() << ELOG;
+
+            throw errors::remote_storage_error("Corrupted object: " + asset.id().string());
+        }
+    }
+
+} // namespace
+
+/*static*/ std::set<AssetId> ObjectsSync::ids_of(const TreeIndex::Ptr& index)
+{
+    std::set<AssetId> result;
+
+    std::set<Asset> assets = index->assets();
+    for (std::set<Asset>::const_iterator i = assets.begin(), end = assets.end(); i != end; ++i)
+    {
+        result.insert(i->id());
+    }
+
+    return result;
+}
+
+/*static*/ std::size_t ObjectsSync::transfer(const TreeIndex::Ptr& index, const IObjectsStorage::Ptr& to,
+        const std::set<AssetId>& haves, bool verify)
+{
+    std::size_t copied = 0;
+
+    if (haves.find(index->id()) != haves.end() || to->contains(index->id()))
+    {
+        return copied;
+    }
+
+    std::set<Asset> assets = index->assets();
+    for (std::set<Asset>::const_iterator i = assets.begin(), end = assets.end(); i != end; ++i)
+    {
+        if (i->id() == index->id() || haves.find(i->id()) != haves.end() || to->contains(i->id()))
+        {
+            continue;
+        }
+
+        LOGT << "Copy object: " << i->id().string() << ELOG;
+
+        copy_object(*i, to, verify);
+        ++copied;
+    }
+
+    copy_object(index->self(), to, verify);
+    return ++copied;
+}
+
+/*static*/ std::size_t ObjectsSync::push(const IObjectsStorage::Ptr& local, const IObjectsStorage::Ptr& remote, const std::string& ref)
+{
+    return sync(local, remote, ref, local, false);
+}
+
+/*static*/ std::size_t ObjectsSync::pull(const IObjectsStorage::Ptr& remote, const IObjectsStorage::Ptr& local, const std::string& ref)
+{
+    // Local objects checks are cheap, remote tree is not downloaded for them.
+    return sync(remote, local, ref, IObjectsStorage::Ptr(), true);
+}
+
+/*static*/ std::size_t ObjectsSync::sync(const IObjectsStorage::Ptr& from, const IObjectsStorage::Ptr& to,
+        const std::string& ref, const IObjectsStorage::Ptr& known, bool verify)
+{
+    AssetId id = from->resolve(ref);
+    if (id == AssetId::empty)
+    {
+        LOGE << "Unknown reference: " << ref << ELOG;
+
+        throw errors::unknown_sync_reference();
+    }
+
+    AssetId to_id = to->resolve(ref);
+    if (to_id == id)
+    {
+        LOGD << "Reference: " << ref << " is up to date." << ELOG;
+        return 0;
+    }
+
+    // Objects of the destination reference tree what is available locally are not checked.
+    std::set<AssetId> haves;
+    if (known && to_id != AssetId::empty && known->contains(to_id))
+    {
+        haves = ids_of(TreeIndex::load(known->asset(known, to_id), known));
+    }
+
+    TreeIndex::Ptr index = TreeIndex::load(from->asset(from, id), from);
+    std::size_t copied = transfer(index, to, haves, verify);
+
+    LOGD << "Reference: " << ref << " copied objects: " << copied << ELOG;
+
+    if (to_id == AssetId::empty)
+    {
+        to->create_reference(refs::Ref(ref, id));
+    }
+    else
+    {
+        to->update_reference(refs::Ref(ref, id));
+    }
+
+    return copied;
+}
+
+} } // namespace piel::lib
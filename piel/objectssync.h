@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PIEL_OBJECTSSYNC_H_
+#define PIEL_OBJECTSSYNC_H_
+
+#include <treeindex.h>
+
+namespace piel { namespace lib {
+
+namespace errors {
+    struct unknown_sync_reference {};
+}
+
+//! Object level trees transfer between the local and remote storages.
+//!
+//! Only the objects missing in the destination storage are copied. On push the remote
+//!reference is resolved first: if its tree is available locally, all objects of that tree
+//!are known to be on the remote and are not checked. So the transfer cost is proportional
+//!to the changes since the previous push or pull.
+struct ObjectsSync
+{
+    //! Ids of the all tree objects: content, directories and the index itself.
+    static std::set<AssetId> ids_of(const TreeIndex::Ptr& index);
+
+    //! Copy tree objects missing in the destination storage. Index object is copied the
+    //!last, so the destination never has index without the content.
+    //! \param haves Ids what are known to be in the destination storage.
+    //! \param verify Check objects data against their ids, for the untrusted sources.
+    //! \return Number of the copied objects.
+    static std::size_t transfer(const TreeIndex::Ptr& index, const IObjectsStorage::Ptr& to,
+            const std::set<AssetId>& haves = std::set<AssetId>(), bool verify = false);
+
+    //! Send local reference tree to the remote storage and set the remote reference.
+    //! \return Number of the uploaded objects.
+    static std::size_t push(const IObjectsStorage::Ptr& local, const IObjectsStorage::Ptr& remote, const std::string& ref);
+
+    //! Fetch remote reference tree into the local storage and set the local reference.
+    //!Objects what data doesn't match their ids are not stored, remote_storage_error is thrown.
+    //! \return Number of the downloaded objects.
+    static std::size_t pull(const IObjectsStorage::Ptr& remote, const IObjectsStorage::Ptr& local, const std::string& ref);
+
+private:
+    //! Copy reference tree and create or update the destination reference.
+    //! \param known Storage to load the destination reference tree from, if any. Objects
+    //!        of the tree are not checked in the destination.
+    //! \param verify Check objects data against their ids.
+    static std::size_t sync(const IObjectsStorage::Ptr& from, const IObjectsStorage::Ptr& to,
+            const std::string& ref, const IObjectsStorage::Ptr& known, bool verify);
+};
+
+} } // namespace piel::lib
+
+#endif /* PIEL_OBJECTSSYNC_H_ */
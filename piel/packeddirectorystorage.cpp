@@ -0,0 +1,680 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <packeddirectorystorage.h>
+#include <logging.h>
+
+#include <boost/format.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <boost/iostreams/categories.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+namespace piel { namespace lib {
+
+namespace fs = boost::filesystem;
+namespace bip = boost::interprocess;
+
+namespace packed_layout {
+
+    struct L {
+        static const std::string packs;
+        static const std::string index;
+        static const std::string index_tmp;
+        static const std::string pack_name_format;
+    };
+
+    /*static*/ const std::string L::packs              = "packs";
+    /*static*/ const std::string L::index              = "packs.idx";
+    /*static*/ const std::string L::index_tmp          = "packs.idx.tmp";
+    /*static*/ const std::string L::pack_name_format   = "pack-%1$08u.pack";
+
+    //! Packs index format. All values are stored in the host byte order.
+    //!
+    //!  header: magic[4] version(u32) count(u64) packs(u32) reserved(u32)
+    //!  entry:  id[32] pack(u32) offset(u64) length(u64), sorted by id.
+    struct F {
+        static const char           magic[4];
+        static const unsigned int   version;
+        static const std::size_t    id_size;
+        static const std::size_t    header_size;
+        static const std::size_t    entry_size;
+    };
+
+    /*static*/ const char           F::magic[4]     = { 'P', 'I', 'D', 'X' };
+    /*static*/ const unsigned int   F::version      = 1;
+    /*static*/ const std::size_t    F::id_size      = AssetId::digest_len;
+    /*static*/ const std::size_t    F::header_size  = 4 + 4 + 8 + 4 + 4;
+    /*static*/ const std::size_t    F::entry_size   = 32 + 4 + 8 + 8;
+
+    typedef std::vector<unsigned char> Key;
+
+    //! Index key for the asset id. Empty key for ids which can't be packed.
+    Key key_for(const AssetId& id)
+    {
+        if (!id.has_digest())
+        {
+            return Key();
+        }
+
+        return Key(id.data(), id.data() + F::id_size);
+    }
+
+    struct Entry {
+        Key                                 key;
+        PackedDirectoryStorage::Location    location;
+
+        bool operator<(const Entry& src) const
+        {
+            return key < src.key;
+        }
+    };
+
+    template<typename T>
+    T read_value(const char *data)
+    {
+        T result;
+        std::memcpy(&result, data, sizeof(T));
+        return result;
+    }
+
+    template<typename T>
+    void write_value(std::ostream& os, T value)
+    {
+        os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    Entry read_entry(const char *data)
+    {
+        Entry result;
+        result.key.assign(data, data + F::id_size);
+        data += F::id_size;
+        result.location.pack   = read_value<boost::uint32_t>(data); data += 4;
+        result.location.offset = read_value<boost::uint64_t>(data); data += 8;
+        result.location.length = read_value<boost::uint64_t>(data);
+        return result;
+    }
+
+    void write_entry(std::ostream& os, const Entry& entry)
+    {
+        os.write(reinterpret_cast<const char*>(entry.key.data()), F::id_size);
+        write_value<boost::uint32_t>(os, entry.location.pack);
+        write_value<boost::uint64_t>(os, entry.location.offset);
+        write_value<boost::uint64_t>(os, entry.location.length);
+    }
+
+} // namespace packed_layout
+
+//! Data source used to read packed object from the mapped pack region.
+class PackedObjectSource
+{
+public:
+    typedef char char_type;                                         //!< Stream char_type. See boost::istreams docs for the details.
+    typedef boost::iostreams::source_tag category;                  //!< Stream category. See boost::istreams docs for the details.
+    typedef boost::iostreams::stream<PackedObjectSource> istream;   //!< Packed object input stream.
+
+    PackedObjectSource(const boost::shared_ptr<bip::mapped_region>& region, std::size_t pos = 0)
+        : region_(region)
+        , pos_(pos)
+    {
+    }
+
+    std::streamsize read(char* buffer, std::streamsize n)
+    {
+        std::size_t size = region_->get_size();
+        if (pos_ >= size)
+        {
+            return -1;
+        }
+
+        std::size_t to_read = std::min<std::size_t>(size - pos_, static_cast<std::size_t>(n));
+        std::memcpy(buffer, static_cast<const char*>(region_->get_address()) + pos_, to_read);
+        pos_ += to_read;
+
+        return static_cast<std::streamsize>(to_read);
+    }
+
+private:
+    boost::shared_ptr<bip::mapped_region>   region_;
+    std::size_t                             pos_;
+};
+
+/*static*/ const std::size_t PackedDirectoryStorage::default_loose_objects_limit = 1024;
+/*static*/ const std::size_t PackedDirectoryStorage::default_packs_limit         = 16;
+
+PackedDirectoryStorage::PackedDirectoryStorage(const boost::filesystem::path& root_dir, bool read_only)
+    : LocalDirectoryStorage(root_dir, read_only)
+    , packs_(root_dir / packed_layout::L::packs)
+    , index_(packs_ / packed_layout::L::index)
+    , index_file_()
+    , index_region_()
+    , entries_(0)
+    , count_(0)
+    , packs_count_(0)
+    , loose_count_()
+    , loose_objects_limit_(default_loose_objects_limit)
+    , packs_limit_(default_packs_limit)
+{
+    if (!read_only && !fs::exists(packs_) && !fs::create_directories(packs_))
+    {
+        LOGF << "Unable to create packs directory: " << packs_ << ELOG;
+
+        throw errors::unable_to_create_directory();
+    }
+
+    map_index();
+}
+
+PackedDirectoryStorage::~PackedDirectoryStorage()
+{
+}
+
+/*static*/ bool PackedDirectoryStorage::is_packed(const boost::filesystem::path& root_dir)
+{
+    return fs::exists(root_dir / packed_layout::L::packs);
+}
+
+void PackedDirectoryStorage::map_index()
+{
+    using namespace packed_layout;
+
+    index_region_.reset();
+    index_file_.reset();
+    entries_        = 0;
+    count_          = 0;
+    packs_count_    = 0;
+
+    if (!fs::exists(index_) || fs::file_size(index_) < F::header_size)
+    {
+        LOGT << "No packs index: " << index_ << ELOG;
+        return;
+    }
+
+    index_file_     = boost::shared_ptr<FileMapping>(new FileMapping(index_.c_str(), bip::read_only));
+    index_region_   = boost::shared_ptr<MappedRegion>(new MappedRegion(*index_file_, bip::read_only));
+
+    const char *data = static_cast<const char*>(index_region_->get_address());
+
+    if (std::memcmp(data, F::magic, sizeof(F::magic)) != 0 || read_value<boost::uint32_t>(data + 4) != F::version)
+    {
+        LOGF << "Unknown packs index format: " << index_ << ELOG;
+
+        throw errors::corrupted_pack_index();
+    }
+
+    count_          = static_cast<std::size_t>(read_value<boost::uint64_t>(data + 8));
+    packs_count_    = read_value<boost::uint32_t>(data + 16);
+
+    if (index_region_->get_size() < F::header_size + count_ * F::entry_size)
+    {
+        LOGF << "Truncated packs index: " << index_ << ELOG;
+
+        throw errors::corrupted_pack_index();
+    }
+
+    entries_ = data + F::header_size;
+
+    LOGT << "Mapped packs index: " << index_ << " objects: " << count_ << " packs: " << packs_count_ << ELOG;
+}
+
+boost::optional<PackedDirectoryStorage::Location> PackedDirectoryStorage::find(const AssetId& id) const
+{
+    using namespace packed_layout;
+
+    if (!count_)
+    {
+        return boost::none;
+    }
+
+    Key key = key_for(id);
+    if (key.empty())
+    {
+        return boost::none;
+    }
+
+    // Binary search in the mapped index.
+    std::size_t first = 0, last = count_;
+    while (first < last)
+    {
+        std::size_t middle = first + (last - first) / 2;
+        const char *entry  = entries_ + middle * F::entry_size;
+
+        int cmp = std::memcmp(entry, key.data(), F::id_size);
+        if (cmp == 0)
+        {
+            return read_entry(entry).location;
+        }
+        else if (cmp < 0)
+        {
+            first = middle + 1;
+        }
+        else
+        {
+            last = middle;
+        }
+    }
+
+    return boost::none;
+}
+
+boost::filesystem::path PackedDirectoryStorage::pack_path(unsigned int pack) const
+{
+    return packs_ / (boost::format(packed_layout::L::pack_name_format) % pack).str();
+}
+
+std::size_t PackedDirectoryStorage::packed_count() const
+{
+    return count_;
+}
+
+void PackedDirectoryStorage::set_loose_objects_limit(std::size_t limit)
+{
+    loose_objects_limit_ = limit;
+}
+
+void PackedDirectoryStorage::set_packs_limit(std::size_t limit)
+{
+    packs_limit_ = limit;
+}
+
+void PackedDirectoryStorage::loose_object_added()
+{
+    if (!loose_count_)
+    {
+        // Loose area is repacked on the limit, so it is small.
+        std::size_t count = 0;
+        if (fs::exists(objects_))
+        {
+            for (fs::recursive_directory_iterator i(objects_), end; i != end; ++i)
+            {
+                count += fs::is_regular_file(i->status());
+            }
+        }
+        loose_count_ = count;
+    }
+    else
+    {
+        ++*loose_count_;
+    }
+
+    if (*loose_count_ >= loose_objects_limit_)
+    {
+        LOGT << "Loose objects limit is reached: " << *loose_count_ << ELOG;
+        repack();
+    }
+}
+
+void PackedDirectoryStorage::put(const Asset& asset)
+{
+    if (asset.id() == AssetId::empty || contains(asset.id()))
+    {
+        return;
+    }
+
+    LocalDirectoryStorage::put(asset);
+    loose_object_added();
+}
+
+void PackedDirectoryStorage::put(std::set<Asset> assets)
+{
+    // Objects are counted by put(const Asset&).
+    LocalDirectoryStorage::put(assets);
+}
+
+AssetId PackedDirectoryStorage::ingest(const Asset& asset)
+{
+    if (asset.id_calculated())
+    {
+        put(asset);
+        return asset.id();
+    }
+
+    // Known object is not stored again, but it is cheaper to count it than to check it.
+    AssetId id = LocalDirectoryStorage::ingest(asset);
+    loose_object_added();
+    return id;
+}
+
+void PackedDirectoryStorage::put_verified(const Asset& asset)
+{
+    if (asset.id() == AssetId::empty || contains(asset.id()))
+    {
+        return;
+    }
+
+    LocalDirectoryStorage::put_verified(asset);
+    loose_object_added();
+}
+
+// Check if readable asset available in storage.
+bool PackedDirectoryStorage::contains(const AssetId& id) const
+{
+    return find(id) || LocalDirectoryStorage::contains(id);
+}
+
+// Make attempt to get readable asset from storage. Non readable Asset will be returned on fail.
+Asset PackedDirectoryStorage::asset(const IObjectsStorage::Ptr& storage, const AssetId& id) const
+{
+    if (find(id))
+    {
+        return Asset::create_for(storage, id);
+    }
+    else
+    {
+        return LocalDirectoryStorage::asset(storage, id);
+    }
+}
+
+// Get input stream for reading asset data. Low level API used by Asset implementation.
+//External code must use get().istream() call sequense.
+boost::shared_ptr<std::istream> PackedDirectoryStorage::istream_for(const AssetId& id) const
+{
+    boost::optional<Location> location = find(id);
+    if (!location)
+    {
+        return LocalDirectoryStorage::istream_for(id);
+    }
+
+    if (!location->length)
+    {
+        return boost::shared_ptr<std::istream>(new std::istringstream());
+    }
+
+    FileMapping pack_file(pack_path(location->pack).c_str(), bip::read_only);
+    boost::shared_ptr<MappedRegion> region(new MappedRegion(pack_file, bip::read_only,
+            static_cast<bip::offset_t>(location->offset), static_cast<std::size_t>(location->length)));
+
+    // Packs keep the loose objects data as is, including the compressed objects headers.
+    ObjectCompression::Header header;
+    if (ObjectCompression::parse_header(static_cast<const char*>(region->get_address()), region->get_size(), header))
+    {
+        return decoded(boost::shared_ptr<std::istream>(
+                new PackedObjectSource::istream(PackedObjectSource(region, ObjectCompression::header_size))), header);
+    }
+
+    return boost::shared_ptr<std::istream>(new PackedObjectSource::istream(PackedObjectSource(region)));
+}
+
+std::size_t PackedDirectoryStorage::size_of(const AssetId& id) const
+{
+    boost::optional<Location> location = find(id);
+    if (!location)
+    {
+        return LocalDirectoryStorage::size_of(id);
+    }
+
+    if (location->length >= ObjectCompression::header_size)
+    {
+        FileMapping pack_file(pack_path(location->pack).c_str(), bip::read_only);
+        MappedRegion region(pack_file, bip::read_only,
+                static_cast<bip::offset_t>(location->offset), ObjectCompression::header_size);
+
+        ObjectCompression::Header header;
+        if (ObjectCompression::parse_header(static_cast<const char*>(region.get_address()), region.get_size(), header))
+        {
+            return static_cast<std::size_t>(header.size);
+        }
+    }
+
+    return static_cast<std::size_t>(location->length);
+}
+
+bool PackedDirectoryStorage::object_location(const AssetId& id, ObjectChunks::Location& location) const
+{
+    boost::optional<Location> packed = find(id);
+    if (!packed)
+    {
+        return LocalDirectoryStorage::object_location(id, location);
+    }
+
+    location.file   = pack_path(packed->pack);
+    location.offset = packed->offset;
+    location.length = packed->length;
+    return true;
+}
+
+std::size_t PackedDirectoryStorage::repack()
+{
+    return pack(false);
+}
+
+std::size_t PackedDirectoryStorage::consolidate()
+{
+    return pack(true);
+}
+
+std::size_t PackedDirectoryStorage::pack(bool merge)
+{
+    using namespace packed_layout;
+
+    check_writable();
+
+    std::vector<Entry>      new_entries;
+    std::vector<fs::path>   new_objects;
+    std::vector<fs::path>   loose_objects;
+    std::vector<fs::path>   loose_dirs;
+
+    // 1. Collect loose objects.
+    for (fs::recursive_directory_iterator i(objects_), end; i != end; ++i)
+    {
+        if (fs::is_directory(i->path()))
+        {
+            loose_dirs.push_back(i->path());
+            continue;
+        }
+
+        AssetId id = AssetId::create(i->path().filename().string());
+
+        Entry entry;
+        entry.key = key_for(id);
+
+        if (entry.key.empty())
+        {
+            LOGW << "Skip unknown loose object: " << i->path() << ELOG;
+            continue;
+        }
+
+        loose_objects.push_back(i->path());
+
+        if (find(id))
+        {
+            LOGT << "Already packed: " << i->path() << ELOG;
+            continue;
+        }
+
+        new_entries.push_back(entry);
+        new_objects.push_back(i->path());
+    }
+
+    // 2. Existing index entries, sorted by id.
+    std::vector<Entry> entries;
+    std::set<unsigned int> packs;
+    entries.reserve(count_);
+    for (std::size_t i = 0; i < count_; ++i)
+    {
+        entries.push_back(read_entry(entries_ + i * F::entry_size));
+        packs.insert(entries.back().location.pack);
+    }
+
+    std::size_t result_packs = packs.size() + (new_entries.empty() ? 0 : 1);
+    merge = (merge || result_packs > packs_limit_) && result_packs > 1;
+
+    if (!new_entries.empty() || merge)
+    {
+        // 3. Append objects data into the new pack.
+        unsigned int pack = packs_count_ + 1;
+        fs::path new_pack = pack_path(pack);
+
+        LOGT << "Create pack: " << new_pack << " loose objects: " << new_entries.size() << " merge packs: " << merge << ELOG;
+
+        std::ofstream pack_os(new_pack.c_str(), std::ofstream::out|std::ofstream::binary|std::ofstream::trunc);
+        std::vector<char> buffer(CommonConstants::io_buffer_size);
+
+        unsigned long long offset = 0;
+
+        if (merge)
+        {
+            typedef std::map<unsigned int, boost::shared_ptr<std::ifstream> > Packs;
+            Packs opened;
+
+            for (std::vector<Entry>::iterator i = entries.begin(), end = entries.end(); i != end; ++i)
+            {
+                boost::shared_ptr<std::ifstream>& is = opened[i->location.pack];
+                if (!is)
+                {
+                    is.reset(new std::ifstream(pack_path(i->location.pack).c_str(), std::ifstream::in|std::ifstream::binary));
+                }
+
+                is->clear();
+                is->seekg(static_cast<std::streamoff>(i->location.offset));
+
+                for (unsigned long long left = i->location.length; left > 0; )
+                {
+                    std::streamsize readed = is->read(buffer.data(), static_cast<std::streamsize>(
+                            std::min<unsigned long long>(left, buffer.size()))).gcount();
+                    if (readed <= 0)
+                    {
+                        LOGF << "Truncated pack: " << pack_path(i->location.pack) << ELOG;
+
+                        throw errors::corrupted_pack_index();
+                    }
+                    pack_os.write(buffer.data(), readed);
+                    left -= readed;
+                }
+
+                i->location.pack    = pack;
+                i->location.offset  = offset;
+
+                offset += i->location.length;
+            }
+        }
+
+        for (std::size_t i = 0; i < new_entries.size(); ++i)
+        {
+            std::ifstream is(new_objects[i].c_str(), std::ifstream::in|std::ifstream::binary);
+
+            unsigned long long length = 0;
+            do {
+                std::streamsize readed = is.read(buffer.data(), buffer.size()).gcount();
+                if (readed) {
+                    pack_os.write(buffer.data(), readed);
+                    length += readed;
+                }
+            } while(!is.eof() & !is.fail() & !is.bad());
+
+            new_entries[i].location.pack    = pack;
+            new_entries[i].location.offset  = offset;
+            new_entries[i].location.length  = length;
+
+            offset += length;
+        }
+
+        pack_os.flush();
+        if (!pack_os)
+        {
+            LOGF << "Unable to write pack: " << new_pack << ELOG;
+
+            throw errors::unable_to_write_pack();
+        }
+
+        // 4. Merge existing index with the new entries.
+        std::sort(new_entries.begin(), new_entries.end());
+
+        std::vector<Entry> merged(entries.size() + new_entries.size());
+        std::merge(entries.begin(), entries.end(), new_entries.begin(), new_entries.end(), merged.begin());
+
+        // 5. Write new index and atomically replace the old one.
+        fs::path index_tmp = packs_ / L::index_tmp;
+        {
+            std::ofstream index_os(index_tmp.c_str(), std::ofstream::out|std::ofstream::binary|std::ofstream::trunc);
+
+            index_os.write(F::magic, sizeof(F::magic));
+            write_value<boost::uint32_t>(index_os, F::version);
+            write_value<boost::uint64_t>(index_os, merged.size());
+            write_value<boost::uint32_t>(index_os, pack);
+            write_value<boost::uint32_t>(index_os, 0);
+
+            for (std::vector<Entry>::const_iterator i = merged.begin(), end = merged.end(); i != end; ++i)
+            {
+                write_entry(index_os, *i);
+            }
+
+            index_os.flush();
+            if (!index_os)
+            {
+                LOGF << "Unable to write packs index: " << index_tmp << ELOG;
+
+                throw errors::unable_to_write_pack();
+            }
+        }
+
+        index_region_.reset();
+        index_file_.reset();
+
+        fs::rename(index_tmp, index_);
+
+        map_index();
+
+        // 6. Merged packs are not referenced by the index anymore.
+        if (merge)
+        {
+            for (std::set<unsigned int>::const_iterator i = packs.begin(), end = packs.end(); i != end; ++i)
+            {
+                fs::remove(pack_path(*i));
+            }
+        }
+    }
+
+    // 7. Loose objects are packed now, cleanup the staging area.
+    for (std::vector<fs::path>::const_iterator i = loose_objects.begin(), end = loose_objects.end(); i != end; ++i)
+    {
+        fs::remove(*i);
+    }
+
+    // Deepest directories first.
+    for (std::vector<fs::path>::const_reverse_iterator i = loose_dirs.rbegin(), end = loose_dirs.rend(); i != end; ++i)
+    {
+        if (fs::is_empty(*i))
+        {
+            fs::remove(*i);
+        }
+    }
+
+    loose_count_ = std::size_t(0);
+
+    LOGT << "Packed objects: " << new_entries.size() << " total: " << count_ << ELOG;
+
+    return new_entries.size();
+}
+
+} } // namespace piel::lib
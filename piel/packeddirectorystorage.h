@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PIEL_PACKEDDIRECTORYSTORAGE_H_
+#define PIEL_PACKEDDIRECTORYSTORAGE_H_
+
+#include <localdirectorystorage.h>
+
+#include <boost/optional.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+namespace piel { namespace lib {
+
+namespace errors {
+    struct corrupted_pack_index {};
+    struct unable_to_write_pack {};
+}
+
+//! Objects storage what keeps objects in the big append only pack files.
+//!
+//! Layout:
+//!  <root>/objects/...             - loose objects (staging area, see LocalDirectoryStorage).
+//!  <root>/packs/pack-XXXXXXXX.pack - objects data.
+//!  <root>/packs/packs.idx          - sorted by object id index: id -> (pack, offset, length).
+//!
+//! The index is memory mapped, so contains() and istream_for() are a binary search
+//! in the mapped memory instead of the filesystem lookups. New objects are put into
+//! the loose area first and moved into the new pack by repack(), what is called when
+//! the loose objects count reaches the limit. When the packs count reaches the limit,
+//! repack() merges all packs into the single one, see consolidate().
+class PackedDirectoryStorage : public LocalDirectoryStorage
+{
+public:
+    //! Packed object location.
+    struct Location {
+        Location()
+            : pack(0)
+            , offset(0)
+            , length(0)
+        {}
+
+        unsigned int        pack;       //!< Pack number.
+        unsigned long long  offset;     //!< Object data offset in the pack.
+        unsigned long long  length;     //!< Object data length.
+    };
+
+    //! \param read_only See LocalDirectoryStorage. Packs directory is not created, repack() throws.
+    PackedDirectoryStorage(const boost::filesystem::path& root_dir, bool read_only = false);
+    virtual ~PackedDirectoryStorage();
+
+    static const std::size_t    default_loose_objects_limit;    //!< Loose objects count what triggers repack.
+    static const std::size_t    default_packs_limit;            //!< Packs count what triggers packs merge.
+
+    //! Check if directory contains packed storage.
+    static bool is_packed(const boost::filesystem::path& root_dir);
+
+    // Put readable asset(s) into storage. Objects are packed when the loose objects limit is reached.
+    void put(const Asset& asset);
+    void put(std::set<Asset> assets);
+    AssetId ingest(const Asset& asset);
+    void put_verified(const Asset& asset);
+
+    // Check if readable asset available in storage.
+    bool contains(const AssetId& id) const;
+
+    // Make attempt to get readable asset from storage. Non readable Asset will be returned on fail.
+    Asset asset(const IObjectsStorage::Ptr& storage, const AssetId& id) const;
+
+    // Get input stream for reading asset data. Low level API used by Asset implementation.
+    //External code must use get().istream() call sequense.
+    boost::shared_ptr<std::istream> istream_for(const AssetId& id) const;
+    std::size_t size_of(const AssetId& id) const;
+
+    //! Move all loose objects into the new pack and rebuild the packs index. If packs limit
+    //! is reached, all packed objects are moved into the new pack too.
+    //! \return number of the packed loose objects.
+    std::size_t repack();
+
+    //! Move all loose and packed objects into the single new pack.
+    //! \return number of the packed loose objects.
+    std::size_t consolidate();
+
+    void set_loose_objects_limit(std::size_t limit);
+    void set_packs_limit(std::size_t limit);
+
+    //! Number of the objects in the packs index.
+    std::size_t packed_count() const;
+
+protected:
+    //! Map packs index into the memory.
+    void map_index();
+
+    //! Move loose objects into the new pack, optionally with all packed objects.
+    std::size_t pack(bool merge);
+
+    //! Count new loose object and repack if the loose objects limit is reached.
+    void loose_object_added();
+
+    //! Find object location in the packs index.
+    boost::optional<Location> find(const AssetId& id) const;
+
+    boost::filesystem::path pack_path(unsigned int pack) const;
+
+    bool object_location(const AssetId& id, ObjectChunks::Location& location) const;
+
+private:
+    typedef boost::interprocess::file_mapping   FileMapping;
+    typedef boost::interprocess::mapped_region  MappedRegion;
+
+    boost::filesystem::path             packs_;         //!< Packs directory.
+    boost::filesystem::path             index_;         //!< Packs index file.
+    boost::shared_ptr<FileMapping>      index_file_;    //!< Packs index file mapping.
+    boost::shared_ptr<MappedRegion>     index_region_;  //!< Mapped packs index.
+    const char                          *entries_;      //!< Pointer to the first index entry.
+    std::size_t                         count_;         //!< Index entries count.
+    unsigned int                        packs_count_;   //!< Last pack number.
+    boost::optional<std::size_t>        loose_count_;   //!< Loose objects count, calculated on first put.
+    std::size_t                         loose_objects_limit_;
+    std::size_t                         packs_limit_;
+};
+
+} } // namespace piel::lib
+
+#endif /* PIEL_PACKEDDIRECTORYSTORAGE_H_ */
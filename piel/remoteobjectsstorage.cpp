@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <remoteobjectsstorage.h>
+#include <artbaseconstants.h>
+#include <artbasedownloadhandlers.h>
+#include <artstreamuploadhandlers.h>
+#include <logging.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+#include <sstream>
+
+namespace piel { namespace lib {
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+    struct C {
+        static const std::string objects_dir;
+        static const std::string references_file;
+        static const std::string content_length;
+        static const long        not_found;
+    };
+
+    /*static*/ const std::string C::objects_dir        = "objects";
+    /*static*/ const std::string C::references_file    = "references.properties";
+    /*static*/ const std::string C::content_length     = "content-length";
+    /*static*/ const long        C::not_found          = 404;
+
+    //! Stream of the downloaded object. Temporary file is removed with the stream.
+    class TempFileStream: public std::ifstream
+    {
+    public:
+        TempFileStream(const fs::path& path)
+            : std::ifstream(path.c_str(), std::ifstream::in|std::ifstream::binary)
+            , path_(path)
+        {
+        }
+
+        ~TempFileStream()
+        {
+            close();
+            boost::system::error_code ec;
+            fs::remove(path_, ec);
+        }
+
+    private:
+        fs::path path_;
+    };
+
+} // namespace
+
+RemoteObjectsStorage::RemoteObjectsStorage(const std::string& server_url, const std::string& api_token,
+        const std::string& repository, const std::string& objects_path, const std::string& references_path)
+    : IObjectsStorage()
+    , server_url_(server_url)
+    , api_token_(api_token)
+    , repository_(repository)
+    , objects_path_(objects_path)
+    , references_path_(references_path)
+    , available_()
+    , refs_loaded_(false)
+    , refs_()
+{
+}
+
+RemoteObjectsStorage::~RemoteObjectsStorage()
+{
+}
+
+/*static*/ IObjectsStorage::Ptr RemoteObjectsStorage::create_for(const std::string& server_url, const std::string& api_token,
+        const std::string& repository, const art::lib::GavcQuery& query)
+{
+    std::string artifact_path = query.group_path()
+            + art::lib::ArtBaseConstants::uri_delimiter + query.name();
+
+    return IObjectsStorage::Ptr(new RemoteObjectsStorage(server_url, api_token, repository,
+            artifact_path + art::lib::ArtBaseConstants::uri_delimiter + C::objects_dir,
+            artifact_path + art::lib::ArtBaseConstants::uri_delimiter + query.version()
+                + art::lib::ArtBaseConstants::uri_delimiter + C::references_file));
+}
+
+std::string RemoteObjectsStorage::uri_for(const std::string& path) const
+{
+    return server_url_ + art::lib::ArtBaseConstants::uri_delimiter
+            + repository_ + art::lib::ArtBaseConstants::uri_delimiter + path;
+}
+
+std::string RemoteObjectsStorage::object_uri(const AssetId& id) const
+{
+    std::string id_str = id.string();
+    return uri_for(objects_path_ + art::lib::ArtBaseConstants::uri_delimiter + id_str.substr(0, 2)
+            + art::lib::ArtBaseConstants::uri_delimiter + id_str);
+}
+
+void RemoteObjectsStorage::upload(const std::string& uri, const boost::shared_ptr<std::istream>& is) const
+{
+    art::lib::ArtStreamUploadHandlers handlers(api_token_, is);
+    CurlEasyClient<art::lib::ArtStreamUploadHandlers> client(uri, &handlers);
+
+    LOGD << "Upload: " << uri << ELOG;
+
+    if (!client.perform())
+    {
+        LOGE << "Unable to upload: " << uri << ELOG;
+        LOGE << client.curl_error().presentation() << ELOG;
+
+        throw errors::remote_storage_error(client.curl_error().presentation());
+    }
+}
+
+void RemoteObjectsStorage::put(const Asset& asset)
+{
+    if (asset.id() == AssetId::empty || contains(asset.id()))
+    {
+        return;
+    }
+
+    upload(object_uri(asset.id()), asset.istream());
+    available_.insert(asset.id());
+}
+
+void RemoteObjectsStorage::put(std::set<Asset> assets)
+{
+    for (std::set<Asset>::const_iterator i = assets.begin(), end = assets.end(); i != end; ++i)
+    {
+        put(*i);
+    }
+}
+
+bool RemoteObjectsStorage::contains(const AssetId& id) const
+{
+    if (available_.find(id) != available_.end())
+    {
+        return true;
+    }
+
+    art::lib::ArtBaseDownloadHandlers handlers(api_token_);
+    CurlEasyClient<art::lib::ArtBaseDownloadHandlers> client(object_uri(id), &handlers);
+    client.set_request("HEAD");
+
+    if (client.perform())
+    {
+        available_.insert(id);
+        return true;
+    }
+    else if (client.curl_error().http_code() == C::not_found)
+    {
+        return false;
+    }
+
+    LOGE << "Unable to check object: " << id.string() << ELOG;
+    LOGE << client.curl_error().presentation() << ELOG;
+
+    throw errors::remote_storage_error(client.curl_error().presentation());
+}
+
+Asset RemoteObjectsStorage::asset(const IObjectsStorage::Ptr& storage, const AssetId& id) const
+{
+    if (contains(id))
+    {
+        return Asset::create_for(storage, id);
+    }
+    else
+    {
+        return Asset();
+    }
+}
+
+boost::shared_ptr<std::istream> RemoteObjectsStorage::istream_for(const AssetId& id) const
+{
+    fs::path tmp_path = fs::temp_directory_path() / fs::unique_path("pie-%%%%-%%%%-%%%%-%%%%");
+
+    bool downloaded = false;
+    long http_code  = 0;
+    std::string error;
+    {
+        std::ofstream os(tmp_path.c_str(), std::ofstream::out|std::ofstream::binary|std::ofstream::trunc);
+
+        art::lib::ArtBaseDownloadHandlers handlers(api_token_, &os);
+        CurlEasyClient<art::lib::ArtBaseDownloadHandlers> client(object_uri(id), &handlers);
+
+        LOGD << "Download: " << object_uri(id) << ELOG;
+
+        downloaded  = client.perform() && os.flush();
+        http_code   = client.curl_error().http_code();
+        error       = client.curl_error().presentation();
+    }
+
+    if (!downloaded)
+    {
+        boost::system::error_code ec;
+        fs::remove(tmp_path, ec);
+
+        if (http_code == C::not_found)
+        {
+            return boost::shared_ptr<std::istream>();
+        }
+
+        LOGE << "Unable to download object: " << id.string() << ELOG;
+        LOGE << error << ELOG;
+
+        throw errors::remote_storage_error(error);
+    }
+
+    available_.insert(id);
+    return boost::shared_ptr<std::istream>(new TempFileStream(tmp_path));
+}
+
+std::size_t RemoteObjectsStorage::size_of(const AssetId& id) const
+{
+    art::lib::ArtBaseDownloadHandlers handlers(api_token_);
+    CurlEasyClient<art::lib::ArtBaseDownloadHandlers> client(object_uri(id), &handlers);
+    client.set_request("HEAD");
+
+    if (!client.perform())
+    {
+        return 0;
+    }
+
+    typedef std::map<std::string, std::string>::const_iterator ConstIter;
+    for (ConstIter i = handlers.headers().begin(), end = handlers.headers().end(); i != end; ++i)
+    {
+        if (boost::iequals(i->first, C::content_length))
+        {
+            return boost::lexical_cast<std::size_t>(i->second);
+        }
+    }
+
+    return 0;
+}
+
+void RemoteObjectsStorage::load_references() const
+{
+    if (refs_loaded_)
+    {
+        return;
+    }
+
+    std::ostringstream os;
+    art::lib::ArtBaseDownloadHandlers handlers(api_token_, &os);
+    CurlEasyClient<art::lib::ArtBaseDownloadHandlers> client(uri_for(references_path_), &handlers);
+
+    if (client.perform())
+    {
+        std::istringstream is(os.str());
+        refs_ = Properties::load(is);
+    }
+    else if (client.curl_error().http_code() == C::not_found)
+    {
+        LOGD << "No references on server: " << uri_for(references_path_) << ELOG;
+        refs_.clear();
+    }
+    else
+    {
+        LOGE << "Unable to download references: " << uri_for(references_path_) << ELOG;
+        LOGE << client.curl_error().presentation() << ELOG;
+
+        throw errors::remote_storage_error(client.curl_error().presentation());
+    }
+
+    refs_loaded_ = true;
+}
+
+void RemoteObjectsStorage::store_references() const
+{
+    std::ostringstream os;
+    refs_.store(os);
+
+    upload(uri_for(references_path_), boost::shared_ptr<std::istream>(new std::istringstream(os.str())));
+}
+
+void RemoteObjectsStorage::create_reference(const refs::Ref& ref)
+{
+    load_references();
+    if (refs_.contains(ref.first))
+    {
+        throw errors::unable_to_insert_new_reference();
+    }
+    refs_.set(ref.first, ref.second.string());
+    store_references();
+}
+
+void RemoteObjectsStorage::destroy_reference(const refs::Ref::first_type& ref_name)
+{
+    load_references();
+    refs_.data().erase(ref_name);
+    store_references();
+}
+
+void RemoteObjectsStorage::update_reference(const refs::Ref& ref)
+{
+    load_references();
+    refs_.set(ref.first, ref.second.string());
+    store_references();
+}
+
+AssetId RemoteObjectsStorage::resolve(const std::string& ref) const
+{
+    load_references();
+    if (refs_.contains(ref))
+    {
+        return AssetId::create(refs_.get(ref, std::string()));
+    }
+    else if (ref.length() == AssetId::str_digest_len)
+    {
+        AssetId id = AssetId::create(ref);
+        return id != AssetId::empty && contains(id) ? id : AssetId::empty;
+    }
+    else
+    {
+        return AssetId::empty;
+    }
+}
+
+std::set<refs::Ref> RemoteObjectsStorage::references() const
+{
+    load_references();
+
+    std::set<refs::Ref> result;
+    for (Properties::MapType::const_iterator i = refs_.data().begin(), end = refs_.data().end(); i != end; ++i)
+    {
+        result.insert(std::make_pair(i->first, AssetId::create(i->second)));
+    }
+    return result;
+}
+
+} } // namespace piel::lib
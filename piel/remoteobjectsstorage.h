@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PIEL_REMOTEOBJECTSSTORAGE_H_
+#define PIEL_REMOTEOBJECTSSTORAGE_H_
+
+#include <iobjectsstorage.h>
+#include <properties.h>
+#include <gavcquery.h>
+
+namespace piel { namespace lib {
+
+namespace errors {
+    struct remote_storage_error
+    {
+        remote_storage_error(const std::string& e) : error(e) {}
+        std::string error;
+    };
+}
+
+//! Objects storage on the HTTP server (artifactory generic repository or any server
+//! what supports GET, HEAD and PUT requests).
+//!
+//! Layout:
+//!  <objects path>/<2 first id chars>/<id>  - objects data.
+//!  <references path>                       - references properties file: name=id.
+//!
+//! Objects what are known to be on server are remembered, so the each object is checked
+//! by HEAD request at most once.
+class RemoteObjectsStorage : public IObjectsStorage
+{
+public:
+    RemoteObjectsStorage(const std::string& server_url, const std::string& api_token, const std::string& repository,
+            const std::string& objects_path, const std::string& references_path);
+    virtual ~RemoteObjectsStorage();
+
+    //! Storage for the gavc query: objects are shared between all versions of the artifact,
+    //!references are stored per version.
+    static IObjectsStorage::Ptr create_for(const std::string& server_url, const std::string& api_token,
+            const std::string& repository, const art::lib::GavcQuery& query);
+
+    // Put readable asset(s) into storage.
+    void put(const Asset& asset);
+    void put(std::set<Asset> assets);
+    void create_reference(const refs::Ref& ref);
+    void destroy_reference(const refs::Ref::first_type& ref_name);
+    void update_reference(const refs::Ref& ref);
+
+    // Check if readable asset available in storage.
+    bool contains(const AssetId& id) const;
+
+    // Make attempt to get readable asset from storage. Non readable Asset will be returned on fail.
+    Asset asset(const IObjectsStorage::Ptr& storage, const AssetId& id) const;
+
+    // Get input stream for reading asset data. Low level API used by Asset implementation.
+    //External code must use get().istream() call sequense. Data is downloaded into the
+    //temporary file what is removed with the stream.
+    boost::shared_ptr<std::istream> istream_for(const AssetId& id) const;
+    std::size_t size_of(const AssetId& id) const;
+
+    AssetId resolve(const std::string& ref) const;
+    std::set<refs::Ref> references() const;
+
+protected:
+    std::string uri_for(const std::string& path) const;
+    std::string object_uri(const AssetId& id) const;
+
+    //! Upload stream data to the server path.
+    void upload(const std::string& uri, const boost::shared_ptr<std::istream>& is) const;
+    //! Download references file if it is not loaded yet.
+    void load_references() const;
+    void store_references() const;
+
+private:
+    std::string             server_url_;
+    std::string             api_token_;
+    std::string             repository_;
+    std::string             objects_path_;
+    std::string             references_path_;
+    mutable std::set<AssetId> available_;       //!< Objects what are known to be on server.
+    mutable bool            refs_loaded_;
+    mutable Properties      refs_;
+};
+
+} } // namespace piel::lib
+
+#endif /* PIEL_REMOTEOBJECTSSTORAGE_H_ */
@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <statcache.h>
+#include <logging.h>
+
+#include <sys/stat.h>
+
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace piel { namespace lib {
+
+namespace fs = boost::filesystem;
+
+namespace stat_cache_format {
+
+    struct F {
+        static const char           magic[4];
+        static const uint32_t       version;
+        static const std::size_t    header_size;
+        static const std::size_t    entry_size;     //!< Entry size without name.
+    };
+
+    /*static*/ const char           F::magic[4]     = { 'P', 'S', 'T', 'C' };
+    /*static*/ const uint32_t       F::version      = 1;
+    /*static*/ const std::size_t    F::header_size  = 4 + sizeof(uint32_t) + sizeof(uint64_t);
+    /*static*/ const std::size_t    F::entry_size   = sizeof(uint32_t) + 5 * sizeof(uint64_t) + sizeof(uint32_t) + AssetId::digest_len;
+
+} // namespace stat_cache_format
+
+namespace {
+
+    template<typename T>
+    T read_value(const char *&data)
+    {
+        T result;
+        std::memcpy(&result, data, sizeof(T));
+        data += sizeof(T);
+        return result;
+    }
+
+    template<typename T>
+    void write_value(std::ostream& os, T value)
+    {
+        os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    int64_t to_ns(const struct timespec& ts)
+    {
+        return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+    }
+
+} // namespace
+
+bool StatCache::Stat::operator==(const Stat& src) const
+{
+    return size     == src.size
+        && mtime_ns == src.mtime_ns
+        && ctime_ns == src.ctime_ns
+        && ino      == src.ino
+        && dev      == src.dev
+        && mode     == src.mode;
+}
+
+bool StatCache::Stat::operator!=(const Stat& src) const
+{
+    return !operator==(src);
+}
+
+StatCache::StatCache(const fs::path& cache_file)
+    : cache_file_(cache_file)
+    , entries_()
+    , seen_()
+    , started_(static_cast<int64_t>(std::time(0)))
+    , changed_(false)
+    , mutex_()
+    , hits_(0)
+    , misses_(0)
+{
+}
+
+StatCache::~StatCache()
+{
+}
+
+/*static*/ boost::optional<StatCache::Stat> StatCache::stat(const fs::path& file_path)
+{
+    struct ::stat st;
+    if (::lstat(file_path.c_str(), &st) != 0)
+    {
+        return boost::none;
+    }
+
+    Stat result;
+    result.size     = static_cast<uint64_t>(st.st_size);
+    result.mtime_ns = to_ns(st.st_mtim);
+    result.ctime_ns = to_ns(st.st_ctim);
+    result.ino      = static_cast<uint64_t>(st.st_ino);
+    result.dev      = static_cast<uint64_t>(st.st_dev);
+    result.mode     = static_cast<uint32_t>(st.st_mode);
+    return result;
+}
+
+void StatCache::load()
+{
+    using namespace stat_cache_format;
+
+    entries_.clear();
+    seen_.clear();
+    changed_ = false;
+
+    std::ifstream is(cache_file_.c_str(), std::ifstream::in|std::ifstream::binary);
+    if (!is)
+    {
+        LOGT << "No stat cache: " << cache_file_ << ELOG;
+        return;
+    }
+
+    std::vector<char> buffer((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+
+    const char *data = buffer.data();
+    const char *end  = data + buffer.size();
+
+    if (buffer.size() < F::header_size || std::memcmp(data, F::magic, sizeof(F::magic)) != 0)
+    {
+        LOGW << "Ignore corrupted stat cache: " << cache_file_ << ELOG;
+        return;
+    }
+    data += sizeof(F::magic);
+
+    if (read_value<uint32_t>(data) != F::version)
+    {
+        LOGW << "Ignore stat cache of unsupported version: " << cache_file_ << ELOG;
+        return;
+    }
+
+    uint64_t count = read_value<uint64_t>(data);
+
+    Entries entries;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        if (static_cast<std::size_t>(end - data) < F::entry_size)
+        {
+            LOGW << "Ignore corrupted stat cache: " << cache_file_ << ELOG;
+            return;
+        }
+
+        uint32_t name_len = read_value<uint32_t>(data);
+        if (static_cast<std::size_t>(end - data) < F::entry_size - sizeof(uint32_t) + name_len)
+        {
+            LOGW << "Ignore corrupted stat cache: " << cache_file_ << ELOG;
+            return;
+        }
+
+        std::string name(data, name_len);
+        data += name_len;
+
+        Entry entry;
+        entry.stat.size     = read_value<uint64_t>(data);
+        entry.stat.mtime_ns = read_value<int64_t>(data);
+        entry.stat.ctime_ns = read_value<int64_t>(data);
+        entry.stat.ino      = read_value<uint64_t>(data);
+        entry.stat.dev      = read_value<uint64_t>(data);
+        entry.stat.mode     = read_value<uint32_t>(data);
+        entry.id            = AssetId::create(reinterpret_cast<const unsigned char*>(data));
+        data += AssetId::digest_len;
+
+        entries.insert(entries.end(), std::make_pair(name, entry));
+    }
+
+    entries_.swap(entries);
+
+    LOGT << "Loaded stat cache: " << cache_file_ << " entries: " << entries_.size() << ELOG;
+}
+
+void StatCache::save()
+{
+    using namespace stat_cache_format;
+
+    // Drop entries for the files what are not exist anymore.
+    for (Entries::iterator i = entries_.begin(); i != entries_.end(); )
+    {
+        if (seen_.find(i->first) == seen_.end())
+        {
+            entries_.erase(i++);
+            changed_ = true;
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    if (!changed_)
+    {
+        return;
+    }
+
+    fs::path tmp_file = cache_file_;
+    tmp_file += ".tmp";
+
+    {
+        std::ofstream os(tmp_file.c_str(), std::ofstream::out|std::ofstream::binary|std::ofstream::trunc);
+
+        os.write(F::magic, sizeof(F::magic));
+        write_value<uint32_t>(os, F::version);
+        write_value<uint64_t>(os, entries_.size());
+
+        for (Entries::const_iterator i = entries_.begin(), end = entries_.end(); i != end; ++i)
+        {
+            write_value<uint32_t>(os, i->first.size());
+            os.write(i->first.data(), i->first.size());
+            write_value<uint64_t>(os, i->second.stat.size);
+            write_value<int64_t>(os,  i->second.stat.mtime_ns);
+            write_value<int64_t>(os,  i->second.stat.ctime_ns);
+            write_value<uint64_t>(os, i->second.stat.ino);
+            write_value<uint64_t>(os, i->second.stat.dev);
+            write_value<uint32_t>(os, i->second.stat.mode);
+            os.write(reinterpret_cast<const char*>(i->second.id.data()), AssetId::digest_len);
+        }
+
+        os.flush();
+        if (!os)
+        {
+            LOGW << "Unable to write stat cache: " << tmp_file << ELOG;
+
+            boost::system::error_code ec;
+            fs::remove(tmp_file, ec);
+            return;
+        }
+    }
+
+    boost::system::error_code ec;
+    fs::rename(tmp_file, cache_file_, ec);
+    if (ec)
+    {
+        LOGW << "Unable to replace stat cache: " << cache_file_ << " error: " << ec.message() << ELOG;
+        return;
+    }
+
+    changed_ = false;
+
+    LOGT << "Stored stat cache: " << cache_file_ << " entries: " << entries_.size() << ELOG;
+}
+
+boost::optional<AssetId> StatCache::lookup(const std::string& name, const Stat& st)
+{
+    boost::mutex::scoped_lock lock(mutex_);
+
+    seen_.insert(name);
+
+    Entries::const_iterator i = entries_.find(name);
+    if (i == entries_.end() || i->second.stat != st)
+    {
+        ++misses_;
+        return boost::none;
+    }
+
+    ++hits_;
+    return i->second.id;
+}
+
+void StatCache::update(const std::string& name, const Stat& st, const AssetId& id)
+{
+    boost::mutex::scoped_lock lock(mutex_);
+
+    seen_.insert(name);
+
+    if (!id.has_digest())
+    {
+        return;
+    }
+
+    // File can be modified after hashing without mtime change if filesystem
+    // timestamps are coarse. Don't trust entries what are not older than session.
+    if (st.mtime_ns / 1000000000LL >= started_)
+    {
+        Entries::iterator i = entries_.find(name);
+        if (i != entries_.end())
+        {
+            entries_.erase(i);
+            changed_ = true;
+        }
+        return;
+    }
+
+    Entry& entry = entries_[name];
+    entry.stat  = st;
+    entry.id    = id;
+    changed_    = true;
+}
+
+std::size_t StatCache::hits() const
+{
+    return hits_;
+}
+
+std::size_t StatCache::misses() const
+{
+    return misses_;
+}
+
+} } // namespace piel::lib
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PIEL_STATCACHE_H_
+#define PIEL_STATCACHE_H_
+
+#include <assetid.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <map>
+#include <set>
+#include <string>
+#include <cstdint>
+
+namespace piel { namespace lib {
+
+//! Persistent cache of the working directory files ids. Cache entries are keyed
+//! by the file path and contain the file stat information. While stat information
+//! is not changed, cached id is used instead of the file content hashing.
+//!
+//! Racy entries protection: files modified at the same second (or later) as the
+//! cache session was started are never stored into cache. Such files will be
+//! hashed again on the next session.
+//!
+//! lookup() and update() are thread safe and don't log.
+class StatCache
+{
+public:
+    //! File stat information.
+    struct Stat {
+        uint64_t    size;
+        int64_t     mtime_ns;
+        int64_t     ctime_ns;
+        uint64_t    ino;
+        uint64_t    dev;
+        uint32_t    mode;
+
+        bool operator==(const Stat& src) const;
+        bool operator!=(const Stat& src) const;
+    };
+
+    //! Constructor.
+    //! \param cache_file Cache file path.
+    StatCache(const boost::filesystem::path& cache_file);
+
+    //! Destructor.
+    ~StatCache();
+
+    //! Get file stat information (symlinks are not followed).
+    //! \param file_path File path.
+    //! \return Stat information, or boost::none on fail.
+    static boost::optional<Stat> stat(const boost::filesystem::path& file_path);
+
+    //! Load cache file content. Corrupted or missing cache file produces empty cache.
+    void load();
+
+    //! Store cache content into cache file. Entries for files what were not looked up
+    //! since load are dropped. Does nothing if the cache was not changed.
+    void save();
+
+    //! Lookup cached id.
+    //! \param name File name (relative to working directory).
+    //! \param st Current file stat information.
+    //! \return Cached id, or boost::none if there is no entry or file stat is changed.
+    boost::optional<AssetId> lookup(const std::string& name, const Stat& st);
+
+    //! Store id into cache. Racy entries are ignored.
+    //! \param name File name (relative to working directory).
+    //! \param st File stat information, taken before file content hashing.
+    //! \param id File content id.
+    void update(const std::string& name, const Stat& st, const AssetId& id);
+
+    //! \return Count of the successful lookups.
+    std::size_t hits() const;
+
+    //! \return Count of the failed lookups.
+    std::size_t misses() const;
+
+private:
+    struct Entry {
+        Stat    stat;
+        AssetId id;
+    };
+
+    typedef std::map<std::string, Entry> Entries;
+
+    boost::filesystem::path cache_file_;    //!< Cache file path.
+    Entries                 entries_;       //!< Cache entries.
+    std::set<std::string>   seen_;          //!< Names looked up since load.
+    int64_t                 started_;       //!< Session start time (seconds).
+    bool                    changed_;       //!< Cache must be saved.
+    boost::mutex            mutex_;         //!< Guards entries for concurrent lookups/updates.
+    std::size_t             hits_;          //!< Successful lookups count.
+    std::size_t             misses_;        //!< Failed lookups count.
+};
+
+} } // namespace piel::lib
+
+#endif /* PIEL_STATCACHE_H_ */
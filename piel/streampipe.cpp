@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <streampipe.h>
+
+#include <boost/iostreams/categories.hpp>
+#include <boost/iostreams/stream.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace piel { namespace lib {
+
+namespace {
+
+    //! Reading end of the pipe.
+    class PipeSource
+    {
+    public:
+        typedef char char_type;                                         //!< Stream char_type. See boost::istreams docs for the details.
+        typedef boost::iostreams::source_tag category;                  //!< Stream category. See boost::istreams docs for the details.
+        typedef boost::iostreams::stream<PipeSource> istream;           //!< Pipe input stream.
+
+        PipeSource(const StreamPipe::Ptr& pipe)
+            : pipe_(pipe)
+        {
+        }
+
+        std::streamsize read(char* buffer, std::streamsize n)
+        {
+            return pipe_->read(buffer, n);
+        }
+
+    private:
+        StreamPipe::Ptr pipe_;
+    };
+
+    //! Writing end of the pipe.
+    class PipeSink
+    {
+    public:
+        typedef char char_type;                                         //!< Stream char_type. See boost::istreams docs for the details.
+        typedef boost::iostreams::sink_tag category;                    //!< Stream category. See boost::istreams docs for the details.
+        typedef boost::iostreams::stream<PipeSink> ostream;             //!< Pipe output stream.
+
+        PipeSink(const StreamPipe::Ptr& pipe)
+            : pipe_(pipe)
+        {
+        }
+
+        std::streamsize write(const char* buffer, std::streamsize n)
+        {
+            return pipe_->write(buffer, n);
+        }
+
+    private:
+        StreamPipe::Ptr pipe_;
+    };
+
+} // namespace
+
+/*static*/ const std::size_t StreamPipe::default_capacity = 4 * 1024 * 1024;
+
+/*static*/ StreamPipe::Ptr StreamPipe::create(std::size_t capacity)
+{
+    return Ptr(new StreamPipe(capacity));
+}
+
+StreamPipe::StreamPipe(std::size_t capacity)
+    : buffer_(std::max<std::size_t>(capacity, 1))
+    , head_(0)
+    , size_(0)
+    , closed_(false)
+    , aborted_(false)
+    , read_closed_(false)
+    , mutex_()
+    , readable_()
+    , writable_()
+{
+}
+
+StreamPipe::~StreamPipe()
+{
+}
+
+boost::shared_ptr<std::istream> StreamPipe::istream()
+{
+    return boost::shared_ptr<std::istream>(new PipeSource::istream(PipeSource(shared_from_this())));
+}
+
+boost::shared_ptr<std::ostream> StreamPipe::ostream()
+{
+    return boost::shared_ptr<std::ostream>(new PipeSink::ostream(PipeSink(shared_from_this())));
+}
+
+std::streamsize StreamPipe::read(char* buffer, std::streamsize n)
+{
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    while (size_ == 0 && !closed_ && !aborted_)
+    {
+        readable_.wait(lock);
+    }
+
+    if (aborted_ || size_ == 0)
+    {
+        return -1;
+    }
+
+    std::size_t readed = std::min<std::size_t>(static_cast<std::size_t>(n), size_);
+    std::size_t first  = std::min<std::size_t>(readed, buffer_.size() - head_);
+    std::memcpy(buffer, &buffer_[head_], first);
+    std::memcpy(buffer + first, &buffer_[0], readed - first);
+
+    head_  = (head_ + readed) % buffer_.size();
+    size_ -= readed;
+
+    writable_.notify_all();
+    return static_cast<std::streamsize>(readed);
+}
+
+std::streamsize StreamPipe::write(const char* buffer, std::streamsize n)
+{
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    std::size_t written = 0;
+    while (written < static_cast<std::size_t>(n))
+    {
+        while (size_ == buffer_.size() && !read_closed_)
+        {
+            writable_.wait(lock);
+        }
+
+        if (read_closed_)
+        {
+            throw std::ios_base::failure("Pipe reader is closed.");
+        }
+
+        std::size_t tail  = (head_ + size_) % buffer_.size();
+        std::size_t chunk = std::min<std::size_t>(static_cast<std::size_t>(n) - written, buffer_.size() - size_);
+        std::size_t first = std::min<std::size_t>(chunk, buffer_.size() - tail);
+        std::memcpy(&buffer_[tail], buffer + written, first);
+        std::memcpy(&buffer_[0], buffer + written + first, chunk - first);
+
+        size_   += chunk;
+        written += chunk;
+
+        readable_.notify_all();
+    }
+    return n;
+}
+
+void StreamPipe::close()
+{
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    closed_ = true;
+    readable_.notify_all();
+}
+
+void StreamPipe::abort()
+{
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    aborted_ = true;
+    readable_.notify_all();
+}
+
+void StreamPipe::close_read()
+{
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    read_closed_ = true;
+    writable_.notify_all();
+}
+
+bool StreamPipe::aborted() const
+{
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    return aborted_;
+}
+
+} } // namespace piel::lib
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PIEL_STREAMPIPE_H_
+#define PIEL_STREAMPIPE_H_
+
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace piel { namespace lib {
+
+//! Bounded in memory pipe between the writing and the reading threads.
+//!
+//! Writer puts the data through ostream() and calls close() when done, or abort() if
+//!the data are incomplete. Reader gets the data through istream(). Reading blocks while
+//!the pipe is empty, writing blocks while the pipe is full. Writing fails after the reader
+//!has called close_read(), so the writer can't hang if the reader stops.
+class StreamPipe: public boost::enable_shared_from_this<StreamPipe>, private boost::noncopyable
+{
+public:
+    typedef boost::shared_ptr<StreamPipe> Ptr;
+
+    static const std::size_t default_capacity;
+
+    //! Create pipe.
+    //! \param capacity Maximum size of the data written but not read yet.
+    static Ptr create(std::size_t capacity = default_capacity);
+    ~StreamPipe();
+
+    //! Reading end of the pipe. Stream ends after close() or abort().
+    boost::shared_ptr<std::istream> istream();
+
+    //! Writing end of the pipe. Stream is failed if the reader has called close_read().
+    boost::shared_ptr<std::ostream> ostream();
+
+    //! Read data, blocks while the pipe is empty.
+    //! \return Number of bytes read or -1 at the end of the data.
+    std::streamsize read(char* buffer, std::streamsize n);
+
+    //! Write data, blocks while the pipe is full.
+    //! \throw std::ios_base::failure if the reader has called close_read().
+    std::streamsize write(const char* buffer, std::streamsize n);
+
+    //! Writer: all data are written.
+    void close();
+
+    //! Writer: data are incomplete. Reader gets the end of the data immediately.
+    void abort();
+
+    //! Reader: no more data will be read.
+    void close_read();
+
+    //! \return true if the writer has called abort().
+    bool aborted() const;
+
+private:
+    StreamPipe(std::size_t capacity);
+
+    std::vector<char>               buffer_;        //!< Ring buffer.
+    std::size_t                     head_;          //!< Position of the first unread byte.
+    std::size_t                     size_;          //!< Number of the unread bytes.
+    bool                            closed_;
+    bool                            aborted_;
+    bool                            read_closed_;
+    mutable boost::mutex            mutex_;
+    boost::condition_variable       readable_;
+    boost::condition_variable       writable_;
+};
+
+} } // namespace piel::lib
+
+#endif /* PIEL_STREAMPIPE_H_ */
@@ -31,9 +31,17 @@
 #include <logging.h>
 #include <boost_property_tree_ext.hpp>
 #include <boost_filesystem_ext.hpp>
+#include <binaryio.hpp>
+#include <merkletree.h>
 #include <boost/lexical_cast.hpp>
 
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
 namespace pt = boost::property_tree;
+namespace fs = boost::filesystem;
 
 namespace piel { namespace lib {
 
@@ -54,10 +62,16 @@ namespace constants {
 
 TreeIndex::TreeIndex()
     : self_(Asset::create_id(AssetId::not_calculated))
+    , self_valid_(false)
+    , self_data_()
+    , layout_(Layout_flat)
+    , directory_objects_()
+    , directory_ids_()
     , parent_()
     , content_()
     , attributes_()
     , content_attributes_()
+    , expand_storage_()
 {
 }
 
@@ -68,17 +82,31 @@ TreeIndex::~TreeIndex()
 
 bool TreeIndex::empty() const
 {
-    return  parent_.id() == AssetId::empty &&
-            content_.empty() &&
+    if (parent_.id() != AssetId::empty || !attributes_.empty())
+    {
+        return false;
+    }
+
+    expand();
+
+    return  content_.empty() &&
             attributes_.empty() &&
             content_attributes_.empty();
 }
 
 bool TreeIndex::insert_path(const std::string& index_path, const Asset& asset)
 {
+    expand();
+
     if (asset.id() != AssetId::empty)
     {
-        return content_.insert(std::make_pair(index_path, asset)).second;
+        if (!content_.insert(std::make_pair(index_path, asset)).second)
+        {
+            return false;
+        }
+
+        invalidate();
+        return true;
     }
     else
     {
@@ -89,9 +117,12 @@ bool TreeIndex::insert_path(const std::string& index_path, const Asset& asset)
 
 void TreeIndex::replace_path(const std::string& index_path, const Asset& asset)
 {
+    expand();
+
     if (asset.id() != AssetId::empty)
     {
         content_[index_path] = asset;
+        invalidate();
     }
     else
     {
@@ -101,27 +132,113 @@ void TreeIndex::replace_path(const std::string& index_path, const Asset& asset)
 
 bool TreeIndex::contains_path(const std::string& index_path) const
 {
+    expand();
     return content_.find(index_path) != content_.end();
 }
 
 void TreeIndex::remove_path(const std::string& index_path)
 {
-    content_.erase(index_path);
+    expand();
+
+    if (content_.erase(index_path))
+    {
+        invalidate();
+    }
 }
 
 const TreeIndex::Content& TreeIndex::content() const
 {
+    expand();
     return content_;
 }
 
 const Asset& TreeIndex::self() const
 {
-    std::ostringstream os;
-    store(os);
-    self_ = Asset::create_for(os.str());
+    if (!self_valid_)
+    {
+        if (layout_ == Layout_tree)
+        {
+            MerkleTree::build(content_, content_attributes_, directory_objects_, directory_ids_);
+        }
+
+        self_data_.clear();
+        store_binary(self_data_);
+        self_ = Asset::create_for(self_data_);
+        self_valid_ = true;
+    }
     return self_;
 }
 
+const AssetId& TreeIndex::id() const
+{
+    return self().id();
+}
+
+void TreeIndex::invalidate()
+{
+    // Content of the not expanded index is lost with the directory ids.
+    expand();
+
+    self_valid_ = false;
+    directory_objects_.clear();
+    directory_ids_.clear();
+}
+
+TreeIndex::Layout TreeIndex::layout() const
+{
+    return layout_;
+}
+
+void TreeIndex::set_layout(Layout layout)
+{
+    if (layout_ != layout)
+    {
+        layout_ = layout;
+        invalidate();
+    }
+}
+
+void TreeIndex::expand() const
+{
+    if (!expand_storage_)
+    {
+        return;
+    }
+
+    Content             content;
+    ContentAttributes   content_attributes;
+    DirectoryIds        ids;
+
+    MerkleTree::expand(expand_storage_, directory_ids_.at(MerkleTree::root), content, content_attributes, ids);
+
+    content_.swap(content);
+    content_attributes_.swap(content_attributes);
+    directory_ids_.swap(ids);
+    expand_storage_.reset();
+}
+
+const AssetId *TreeIndex::root_directory_id() const
+{
+    if (layout_ != Layout_tree || !self_valid_)
+    {
+        return 0;
+    }
+
+    DirectoryIds::const_iterator i = directory_ids_.find(MerkleTree::root);
+    return i != directory_ids_.end() ? &i->second : 0;
+}
+
+const TreeIndex::DirectoryIds *TreeIndex::directory_ids() const
+{
+    expand();
+
+    if (layout_ == Layout_tree && self_valid_ && !directory_ids_.empty())
+    {
+        return &directory_ids_;
+    }
+    return 0;
+}
+
 const Asset& TreeIndex::parent() const
 {
     return parent_;
@@ -130,11 +247,13 @@ const Asset& TreeIndex::parent() const
 void TreeIndex::set_parent(const Asset& parent)
 {
     parent_ = parent;
+    invalidate();
 }
 
 void TreeIndex::set_(const std::string& attribute, const std::string& value)
 {
     attributes_[attribute] = value;
+    invalidate();
 }
 
 bool TreeIndex::contains_(const std::string& attribute) const
@@ -166,6 +285,8 @@ std::string TreeIndex::get_(const std::string& attribute, const std::string& def
 
 void TreeIndex::set_attr_(const std::string& index_path, const std::string& attribute, const std::string& value)
 {
+    expand();
+
     ContentAttributes::iterator objs_attrs_iter = content_attributes_.find(index_path);
 
     if (objs_attrs_iter == content_attributes_.end())
@@ -188,10 +309,13 @@ void TreeIndex::set_attr_(const std::string& index_path, const std::string& attr
     }
 
     objs_attrs_iter->second[attribute] = value;
+    invalidate();
 }
 
 std::string TreeIndex::get_attr_(const std::string& index_path, const std::string& attribute, const std::string& default_value) const
 {
+    expand();
+
     ContentAttributes::const_iterator objs_attrs_iter = content_attributes_.find(index_path);
 
     if (objs_attrs_iter == content_attributes_.end())
@@ -213,11 +337,15 @@ std::string TreeIndex::get_attr_(const std::string& index_path, const std::strin
 
 void TreeIndex::set_attrs_(const std::string& index_path, const TreeIndex::Attributes& attrs)
 {
+    expand();
     content_attributes_[index_path] = attrs;
+    invalidate();
 }
 
 boost::optional<TreeIndex::Attributes> TreeIndex::get_attrs_(const std::string& index_path) const
 {
+    expand();
+
     ContentAttributes::const_iterator objs_attrs_iter = content_attributes_.find(index_path);
 
     if (objs_attrs_iter == content_attributes_.end())
@@ -235,15 +363,47 @@ struct SerializationConstants {
     static const std::string attributes;
     static const std::string content;
     static const std::string content_attributes;
+    static const std::string id_algorithm;
 };
 
 const std::string SerializationConstants::parent                = "parent";
 const std::string SerializationConstants::attributes            = "attributes";
 const std::string SerializationConstants::content               = "content";
 const std::string SerializationConstants::content_attributes    = "content_attributes";
+const std::string SerializationConstants::id_algorithm          = "id_algorithm";
+
+TreeIndex::Attributes TreeIndex::stored_attributes() const
+{
+    Attributes result = attributes_;
+    if (AssetId::algorithm() != AssetId::Algorithm_sha256)
+    {
+        result[SerializationConstants::id_algorithm] = AssetId::algorithm_name(AssetId::algorithm());
+    }
+    return result;
+}
+
+/*static*/ void TreeIndex::check_id_algorithm(Attributes& attributes)
+{
+    AssetId::Algorithm algorithm = AssetId::Algorithm_sha256;
+
+    Attributes::iterator i = attributes.find(SerializationConstants::id_algorithm);
+    if (i != attributes.end())
+    {
+        algorithm = AssetId::algorithm_for(i->second);
+        attributes.erase(i);
+    }
+
+    if (algorithm != AssetId::algorithm())
+    {
+        LOGE << "Index ids algorithm " << AssetId::algorithm_name(algorithm)
+             << " differs from the repository one " << AssetId::algorithm_name(AssetId::algorithm()) << "!" << ELOG;
+
+        throw errors::index_id_algorithm_mismatch();
+    }
+}
 
 // Serialization methods.
-void TreeIndex::store(std::ostream& os) const
+void TreeIndex::store_json(std::ostream& os) const
 {
     pt::ptree tree;
     pt::ptree parent;
@@ -251,6 +411,8 @@ void TreeIndex::store(std::ostream& os) const
     pt::ptree objects_attributes;
     pt::ptree attributes;
 
+    expand();
+
     Asset::store(parent, parent_);
 
     for (Content::const_iterator i = content_.begin(), end = content_.end(); i != end; ++i)
@@ -260,7 +422,8 @@ void TreeIndex::store(std::ostream& os) const
         content.insert(content.end(), std::make_pair(i->first, item));
     }
 
-    for (Attributes::const_iterator i = attributes_.begin(), end = attributes_.end(); i != end; ++i)
+    Attributes index_attributes = stored_attributes();
+    for (Attributes::const_iterator i = index_attributes.begin(), end = index_attributes.end(); i != end; ++i)
     {
         attributes.insert(attributes.end(), std::make_pair(i->first, pt::ptree(i->second)));
     }
@@ -284,7 +447,7 @@ void TreeIndex::store(std::ostream& os) const
     //pt::write_json(os, tree, true);
 }
 
-/*static*/ TreeIndex::Ptr TreeIndex::load(std::istream& is, IObjectsStorage::Ptr storage)
+/*static*/ TreeIndex::Ptr TreeIndex::load_json(std::istream& is, IObjectsStorage::Ptr storage)
 {
     TreeIndex::Ptr result(new TreeIndex());
 
@@ -318,12 +481,261 @@ void TreeIndex::store(std::ostream& os) const
     return result;
 }
 
+namespace binary_format {
+
+    struct F {
+        static const char       magic[4];
+        static const uint32_t   version;        //!< Flat layout index.
+        static const uint32_t   version_tree;   //!< Tree layout index.
+    };
+
+    /*static*/ const char       F::magic[4]     = { 'P', 'T', 'R', 'E' };
+    /*static*/ const uint32_t   F::version      = 1;
+    /*static*/ const uint32_t   F::version_tree = 2;
+
+    Asset asset_for(const AssetId& id, const IObjectsStorage::Ptr& storage)
+    {
+        if (storage.get() != 0)
+        {
+            return Asset::create_for(storage, id);
+        }
+        else
+        {
+            return Asset::create_id(id);
+        }
+    }
+
+    bool is_binary(const char *data, std::size_t size)
+    {
+        return size >= sizeof(F::magic) && std::memcmp(data, F::magic, sizeof(F::magic)) == 0;
+    }
+
+} // namespace binary_format
+
+void TreeIndex::store_binary(std::string& out) const
+{
+    using namespace binary_format;
+
+    binaryio::Writer w(out);
+
+    w.bytes(F::magic, sizeof(F::magic));
+    w.u32(layout_ == Layout_tree ? F::version_tree : F::version);
+
+    w.id(parent_.id());
+
+    Attributes attributes = stored_attributes();
+    w.varint(attributes.size());
+    for (Attributes::const_iterator i = attributes.begin(), end = attributes.end(); i != end; ++i)
+    {
+        w.string(i->first);
+        w.string(i->second);
+    }
+
+    if (layout_ == Layout_tree)
+    {
+        // Content is stored in the directory objects.
+        w.id(directory_ids_.at(MerkleTree::root));
+        return;
+    }
+
+    std::string previous;
+    w.varint(content_.size());
+    for (Content::const_iterator i = content_.begin(), end = content_.end(); i != end; ++i)
+    {
+        w.path(i->first, previous);
+        w.id(i->second.id());
+    }
+
+    // Content attributes names are interned: table of the names, then indexes.
+    std::map<std::string, uint64_t> names;
+    std::vector<const std::string*> names_table;
+    for (ContentAttributes::const_iterator i = content_attributes_.begin(), end = content_attributes_.end(); i != end; ++i)
+    {
+        for (Attributes::const_iterator j = i->second.begin(), end2 = i->second.end(); j != end2; ++j)
+        {
+            if (names.insert(std::make_pair(j->first, names_table.size())).second)
+            {
+                names_table.push_back(&j->first);
+            }
+        }
+    }
+
+    w.varint(names_table.size());
+    for (std::vector<const std::string*>::const_iterator i = names_table.begin(), end = names_table.end(); i != end; ++i)
+    {
+        w.string(**i);
+    }
+
+    previous.clear();
+    w.varint(content_attributes_.size());
+    for (ContentAttributes::const_iterator i = content_attributes_.begin(), end = content_attributes_.end(); i != end; ++i)
+    {
+        w.path(i->first, previous);
+        w.varint(i->second.size());
+        for (Attributes::const_iterator j = i->second.begin(), end2 = i->second.end(); j != end2; ++j)
+        {
+            w.varint(names[j->first]);
+            w.string(j->second);
+        }
+    }
+}
+
+/*static*/ TreeIndex::Ptr TreeIndex::load_binary(const char *data, std::size_t size, IObjectsStorage::Ptr storage)
+{
+    using namespace binary_format;
+
+    TreeIndex::Ptr result(new TreeIndex());
+
+    binaryio::Reader<errors::corrupted_binary_index> r(data, size);
+
+    r.bytes(sizeof(F::magic));
+    uint32_t version = r.u32();
+    if (version != F::version && version != F::version_tree)
+    {
+        LOGF << "Unsupported binary index version!" << ELOG;
+
+        throw errors::corrupted_binary_index();
+    }
+
+    result->parent_ = asset_for(r.id(), storage);
+
+    for (uint64_t i = 0, count = r.varint(); i < count; ++i)
+    {
+        std::string name = r.string();
+        result->attributes_.insert(result->attributes_.end(), std::make_pair(name, r.string()));
+    }
+
+    if (version == F::version_tree)
+    {
+        AssetId root = r.id();
+        if (!r.at_end())
+        {
+            throw errors::corrupted_binary_index();
+        }
+
+        if (!storage)
+        {
+            LOGF << "Storage is required to load tree layout index!" << ELOG;
+
+            throw errors::unable_to_load_directory_object();
+        }
+
+        // Directory objects are read on the first access to the content.
+        result->layout_ = Layout_tree;
+        result->directory_ids_.insert(std::make_pair(MerkleTree::root, root));
+        result->expand_storage_ = storage;
+        return result;
+    }
+
+    std::string path;
+    for (uint64_t i = 0, count = r.varint(); i < count; ++i)
+    {
+        r.path(path);
+        result->content_.insert(result->content_.end(), std::make_pair(path, asset_for(r.id(), storage)));
+    }
+
+    std::vector<std::string> names_table;
+    for (uint64_t i = 0, count = r.varint(); i < count; ++i)
+    {
+        names_table.push_back(r.string());
+    }
+
+    path.clear();
+    for (uint64_t i = 0, count = r.varint(); i < count; ++i)
+    {
+        r.path(path);
+
+        Attributes& attrs = result->content_attributes_.insert(result->content_attributes_.end(),
+                std::make_pair(path, Attributes()))->second;
+
+        for (uint64_t j = 0, attrs_count = r.varint(); j < attrs_count; ++j)
+        {
+            uint64_t name = r.varint();
+            if (name >= names_table.size())
+            {
+                throw errors::corrupted_binary_index();
+            }
+            attrs.insert(attrs.end(), std::make_pair(names_table[name], r.string()));
+        }
+    }
+
+    if (!r.at_end())
+    {
+        throw errors::corrupted_binary_index();
+    }
+
+    return result;
+}
+
+/*static*/ TreeIndex::Ptr TreeIndex::load_data(std::string& data, IObjectsStorage::Ptr storage)
+{
+    TreeIndex::Ptr result;
+
+    if (binary_format::is_binary(data.data(), data.size()))
+    {
+        result = load_binary(data.data(), data.size(), storage);
+    }
+    else
+    {
+        std::istringstream is(data);
+        result = load_json(is, storage);
+    }
+
+    check_id_algorithm(result->attributes_);
+
+    // Loaded index keeps the original data, so its id is stable whatever
+    // format it was stored in.
+    result->self_data_.swap(data);
+    result->self_ = Asset::create_for(result->self_data_);
+    result->self_valid_ = true;
+
+    return result;
+}
+
+/*static*/ TreeIndex::Ptr TreeIndex::load(const char *data, std::size_t size, IObjectsStorage::Ptr storage)
+{
+    std::string copy(data, size);
+    return load_data(copy, storage);
+}
+
+void TreeIndex::store(std::ostream& os) const
+{
+    self();
+    os.write(self_data_.data(), self_data_.size());
+}
+
+/*static*/ TreeIndex::Ptr TreeIndex::load(std::istream& is, IObjectsStorage::Ptr storage)
+{
+    std::string data((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+    return load_data(data, storage);
+}
+
+/*static*/ TreeIndex::Ptr TreeIndex::load(const boost::filesystem::path& index_file, IObjectsStorage::Ptr storage)
+{
+    // The index keeps its data, so the file is read directly into the buffer the
+    //index takes over.
+    std::string data(fs::file_size(index_file), '\0');
+
+    std::ifstream is(index_file.c_str(), std::ifstream::in|std::ifstream::binary);
+    if (!is.read(&data[0], data.size()))
+    {
+        LOGF << "Unable to read index file: " << index_file << ELOG;
+
+        throw errors::corrupted_binary_index();
+    }
+
+    return load_data(data, storage);
+}
+
 /*static*/ TreeIndex::Ptr TreeIndex::load(const Asset& asset, IObjectsStorage::Ptr storage)
 {
     boost::shared_ptr<std::istream> pis = asset.istream();
     if (pis)
     {
-        return load(*pis, storage);
+        TreeIndex::Ptr result = load(*pis, storage);
+        // Index asset id is already known.
+        result->self_ = asset;
+        return result;
     }
     else
     {
@@ -350,18 +762,53 @@ void TreeIndex::store(std::ostream& os) const
 // Get all assets including Index asset. Method will be used by storage.
 std::set<Asset> TreeIndex::assets() const
 {
+    expand();
+
     std::set<Asset> result;
     for (Content::const_iterator i = content_.begin(), end = content_.end(); i != end; ++i)
     {
         result.insert(i->second);
     }
     result.insert(self());
+
+    if (layout_ == Layout_tree)
+    {
+        // Loaded indexes have only directory ids, objects are built on demand.
+        if (directory_objects_.empty())
+        {
+            DirectoryIds ids;
+            MerkleTree::build(content_, content_attributes_, directory_objects_, ids);
+        }
+
+        for (Content::const_iterator i = directory_objects_.begin(), end = directory_objects_.end(); i != end; ++i)
+        {
+            result.insert(i->second);
+        }
+    }
+
     return result;
 }
 
+void TreeIndex::ingest_into(const IObjectsStorage::Ptr& storage)
+{
+    expand();
+
+    for (Content::iterator i = content_.begin(), end = content_.end(); i != end; ++i)
+    {
+        if (!i->second.id_calculated())
+        {
+            i->second = Asset::create_for(storage, storage->ingest(i->second));
+            invalidate();
+        }
+    }
+    storage->put(assets());
+}
+
 // Get asset by path
 boost::optional<Asset> TreeIndex::asset(const std::string& index_path) const
 {
+    expand();
+
     if (content_.find(index_path) != content_.end())
     {
         return content_.at(index_path);
@@ -375,6 +822,8 @@ boost::optional<Asset> TreeIndex::asset(const std::string& index_path) const
 // Get all paths
 std::set<std::string> TreeIndex::index_paths() const
 {
+    expand();
+
     std::set<std::string> result;
     for (Content::const_iterator i = content_.begin(), end = content_.end(); i != end; ++i)
     {
@@ -434,4 +883,18 @@ std::set<std::string> TreeIndex::index_paths() const
     index->set_attr_(index_path, PredefinedAttributes::asset_mode, format_asset_mode(entry->attributes().mode()));
 }
 
+/*static*/ void PredefinedAttributes::fill_symlink_attrs(TreeIndex::Ptr& index, const std::string& index_path, int mode)
+{
+    index->set_attr_(index_path, PredefinedAttributes::asset_type, PredefinedAttributes::asset_type__symlink);
+
+    index->set_attr_(index_path, PredefinedAttributes::asset_mode, format_asset_mode(mode));
+}
+
+/*static*/ void PredefinedAttributes::fill_file_attrs(TreeIndex::Ptr& index, const std::string& index_path, int mode)
+{
+    index->set_attr_(index_path, PredefinedAttributes::asset_type, PredefinedAttributes::asset_type__file);
+
+    index->set_attr_(index_path, PredefinedAttributes::asset_mode, format_asset_mode(mode));
+}
+
 } } // namespace piel::lib
@@ -42,6 +42,8 @@ namespace errors {
     struct unable_to_get_path_attributes_map {};
     struct index_has_several_equals_paths {};
     struct attempt_to_add_empty_asset_into_index {};
+    struct corrupted_binary_index {};
+    struct index_id_algorithm_mismatch {};
 };
 
 class IndexesDiff;
@@ -54,6 +56,13 @@ public:
     typedef std::map<std::string, Asset> Content;
     typedef std::map<std::string, std::string> Attributes;
     typedef std::map<std::string, Attributes> ContentAttributes;
+    typedef std::map<std::string, AssetId> DirectoryIds;
+
+    //! Content representation in the stored index.
+    enum Layout {
+        Layout_flat,    //!< All paths are stored in the index object.
+        Layout_tree,    //!< Each directory is stored as separate object (see MerkleTree).
+    };
 
     TreeIndex();
     ~TreeIndex();
@@ -65,11 +74,21 @@ public:
 
     const Content& content() const;
 
+    //! Index asset. Serialized form is cached until the next index modification.
     const Asset& self() const;
+    //! Index id. Cached as self().
+    const AssetId& id() const;
     const Asset& parent() const;
 
     void set_parent(const Asset& parent);
 
+    Layout layout() const;
+    void set_layout(Layout layout);
+
+    //! Directory ids of the tree layout index (see MerkleTree). Available for the
+    //!loaded or already stored not modified indexes, otherwise 0.
+    const DirectoryIds *directory_ids() const;
+
     void set_(const std::string& attribute, const std::string& value);
     bool contains_(const std::string& attribute) const;
     std::string get_(const std::string& attribute, const std::string& default_value = std::string()) const;
@@ -98,6 +117,10 @@ public:
     // Get all assets including Index asset. Method will be used by storage.
     std::set<Asset> assets() const;
 
+    // Put all assets including Index asset into storage. Content assets with not yet
+    //calculated ids are ingested by storage in one pass and replaced by the stored ones.
+    void ingest_into(const IObjectsStorage::Ptr& storage);
+
     // Get asset by path
     boost::optional<Asset> asset(const std::string& index_path) const;
 
@@ -107,27 +130,65 @@ public:
     // Check if index is empty
     bool empty() const;
 
-    // Serialization methods.
+    // Serialization methods. Indexes are stored in the versioned binary format.
+    //Loaded indexes keep the data they were loaded from, so store() of the not
+    //modified index produces the same data (and id) in either format.
     void store(std::ostream& os) const;
+    // Store index in the legacy JSON format. Both formats are accepted by load().
+    void store_json(std::ostream& os) const;
     static TreeIndex::Ptr load(std::istream& is, IObjectsStorage::Ptr storage = IObjectsStorage::Ptr());
     static TreeIndex::Ptr load(const Asset& asset, IObjectsStorage::Ptr storage = IObjectsStorage::Ptr());
+    // Load index from the file.
+    static TreeIndex::Ptr load(const boost::filesystem::path& index_file, IObjectsStorage::Ptr storage = IObjectsStorage::Ptr());
+    static TreeIndex::Ptr load(const char *data, std::size_t size, IObjectsStorage::Ptr storage = IObjectsStorage::Ptr());
     static TreeIndex::Ptr from_ref(const IObjectsStorage::Ptr& storage, const std::string& ref);
 
     // Helper for access to asset id representation
     inline std::string str_id()
     {
-        return self().id().string();
+        return id().string();
     }
 
+private:
+    //! Drop cached self asset. Must be called by all modifying methods.
+    void invalidate();
+
+    //! Read the content of the loaded tree layout index from its directory objects.
+    //!Loading reads only the index object, so the indexes what are only compared by
+    //!ids or used for the history never read the directory objects.
+    void expand() const;
+    //! Root directory id of the loaded or stored not modified tree layout index,
+    //!otherwise 0. Doesn't expand the index.
+    const AssetId *root_directory_id() const;
+
+    //! Attributes to store. Ids algorithm is recorded as the attribute if it is not
+    //!the default one, so the SHA-256 indexes are stored as before.
+    Attributes stored_attributes() const;
+    //! Remove ids algorithm record from the loaded attributes and check it
+    //!against the current one.
+    static void check_id_algorithm(Attributes& attributes);
+
+    void store_binary(std::string& out) const;
+    //! Load index from the data. Index takes over the data, so it is left empty.
+    static TreeIndex::Ptr load_data(std::string& data, IObjectsStorage::Ptr storage);
+    static TreeIndex::Ptr load_binary(const char *data, std::size_t size, IObjectsStorage::Ptr storage);
+    static TreeIndex::Ptr load_json(std::istream& is, IObjectsStorage::Ptr storage);
+
 private:
     friend class        IndexesDiff;
     friend class        TreeIndexEnumerator;
 
     mutable Asset       self_;
+    mutable bool        self_valid_;
+    mutable std::string self_data_;
+    Layout              layout_;
+    mutable Content     directory_objects_;
+    mutable DirectoryIds directory_ids_;
     Asset               parent_;
-    Content             content_;
+    mutable Content     content_;
     Attributes          attributes_;
-    ContentAttributes   content_attributes_;
+    mutable ContentAttributes content_attributes_;
+    mutable IObjectsStorage::Ptr expand_storage_;  //!< Storage to expand the loaded tree layout index from.
 
 };
 
@@ -151,6 +212,8 @@ struct PredefinedAttributes {
     static void fill_symlink_attrs(TreeIndex::Ptr& index, const std::string& index_path, boost::shared_ptr<ZipEntry> entry);
     static void fill_file_attrs(TreeIndex::Ptr& index, const std::string& index_path, const boost::filesystem::path& file_path);
     static void fill_file_attrs(TreeIndex::Ptr& index, const std::string& index_path, boost::shared_ptr<ZipEntry> entry);
+    static void fill_symlink_attrs(TreeIndex::Ptr& index, const std::string& index_path, int mode);
+    static void fill_file_attrs(TreeIndex::Ptr& index, const std::string& index_path, int mode);
 
 };
 
@@ -28,12 +28,16 @@
 
 #include <workingcopy.h>
 #include <fsindexer.h>
+#include <packeddirectorystorage.h>
+#include <layeredstorage.h>
 #include <boost_filesystem_ext.hpp>
 #include <logging.h>
 
 #include <checkout.h>
 #include <assetsextractor.h>
 
+#include <boost/algorithm/string.hpp>
+
 namespace piel { namespace lib {
 
 namespace fs = boost::filesystem;
@@ -47,6 +51,8 @@ namespace layout {
         static const std::string current_tree_index_file;
         static const std::string config_file;
         static const std::string archives_dir;
+        static const std::string stat_cache_file;
+        static const std::string id_algorithm_file;
     };
 
     /*static*/ const std::string L::metadata_dir            = ".pie";
@@ -55,6 +61,34 @@ namespace layout {
     /*static*/ const std::string L::current_tree_index_file = "index.json";
     /*static*/ const std::string L::config_file             = "config.properties";
     /*static*/ const std::string L::archives_dir            = "archives";
+    /*static*/ const std::string L::stat_cache_file         = "stat_cache";
+    /*static*/ const std::string L::id_algorithm_file       = "id_algorithm";
+
+};
+
+namespace constants {
+
+    struct C {
+        static const std::string storage_format;
+        static const std::string storage_format__packed;
+        static const std::string index_layout;
+        static const std::string index_layout__tree;
+        static const std::string object_compression;
+        static const std::string object_chunking;
+        static const std::string shared_storages;
+        static const std::string shared_storages_delimiter;
+        static const std::string promote_shared_objects;
+    };
+
+    /*static*/ const std::string C::storage_format          = "storage_format";
+    /*static*/ const std::string C::storage_format__packed  = "packed";
+    /*static*/ const std::string C::index_layout            = "index_layout";
+    /*static*/ const std::string C::index_layout__tree      = "tree";
+    /*static*/ const std::string C::object_compression      = "object_compression";
+    /*static*/ const std::string C::object_chunking         = "object_chunking";
+    /*static*/ const std::string C::shared_storages         = "shared_storages";
+    /*static*/ const std::string C::shared_storages_delimiter = ":";
+    /*static*/ const std::string C::promote_shared_objects  = "promote_shared_objects";
 
 };
 
@@ -95,7 +129,7 @@ void WorkingCopy::init_storages(const std::string reference)
 {
     init_local_storage();
     local_storage()->put(current_tree_index_->assets());
-    local_storage()->create_reference(refs::Ref(reference, current_tree_index_->self().id()));
+    local_storage()->create_reference(refs::Ref(reference, current_tree_index_->id()));
 }
 
 void WorkingCopy::attach_storages()
@@ -105,7 +139,74 @@ void WorkingCopy::attach_storages()
 
 void WorkingCopy::init_local_storage()
 {
-    storages_[local_storage_index] = IObjectsStorage::Ptr(new LocalDirectoryStorage(storage_dir_));
+    boost::shared_ptr<LocalDirectoryStorage> storage;
+    if (PackedDirectoryStorage::is_packed(storage_dir_) ||
+            config_.get(constants::C::storage_format, std::string()) == constants::C::storage_format__packed)
+    {
+        LOGT << "Packed local storage: " << storage_dir_ << ELOG;
+        storage = boost::shared_ptr<LocalDirectoryStorage>(new PackedDirectoryStorage(storage_dir_));
+    }
+    else
+    {
+        storage = boost::shared_ptr<LocalDirectoryStorage>(new LocalDirectoryStorage(storage_dir_));
+    }
+
+    storage->set_compression(ObjectCompression::method_for(config_.get(constants::C::object_compression, std::string())));
+    storage->set_chunking(ObjectChunks::chunking_for(config_.get(constants::C::object_chunking, std::string())));
+
+    storages_.resize(local_storage_index + 1);
+    storages_[local_storage_index] = storage;
+
+    std::string shared_storages = config_.get(constants::C::shared_storages, std::string());
+    if (shared_storages.empty())
+    {
+        return;
+    }
+
+    // Local storage is the first layer, so the shared storages are looked up only for missing objects.
+    boost::shared_ptr<LayeredStorage> layered(new LayeredStorage(storage));
+    layered->set_promotion(config_.get(constants::C::promote_shared_objects, std::string()) == "true");
+
+    std::vector<std::string> dirs;
+    boost::split(dirs, shared_storages, boost::is_any_of(constants::C::shared_storages_delimiter));
+    for (std::vector<std::string>::const_iterator i = dirs.begin(), end = dirs.end(); i != end; ++i)
+    {
+        if (i->empty())
+        {
+            continue;
+        }
+
+        fs::path shared_dir(*i);
+        if (!fs::is_directory(shared_dir))
+        {
+            LOGW << "Skip missing shared storage: " << shared_dir << ELOG;
+            continue;
+        }
+
+        if (load_id_algorithm(shared_dir) != AssetId::algorithm())
+        {
+            LOGW << "Skip shared storage with different ids algorithm: " << shared_dir << ELOG;
+            continue;
+        }
+
+        // Shared storages are opened read only: they are never initialized, migrated or written.
+        IObjectsStorage::Ptr shared;
+        if (PackedDirectoryStorage::is_packed(shared_dir))
+        {
+            shared = IObjectsStorage::Ptr(new PackedDirectoryStorage(shared_dir, true));
+        }
+        else
+        {
+            shared = IObjectsStorage::Ptr(new LocalDirectoryStorage(shared_dir, true));
+        }
+
+        LOGT << "Shared storage: " << shared_dir << ELOG;
+
+        layered->add_layer(shared);
+        storages_.push_back(shared);
+    }
+
+    storages_[local_storage_index] = layered;
 }
 
 IObjectsStorage::Ptr WorkingCopy::local_storage() const
@@ -113,7 +214,7 @@ IObjectsStorage::Ptr WorkingCopy::local_storage() const
     return storages_[local_storage_index];
 }
 
-void WorkingCopy::init_filesystem(const std::string reference)
+void WorkingCopy::init_filesystem(const std::string reference, AssetId::Algorithm id_algorithm)
 {
     if (!fs::create_directories(metadata_dir_) || !fs::create_directories(storage_dir_))
     {
@@ -125,6 +226,10 @@ void WorkingCopy::init_filesystem(const std::string reference)
         throw errors::init_existing_working_copy();
     }
 
+    // All ids including the initial index one are calculated by the repository algorithm.
+    AssetId::set_algorithm(id_algorithm);
+    *boost::filesystem::ostream(storage_dir_ / layout::L::id_algorithm_file) << AssetId::algorithm_name(id_algorithm) << std::endl;
+
     current_tree_index_->initial_for(reference);
     setup_current_tree(reference, current_tree_index_);
 
@@ -155,15 +260,30 @@ void WorkingCopy::attach_filesystem()
         config_ = Properties::load(*boost::filesystem::istream(config_file_));
     }
 
+    AssetId::set_algorithm(load_id_algorithm(storage_dir_));
+
     attach_storages();
 
     // Load reference index
     if (fs::exists(current_tree_index_file_))
     {
-        current_tree_index_ = TreeIndex::load(*boost::filesystem::istream(current_tree_index_file_), local_storage());
+        current_tree_index_ = TreeIndex::load(current_tree_index_file_, local_storage());
     }
 }
 
+/*static*/ AssetId::Algorithm WorkingCopy::load_id_algorithm(const boost::filesystem::path& storage_dir)
+{
+    fs::path id_algorithm_file = storage_dir / layout::L::id_algorithm_file;
+    if (!fs::exists(id_algorithm_file))
+    {
+        return AssetId::Algorithm_sha256;
+    }
+
+    std::string name;
+    std::getline(*boost::filesystem::istream(id_algorithm_file), name);
+    return AssetId::algorithm_for(name);
+}
+
 fs::path WorkingCopy::working_dir() const
 {
     return working_dir_;
@@ -216,13 +336,26 @@ TreeIndex::Ptr WorkingCopy::current_tree_state() const
 
 TreeIndex::Ptr WorkingCopy::working_dir_state() const
 {
-    return FsIndexer::build(working_dir_, metadata_dir_);
+    StatCache stat_cache(metadata_dir_ / layout::L::stat_cache_file);
+    stat_cache.load();
+
+    TreeIndex::Ptr result = FsIndexer::build(working_dir_, metadata_dir_, stat_cache);
+    if (config_.get(constants::C::index_layout, std::string()) == constants::C::index_layout__tree)
+    {
+        result->set_layout(TreeIndex::Layout_tree);
+    }
+
+    LOGT << "Stat cache hits: " << stat_cache.hits() << " misses: " << stat_cache.misses() << ELOG;
+
+    stat_cache.save();
+    return result;
 }
 
-/*static*/ WorkingCopy::Ptr WorkingCopy::init(const boost::filesystem::path& working_dir, const std::string reference)
+/*static*/ WorkingCopy::Ptr WorkingCopy::init(const boost::filesystem::path& working_dir, const std::string reference,
+        AssetId::Algorithm id_algorithm)
 {
     WorkingCopy::Ptr result(new WorkingCopy(working_dir));
-    result->init_filesystem(reference);
+    result->init_filesystem(reference, id_algorithm);
     return result;
 }
 
@@ -284,7 +417,7 @@ std::string WorkingCopy::get_config(const std::string& name, const std::string&
 void WorkingCopy::set_current_tree_state(const TreeIndex::Ptr& new_current_tree_index)
 {
     new_current_tree_index->store(*boost::filesystem::ostream(current_tree_index_file_));
-    current_tree_index_ = TreeIndex::load(*boost::filesystem::istream(current_tree_index_file_), local_storage());
+    current_tree_index_ = TreeIndex::load(current_tree_index_file_, local_storage());
 }
 
 std::string WorkingCopy::current_tree_name() const
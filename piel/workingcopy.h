@@ -69,12 +69,18 @@ public:
 
     bool is_valid() const;
 
-    static Ptr init(const boost::filesystem::path& working_dir, const std::string reference);
+    //! Initialize working copy.
+    //! \param id_algorithm Algorithm of the repository asset ids. It is recorded in the local
+    //!        storage and selected by the each next attach.
+    static Ptr init(const boost::filesystem::path& working_dir, const std::string reference,
+            AssetId::Algorithm id_algorithm = AssetId::Algorithm_sha256);
     static Ptr attach(const boost::filesystem::path& working_dir);
 
     void set_config(const std::string& name, const std::string& value);
     std::string get_config(const std::string& name, const std::string& default_value = std::string());
 
+    //! Open local storage. If "shared_storages" config is set, local storage is chained with
+    //! the listed storage directories and the storages chain is used as the local storage.
     void init_local_storage();
     IObjectsStorage::Ptr local_storage() const;
     boost::filesystem::path working_dir() const;
@@ -100,10 +106,12 @@ protected:
     void set_current_tree_state(const TreeIndex::Ptr& new_tree_index);
 
 private:
-    void init_filesystem(const std::string reference);
+    void init_filesystem(const std::string reference, AssetId::Algorithm id_algorithm);
     void init_storages(const std::string reference);
     void attach_filesystem();
     void attach_storages();
+    //! Read ids algorithm record, storages without record use SHA-256.
+    static AssetId::Algorithm load_id_algorithm(const boost::filesystem::path& storage_dir);
 
 private:
     boost::filesystem::path working_dir_;                       //!< Working copy filesystem directory.
@@ -235,6 +235,8 @@ protected:
     //with the entries data must be accesible by ZipEntry instance only.
     friend struct ZipEntry;
     friend struct ZipSource;
+    // Importer reads the central directory by the entries indices.
+    friend class ZipImporter;
 
     //! Low level api. Open libzip zip_file_t handle by entry name.
     //! \param entry_name Archive entry name.
@@ -366,11 +368,12 @@ struct ZipEntry {
         return attrs.symlink();
     }
 
-    //! Check if the entry is directory.
+    //! Check if the entry is directory. Directories written without attributes
+    //!are recognized by the trailing '/' of the name.
     //! \return true if the entry is directory, false otherwise.
     bool dir() const {
         ZipEntryAttributes attrs = attributes();
-        return attrs.dir();
+        return attrs.dir() || (!name_.empty() && *name_.rbegin() == '/');
     }
 
     //! Read symlink target.
@@ -0,0 +1,386 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <zipimporter.h>
+#include <zipfile.h>
+#include <logging.h>
+#include <blake3.h>
+
+#include <boost/bind.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread.hpp>
+
+#include <deque>
+#include <exception>
+#include <fstream>
+
+namespace piel { namespace lib {
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+    struct C {
+        static const zip_uint64_t   spill_size;             //!< Entries larger than this are inflated into the temporary files.
+        static const std::size_t    buffer_size;
+    };
+
+    /*static*/ const zip_uint64_t   C::spill_size   = 4 * 1024 * 1024;
+    /*static*/ const std::size_t    C::buffer_size  = 64 * 1024;
+
+    //! Entry inflated by the worker.
+    struct InflateJob {
+        InflateJob()
+            : index(0)
+            , size(0)
+            , spill_path()
+            , data()
+            , done(false)
+            , error()
+        {
+        }
+
+        zip_uint64_t                index;
+        zip_uint64_t                size;
+        fs::path                    spill_path;         //!< Inflated data of the large entry, empty for the small ones.
+        std::string                 data;               //!< Inflated data of the small entry.
+        bool                        done;
+        std::exception_ptr          error;
+    };
+
+    //! Jobs queue of the inflating workers.
+    class InflateQueue {
+    public:
+        InflateQueue()
+            : closed_(false)
+        {
+        }
+
+        void push(InflateJob *job)
+        {
+            boost::unique_lock<boost::mutex> lock(mutex_);
+            jobs_.push_back(job);
+            not_empty_.notify_one();
+        }
+
+        //! \return next job or null if the queue is closed and empty.
+        InflateJob *pop()
+        {
+            boost::unique_lock<boost::mutex> lock(mutex_);
+            while (jobs_.empty() && !closed_)
+            {
+                not_empty_.wait(lock);
+            }
+
+            if (jobs_.empty())
+            {
+                return 0;
+            }
+
+            InflateJob *job = jobs_.front();
+            jobs_.pop_front();
+            return job;
+        }
+
+        void close()
+        {
+            boost::unique_lock<boost::mutex> lock(mutex_);
+            closed_ = true;
+            not_empty_.notify_all();
+        }
+
+        void finish(InflateJob *job)
+        {
+            boost::unique_lock<boost::mutex> lock(mutex_);
+            job->done = true;
+            done_.notify_all();
+        }
+
+        void wait(InflateJob *job)
+        {
+            boost::unique_lock<boost::mutex> lock(mutex_);
+            while (!job->done)
+            {
+                done_.wait(lock);
+            }
+        }
+
+    private:
+        bool                        closed_;
+        std::deque<InflateJob*>     jobs_;
+        boost::mutex                mutex_;
+        boost::condition_variable   not_empty_;
+        boost::condition_variable   done_;
+    };
+
+    //! Inflate job entry. Runs on the workers, so must not log.
+    void inflate_job(const ZipFile::FilePtr& zip, InflateJob *job)
+    {
+        ZipFile::EntryPtr entry = zip->entry(static_cast<zip_int64_t>(job->index));
+
+        boost::scoped_ptr<std::ofstream> spill;
+        if (!job->spill_path.empty())
+        {
+            spill.reset(new std::ofstream(job->spill_path.c_str(), std::ofstream::out|std::ofstream::binary|std::ofstream::trunc));
+        }
+        else
+        {
+            job->data.reserve(static_cast<std::size_t>(job->size));
+        }
+
+        std::vector<char> buffer(C::buffer_size);
+        zip_uint64_t total = 0;
+        zip_int64_t readed = 0;
+        while ((readed = entry->read(buffer.data(), static_cast<zip_int64_t>(buffer.size()))) > 0)
+        {
+            if (spill)
+            {
+                spill->write(buffer.data(), readed);
+            }
+            else
+            {
+                job->data.append(buffer.data(), static_cast<std::size_t>(readed));
+            }
+            total += static_cast<zip_uint64_t>(readed);
+        }
+
+        // Negative result means not opened entry or corrupted data.
+        if (readed < 0 || total != job->size || (spill && !spill->flush()))
+        {
+            throw errors::unable_to_inflate_zip_entry();
+        }
+    }
+
+    void inflate_worker(ZipFile::FilePtr zip, InflateQueue *queue)
+    {
+        Blake3Hasher::SerialScope serial_hashing;
+
+        for (InflateJob *job = queue->pop(); job; job = queue->pop())
+        {
+            try
+            {
+                inflate_job(zip, job);
+            }
+            catch (...)
+            {
+                job->error = std::current_exception();
+            }
+
+            queue->finish(job);
+        }
+    }
+
+    void release_job(InflateJob& job)
+    {
+        std::string().swap(job.data);
+        if (!job.spill_path.empty())
+        {
+            boost::system::error_code ec;
+            fs::remove(job.spill_path, ec);
+        }
+    }
+
+    ZipFile::FilePtr open_zip(const fs::path& zip_file)
+    {
+        ZipFile::FilePtr zip = ZipFile::open(zip_file.native());
+        if (zip->num_entries() < 0)
+        {
+            LOGE << "Unable to open zip archive: " << zip_file << ELOG;
+
+            throw errors::unable_to_open_zip();
+        }
+        return zip;
+    }
+
+} // namespace
+
+ZipImporter::ZipImporter(const IObjectsStorage::Ptr& storage, const boost::filesystem::path& temp_dir)
+    : storage_(storage)
+    , temp_dir_(temp_dir)
+    , threads_count_(1)
+{
+}
+
+ZipImporter::~ZipImporter()
+{
+}
+
+void ZipImporter::set_threads_count(unsigned int threads_count)
+{
+    threads_count_ = threads_count ? threads_count : std::max(1u, boost::thread::hardware_concurrency());
+}
+
+ZipImporter::Entries ZipImporter::read_entries(const boost::filesystem::path& zip_file) const
+{
+    ZipFile::FilePtr zip = open_zip(zip_file);
+
+    Entries result;
+    result.reserve(static_cast<std::size_t>(zip->num_entries()));
+
+    for (zip_int64_t i = 0, count = zip->num_entries(); i < count; ++i)
+    {
+        zip_stat_t          stat    = zip->stat(i);
+        ZipEntryAttributes  attrs   = zip->file_get_external_attributes(i);
+
+        if (attrs.dir() || !(stat.valid & ZIP_STAT_NAME))
+        {
+            continue;
+        }
+
+        Entry entry;
+        entry.index     = static_cast<zip_uint64_t>(i);
+        entry.name      = stat.name;
+        entry.size      = stat.size;
+        entry.mode      = attrs.mode();
+        entry.symlink   = attrs.symlink();
+
+        // Directories written without attributes.
+        if (!entry.name.empty() && *entry.name.rbegin() == '/')
+        {
+            continue;
+        }
+
+        result.push_back(entry);
+    }
+
+    return result;
+}
+
+TreeIndex::Ptr ZipImporter::import(const boost::filesystem::path& zip_file)
+{
+    Entries entries = read_entries(zip_file);
+    std::vector<InflateJob> jobs(entries.size());
+
+    LOGT << "Import " << entries.size() << " zip entries using " << threads_count_ << " threads." << ELOG;
+
+    // Each thread reads the archive by own handle, handles are opened here to log errors.
+    std::vector<ZipFile::FilePtr> zips;
+    for (unsigned int t = 0; t < threads_count_; ++t)
+    {
+        zips.push_back(open_zip(zip_file));
+    }
+
+    // Inflated entries waiting for the storing are bounded, so are the memory and temporary files.
+    std::size_t window = threads_count_ > 1 ? threads_count_ * 2 : 1;
+
+    InflateQueue queue;
+    boost::thread_group threads;
+    for (unsigned int t = 0; threads_count_ > 1 && t < threads_count_; ++t)
+    {
+        threads.create_thread(boost::bind(&inflate_worker, zips[t], &queue));
+    }
+
+    TreeIndex::Ptr result(new TreeIndex());
+    try
+    {
+        std::size_t submitted = 0;
+        for (std::size_t k = 0; k < jobs.size(); ++k)
+        {
+            for (; submitted < jobs.size() && submitted < k + window; ++submitted)
+            {
+                InflateJob& job = jobs[submitted];
+                job.index       = entries[submitted].index;
+                job.size        = entries[submitted].size;
+                if (job.size > C::spill_size)
+                {
+                    job.spill_path = temp_dir_ / fs::unique_path("pie-unzip-%%%%-%%%%-%%%%-%%%%");
+                }
+
+                if (threads_count_ > 1)
+                {
+                    queue.push(&job);
+                }
+            }
+
+            InflateJob& job = jobs[k];
+            if (threads_count_ > 1)
+            {
+                queue.wait(&job);
+            }
+            else
+            {
+                try
+                {
+                    inflate_job(zips[0], &job);
+                }
+                catch (...)
+                {
+                    job.error = std::current_exception();
+                }
+            }
+
+            const Entry& entry = entries[k];
+            if (job.error)
+            {
+                LOGE << "Unable to inflate zip entry: " << entry.name << ELOG;
+
+                std::rethrow_exception(job.error);
+            }
+
+            Asset data = job.spill_path.empty() ? Asset::create_for(job.data) : Asset::create_for(job.spill_path);
+            AssetId id = storage_->ingest(data);
+
+            if (result->insert_path(entry.name, Asset::create_for(storage_, id)))
+            {
+                if (entry.symlink)
+                {
+                    PredefinedAttributes::fill_symlink_attrs(result, entry.name, entry.mode);
+                }
+                else
+                {
+                    PredefinedAttributes::fill_file_attrs(result, entry.name, entry.mode);
+                }
+            }
+            else
+            {
+                LOGF << "Can't insert element " << entry.name << " into index! Probably index already have element with such name." << ELOG;
+            }
+
+            release_job(job);
+        }
+    }
+    catch (...)
+    {
+        queue.close();
+        threads.join_all();
+        for (std::vector<InflateJob>::iterator i = jobs.begin(), end = jobs.end(); i != end; ++i)
+        {
+            release_job(*i);
+        }
+        throw;
+    }
+
+    queue.close();
+    threads.join_all();
+
+    storage_->put(result->assets());
+
+    return result;
+}
+
+} } // namespace piel::lib
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PIEL_ZIPIMPORTER_H_
+#define PIEL_ZIPIMPORTER_H_
+
+#include <iobjectsstorage.h>
+#include <treeindex.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <zip.h>
+
+#include <string>
+#include <vector>
+
+namespace piel { namespace lib {
+
+namespace errors {
+    struct unable_to_open_zip {};
+    struct unable_to_inflate_zip_entry {};
+}
+
+//! Imports zip archive content into the storage.
+//!
+//! Central directory is read once into the entries table. Entries are inflated by the
+//!threads pool, each thread reads the archive through its own libzip handle. Inflated data
+//!are hashed and stored by the storage ingest on the calling thread, so every entry is
+//!inflated once and stored in one pass.
+class ZipImporter: private boost::noncopyable
+{
+public:
+    //! Constructor.
+    //! \param storage Storage to put the entries data into.
+    //! \param temp_dir Directory for the inflated large entries.
+    ZipImporter(const IObjectsStorage::Ptr& storage, const boost::filesystem::path& temp_dir = boost::filesystem::temp_directory_path());
+    ~ZipImporter();
+
+    //! Number of the inflating threads: 1 (default) inflates on the calling thread, 0 uses all CPUs.
+    void set_threads_count(unsigned int threads_count);
+
+    //! Import archive.
+    //! \param zip_file Archive to import.
+    //! \return Index of the archive content, assets are the storage ones.
+    TreeIndex::Ptr import(const boost::filesystem::path& zip_file);
+
+private:
+    //! Central directory record.
+    struct Entry {
+        zip_uint64_t    index;
+        std::string     name;
+        zip_uint64_t    size;
+        int             mode;
+        bool            symlink;
+    };
+
+    typedef std::vector<Entry> Entries;
+
+    Entries read_entries(const boost::filesystem::path& zip_file) const;
+
+private:
+    IObjectsStorage::Ptr        storage_;
+    boost::filesystem::path     temp_dir_;
+    unsigned int                threads_count_;
+};
+
+} } // namespace piel::lib
+
+#endif /* PIEL_ZIPIMPORTER_H_ */
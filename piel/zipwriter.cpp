@@ -0,0 +1,702 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <zipwriter.h>
+#include <commonconstants.h>
+#include <objectcompression.h>
+#include <logging.h>
+
+#include <boost/bind.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread.hpp>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+
+namespace piel { namespace lib {
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+    struct C {
+        static const std::size_t    spill_threshold;        //!< Deflated data larger than this are written into the spill file.
+        static const double         probe_ratio;            //!< Max deflated/raw ratio of the first block.
+        static const uint32_t       max_u32;
+        static const uint16_t       max_u16;
+        static const uint32_t       local_header_signature;
+        static const uint32_t       central_header_signature;
+        static const uint32_t       end_signature;
+        static const uint32_t       zip64_end_signature;
+        static const uint32_t       zip64_locator_signature;
+        static const uint16_t       zip64_extra_id;
+        static const uint16_t       version;                //!< 2.0: deflate.
+        static const uint16_t       version_zip64;          //!< 4.5: ZIP64 extensions.
+        static const uint16_t       made_by_unix;
+        static const uint16_t       flag_utf8;
+        static const uint16_t       method_store;
+        static const uint16_t       method_deflate;
+        static const uint16_t       dos_date;               //!< Entries modification date.
+        static const uint16_t       dos_time;               //!< Entries modification time.
+    };
+
+    /*static*/ const std::size_t    C::spill_threshold          = 16 * 1024 * 1024;
+    /*static*/ const double         C::probe_ratio              = 0.9;
+    /*static*/ const uint32_t       C::max_u32                  = 0xFFFFFFFF;
+    /*static*/ const uint16_t       C::max_u16                  = 0xFFFF;
+    /*static*/ const uint32_t       C::local_header_signature   = 0x04034b50;
+    /*static*/ const uint32_t       C::central_header_signature = 0x02014b50;
+    /*static*/ const uint32_t       C::end_signature            = 0x06054b50;
+    /*static*/ const uint32_t       C::zip64_end_signature      = 0x06064b50;
+    /*static*/ const uint32_t       C::zip64_locator_signature  = 0x07064b50;
+    /*static*/ const uint16_t       C::zip64_extra_id           = 0x0001;
+    /*static*/ const uint16_t       C::version                  = 20;
+    /*static*/ const uint16_t       C::version_zip64            = 45;
+    /*static*/ const uint16_t       C::made_by_unix             = 3 << 8;
+    /*static*/ const uint16_t       C::flag_utf8                = 0x0800;
+    /*static*/ const uint16_t       C::method_store             = 0;
+    /*static*/ const uint16_t       C::method_deflate           = 8;
+    /*static*/ const uint16_t       C::dos_date                 = (1 << 5) | 1;     // 1980-01-01, archive doesn't depend on the time.
+    /*static*/ const uint16_t       C::dos_time                 = 0;
+
+    void put16(std::string& out, uint16_t value)
+    {
+        out.push_back(static_cast<char>(value & 0xff));
+        out.push_back(static_cast<char>(value >> 8));
+    }
+
+    void put32(std::string& out, uint32_t value)
+    {
+        put16(out, static_cast<uint16_t>(value & 0xffff));
+        put16(out, static_cast<uint16_t>(value >> 16));
+    }
+
+    void put64(std::string& out, uint64_t value)
+    {
+        put32(out, static_cast<uint32_t>(value & 0xffffffff));
+        put32(out, static_cast<uint32_t>(value >> 32));
+    }
+
+    //! Entry deflated by the worker.
+    struct DeflateJob {
+        DeflateJob()
+            : isp()
+            , spill_path()
+            , spilled(false)
+            , data()
+            , crc(0)
+            , size(0)
+            , compressed_size(0)
+            , method(C::method_deflate)
+            , level(Z_DEFAULT_COMPRESSION)
+            , done(false)
+            , error()
+        {
+        }
+
+        boost::shared_ptr<std::istream>     isp;                //!< Opened by the writing thread.
+        fs::path                            spill_path;         //!< Used if the deflated data are large.
+        bool                                spilled;
+        std::string                         data;               //!< Deflated data if not spilled.
+        uint32_t                            crc;
+        uint64_t                            size;
+        uint64_t                            compressed_size;
+        uint16_t                            method;             //!< Requested method, store if deflate doesn't help.
+        int                                 level;
+        bool                                done;
+        std::exception_ptr                  error;
+    };
+
+    //! Central directory record of the written entry.
+    struct CentralRecord {
+        std::string                         name;
+        uint16_t                            flags;
+        uint16_t                            method;
+        uint32_t                            crc;
+        uint64_t                            size;
+        uint64_t                            compressed_size;
+        uint64_t                            offset;
+        int                                 mode;
+    };
+
+    //! Jobs queue of the deflating workers. Jobs are taken in the order they were pushed.
+    class DeflateQueue {
+    public:
+        DeflateQueue()
+            : closed_(false)
+        {
+        }
+
+        void push(DeflateJob *job)
+        {
+            boost::unique_lock<boost::mutex> lock(mutex_);
+            jobs_.push_back(job);
+            not_empty_.notify_one();
+        }
+
+        //! \return next job or null if the queue is closed and empty.
+        DeflateJob *pop()
+        {
+            boost::unique_lock<boost::mutex> lock(mutex_);
+            while (jobs_.empty() && !closed_)
+            {
+                not_empty_.wait(lock);
+            }
+
+            if (jobs_.empty())
+            {
+                return 0;
+            }
+
+            DeflateJob *job = jobs_.front();
+            jobs_.pop_front();
+            return job;
+        }
+
+        void close()
+        {
+            boost::unique_lock<boost::mutex> lock(mutex_);
+            closed_ = true;
+            not_empty_.notify_all();
+        }
+
+        void finish(DeflateJob *job)
+        {
+            boost::unique_lock<boost::mutex> lock(mutex_);
+            job->done = true;
+            done_.notify_all();
+        }
+
+        void wait(DeflateJob *job)
+        {
+            boost::unique_lock<boost::mutex> lock(mutex_);
+            while (!job->done)
+            {
+                done_.wait(lock);
+            }
+        }
+
+    private:
+        bool                        closed_;
+        std::deque<DeflateJob*>     jobs_;
+        boost::mutex                mutex_;
+        boost::condition_variable   not_empty_;
+        boost::condition_variable   done_;
+    };
+
+    //! Deflated data sink: memory buffer, spill file after the threshold.
+    class DeflateOutput {
+    public:
+        DeflateOutput(DeflateJob *job)
+            : job_(job)
+            , spill_()
+        {
+        }
+
+        void write(const char *data, std::size_t size)
+        {
+            job_->compressed_size += size;
+
+            if (!spill_)
+            {
+                job_->data.append(data, size);
+                if (job_->data.size() <= C::spill_threshold)
+                {
+                    return;
+                }
+
+                spill_.reset(new std::ofstream(job_->spill_path.c_str(), std::ofstream::out|std::ofstream::binary|std::ofstream::trunc));
+                job_->spilled = true;
+                data = job_->data.data();
+                size = job_->data.size();
+            }
+
+            if (!spill_->write(data, size))
+            {
+                throw errors::unable_to_deflate_zip_entry();
+            }
+
+            if (!job_->data.empty())
+            {
+                std::string().swap(job_->data);
+            }
+        }
+
+        void close()
+        {
+            if (spill_ && !spill_->flush())
+            {
+                throw errors::unable_to_deflate_zip_entry();
+            }
+            spill_.reset();
+        }
+
+    private:
+        DeflateJob                          *job_;
+        boost::scoped_ptr<std::ofstream>    spill_;
+    };
+
+    //! Read next entry data block.
+    //! \return Number of the readed bytes, less than the block size for the last block.
+    std::size_t read_block(DeflateJob *job, std::vector<char>& in)
+    {
+        job->isp->read(in.data(), in.size());
+        std::size_t readed = static_cast<std::size_t>(job->isp->gcount());
+        if (job->isp->bad())
+        {
+            throw errors::unable_to_deflate_zip_entry();
+        }
+
+        job->crc   = static_cast<uint32_t>(crc32(job->crc, reinterpret_cast<const Bytef*>(in.data()), static_cast<uInt>(readed)));
+        job->size += readed;
+        return readed;
+    }
+
+    //! Deflate data block.
+    //! \param deflated Deflated data are appended to.
+    void deflate_block(z_stream& stream, char *data, std::size_t size, bool finish, std::vector<char>& out, std::string& deflated)
+    {
+        stream.next_in  = reinterpret_cast<Bytef*>(data);
+        stream.avail_in = static_cast<uInt>(size);
+        do
+        {
+            stream.next_out  = reinterpret_cast<Bytef*>(out.data());
+            stream.avail_out = static_cast<uInt>(out.size());
+            if (deflate(&stream, finish ? Z_FINISH : Z_NO_FLUSH) == Z_STREAM_ERROR)
+            {
+                throw errors::unable_to_deflate_zip_entry();
+            }
+            deflated.append(out.data(), out.size() - stream.avail_out);
+        }
+        while (stream.avail_out == 0);
+    }
+
+    //! Deflate job data. Runs on the workers, so must not log.
+    void deflate_job(DeflateJob *job)
+    {
+        std::vector<char> in(CommonConstants::io_buffer_size);
+        std::vector<char> out(CommonConstants::io_buffer_size);
+        DeflateOutput output(job);
+        std::string deflated;
+
+        std::size_t readed = read_block(job, in);
+        bool last = readed < in.size();
+
+        z_stream stream;
+        std::memset(&stream, 0, sizeof(stream));
+
+        // Empty entries are stored.
+        bool deflating = job->method == C::method_deflate && readed > 0;
+        if (deflating && deflateInit2(&stream, job->level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        {
+            throw errors::unable_to_deflate_zip_entry();
+        }
+
+        try
+        {
+            // Probe the first block: badly compressible entries (media, nested archives) are stored.
+            if (deflating)
+            {
+                deflate_block(stream, in.data(), readed, last, out, deflated);
+                if (deflated.size() >= readed * C::probe_ratio)
+                {
+                    deflating = false;
+                    deflateEnd(&stream);
+                }
+            }
+
+            job->method = deflating ? C::method_deflate : C::method_store;
+            if (deflating)
+            {
+                output.write(deflated.data(), deflated.size());
+            }
+            else
+            {
+                output.write(in.data(), readed);
+            }
+
+            while (!last)
+            {
+                readed = read_block(job, in);
+                last = readed < in.size();
+
+                if (deflating)
+                {
+                    deflated.clear();
+                    deflate_block(stream, in.data(), readed, last, out, deflated);
+                    output.write(deflated.data(), deflated.size());
+                }
+                else
+                {
+                    output.write(in.data(), readed);
+                }
+            }
+            output.close();
+        }
+        catch (...)
+        {
+            if (deflating)
+            {
+                deflateEnd(&stream);
+            }
+            throw;
+        }
+
+        if (deflating)
+        {
+            deflateEnd(&stream);
+        }
+    }
+
+    void deflate_worker(DeflateQueue *queue)
+    {
+        for (DeflateJob *job = queue->pop(); job; job = queue->pop())
+        {
+            try
+            {
+                deflate_job(job);
+            }
+            catch (...)
+            {
+                job->error = std::current_exception();
+            }
+
+            // Close the asset stream as soon as possible.
+            job->isp.reset();
+            queue->finish(job);
+        }
+    }
+
+    void release_job(DeflateJob& job)
+    {
+        std::string().swap(job.data);
+        job.isp.reset();
+        if (job.spilled)
+        {
+            boost::system::error_code ec;
+            fs::remove(job.spill_path, ec);
+            job.spilled = false;
+        }
+    }
+
+    bool is_ascii(const std::string& name)
+    {
+        for (std::string::const_iterator i = name.begin(), end = name.end(); i != end; ++i)
+        {
+            if (static_cast<unsigned char>(*i) & 0x80)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace
+
+/*static*/ const int ZipWriter::default_level;
+/*static*/ const int ZipWriter::max_level;
+
+static_assert(ZipWriter::default_level == Z_DEFAULT_COMPRESSION, "ZipWriter default level must be the zlib default one.");
+
+ZipWriter::ZipWriter(std::ostream& os, const boost::filesystem::path& temp_dir)
+    : os_(os)
+    , temp_dir_(temp_dir)
+    , threads_count_(1)
+    , level_(default_level)
+    , entries_()
+{
+}
+
+ZipWriter::~ZipWriter()
+{
+}
+
+void ZipWriter::set_threads_count(unsigned int threads_count)
+{
+    threads_count_ = threads_count ? threads_count : std::max(1u, boost::thread::hardware_concurrency());
+}
+
+void ZipWriter::set_level(int level)
+{
+    if (level < default_level || level > max_level)
+    {
+        LOGE << "Unsupported deflate level: " << level << "!" << ELOG;
+
+        throw errors::unsupported_deflate_level();
+    }
+
+    level_ = level;
+}
+
+void ZipWriter::add(const std::string& name, const Asset& asset, int mode)
+{
+    Entry entry;
+    entry.name  = name;
+    entry.asset = asset;
+    entry.mode  = mode;
+    entries_.push_back(entry);
+}
+
+/*static*/ bool ZipWriter::entry_less(const Entry& left, const Entry& right)
+{
+    return left.name < right.name;
+}
+
+unsigned long long ZipWriter::write()
+{
+    std::vector<DeflateJob>     jobs(entries_.size());
+    std::vector<CentralRecord>  records;
+    records.reserve(entries_.size());
+
+    // Archive content doesn't depend on the adding order.
+    std::stable_sort(entries_.begin(), entries_.end(), &ZipWriter::entry_less);
+
+    // Deflated entries waiting for the writing are bounded, so are the memory and opened files.
+    std::size_t window = threads_count_ > 1 ? threads_count_ * 2 : 1;
+
+    DeflateQueue queue;
+    boost::thread_group threads;
+    for (unsigned int t = 0; threads_count_ > 1 && t < threads_count_; ++t)
+    {
+        threads.create_thread(boost::bind(&deflate_worker, &queue));
+    }
+
+    LOGT << "Write " << entries_.size() << " zip entries using " << threads_count_ << " threads." << ELOG;
+
+    uint64_t offset = 0;
+    try
+    {
+        std::size_t submitted = 0;
+        for (std::size_t k = 0; k < jobs.size(); ++k)
+        {
+            // Asset streams are opened here, so only this thread interacts with the storage and logs.
+            for (; submitted < jobs.size() && submitted < k + window; ++submitted)
+            {
+                DeflateJob& job = jobs[submitted];
+                job.spill_path  = temp_dir_ / fs::unique_path("pie-zip-%%%%-%%%%-%%%%-%%%%");
+                job.isp         = entries_[submitted].asset.istream();
+                job.level       = level_;
+                job.method      = level_ == 0 || ObjectCompression::is_compressed_format(entries_[submitted].name) ? C::method_store : C::method_deflate;
+
+                if (!job.isp)
+                {
+                    LOGE << "Unable to read zip entry: " << entries_[submitted].name << ELOG;
+
+                    throw errors::unable_to_deflate_zip_entry();
+                }
+
+                if (threads_count_ > 1)
+                {
+                    queue.push(&job);
+                }
+            }
+
+            DeflateJob& job = jobs[k];
+            if (threads_count_ > 1)
+            {
+                queue.wait(&job);
+            }
+            else
+            {
+                try
+                {
+                    deflate_job(&job);
+                }
+                catch (...)
+                {
+                    job.error = std::current_exception();
+                }
+            }
+
+            if (job.error)
+            {
+                LOGE << "Unable to deflate zip entry: " << entries_[k].name << ELOG;
+
+                std::rethrow_exception(job.error);
+            }
+
+            CentralRecord record;
+            record.name             = entries_[k].name;
+            record.flags            = is_ascii(record.name) ? 0 : C::flag_utf8;
+            record.method           = job.method;
+            record.crc              = job.crc;
+            record.size             = job.size;
+            record.compressed_size  = job.compressed_size;
+            record.offset           = offset;
+            record.mode             = entries_[k].mode;
+
+            bool zip64 = record.size >= C::max_u32 || record.compressed_size >= C::max_u32;
+
+            std::string header;
+            put32(header, C::local_header_signature);
+            put16(header, zip64 ? C::version_zip64 : C::version);
+            put16(header, record.flags);
+            put16(header, record.method);
+            put16(header, C::dos_time);
+            put16(header, C::dos_date);
+            put32(header, record.crc);
+            put32(header, zip64 ? C::max_u32 : static_cast<uint32_t>(record.compressed_size));
+            put32(header, zip64 ? C::max_u32 : static_cast<uint32_t>(record.size));
+            put16(header, static_cast<uint16_t>(record.name.size()));
+            put16(header, zip64 ? 20 : 0);
+            header.append(record.name);
+            if (zip64)
+            {
+                put16(header, C::zip64_extra_id);
+                put16(header, 16);
+                put64(header, record.size);
+                put64(header, record.compressed_size);
+            }
+
+            os_.write(header.data(), header.size());
+            if (job.spilled)
+            {
+                std::ifstream spill(job.spill_path.c_str(), std::ifstream::in|std::ifstream::binary);
+                os_ << spill.rdbuf();
+            }
+            else
+            {
+                os_.write(job.data.data(), job.data.size());
+            }
+
+            if (!os_)
+            {
+                LOGE << "Unable to write zip entry: " << record.name << ELOG;
+
+                throw errors::unable_to_write_zip();
+            }
+
+            offset += header.size() + record.compressed_size;
+            records.push_back(record);
+
+            release_job(job);
+        }
+    }
+    catch (...)
+    {
+        queue.close();
+        threads.join_all();
+        for (std::vector<DeflateJob>::iterator i = jobs.begin(), end = jobs.end(); i != end; ++i)
+        {
+            release_job(*i);
+        }
+        throw;
+    }
+
+    queue.close();
+    threads.join_all();
+
+    // Central directory.
+    uint64_t central_offset = offset;
+    std::string central;
+    for (std::vector<CentralRecord>::const_iterator i = records.begin(), end = records.end(); i != end; ++i)
+    {
+        std::string extra;
+        if (i->size >= C::max_u32)              put64(extra, i->size);
+        if (i->compressed_size >= C::max_u32)   put64(extra, i->compressed_size);
+        if (i->offset >= C::max_u32)            put64(extra, i->offset);
+
+        uint16_t version = extra.empty() ? C::version : C::version_zip64;
+
+        put32(central, C::central_header_signature);
+        put16(central, C::made_by_unix | version);
+        put16(central, version);
+        put16(central, i->flags);
+        put16(central, i->method);
+        put16(central, C::dos_time);
+        put16(central, C::dos_date);
+        put32(central, i->crc);
+        put32(central, static_cast<uint32_t>(std::min<uint64_t>(i->compressed_size, C::max_u32)));
+        put32(central, static_cast<uint32_t>(std::min<uint64_t>(i->size, C::max_u32)));
+        put16(central, static_cast<uint16_t>(i->name.size()));
+        put16(central, static_cast<uint16_t>(extra.empty() ? 0 : extra.size() + 4));
+        put16(central, 0);                                          // Comment length.
+        put16(central, 0);                                          // Disk number.
+        put16(central, 0);                                          // Internal attributes.
+        put32(central, (static_cast<uint32_t>(i->mode) & 0xFFFF) << 16);
+        put32(central, static_cast<uint32_t>(std::min<uint64_t>(i->offset, C::max_u32)));
+        central.append(i->name);
+        if (!extra.empty())
+        {
+            put16(central, C::zip64_extra_id);
+            put16(central, static_cast<uint16_t>(extra.size()));
+            central.append(extra);
+        }
+    }
+    uint64_t central_size = central.size();
+    uint64_t count        = records.size();
+
+    if (count >= C::max_u16 || central_offset >= C::max_u32 || central_size >= C::max_u32)
+    {
+        uint64_t zip64_end_offset = central_offset + central_size;
+
+        put32(central, C::zip64_end_signature);
+        put64(central, 44);                                         // Size of the remaining record.
+        put16(central, C::made_by_unix | C::version_zip64);
+        put16(central, C::version_zip64);
+        put32(central, 0);                                          // Disk number.
+        put32(central, 0);                                          // Central directory disk.
+        put64(central, count);
+        put64(central, count);
+        put64(central, central_size);
+        put64(central, central_offset);
+
+        put32(central, C::zip64_locator_signature);
+        put32(central, 0);                                          // Zip64 end record disk.
+        put64(central, zip64_end_offset);
+        put32(central, 1);                                          // Total disks.
+    }
+
+    put32(central, C::end_signature);
+    put16(central, 0);                                              // Disk number.
+    put16(central, 0);                                              // Central directory disk.
+    put16(central, static_cast<uint16_t>(std::min<uint64_t>(count, C::max_u16)));
+    put16(central, static_cast<uint16_t>(std::min<uint64_t>(count, C::max_u16)));
+    put32(central, static_cast<uint32_t>(std::min<uint64_t>(central_size, C::max_u32)));
+    put32(central, static_cast<uint32_t>(std::min<uint64_t>(central_offset, C::max_u32)));
+    put16(central, 0);                                              // Comment length.
+
+    os_.write(central.data(), central.size());
+    os_.flush();
+    if (!os_)
+    {
+        LOGE << "Unable to write zip central directory." << ELOG;
+
+        throw errors::unable_to_write_zip();
+    }
+
+    return offset + central.size();
+}
+
+} } // namespace piel::lib
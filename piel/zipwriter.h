@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY diakovliev ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL diakovliev BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PIEL_ZIPWRITER_H_
+#define PIEL_ZIPWRITER_H_
+
+#include <asset.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace piel { namespace lib {
+
+namespace errors {
+    struct unable_to_write_zip {};
+    struct unable_to_deflate_zip_entry {};
+    struct unsupported_deflate_level {};
+}
+
+//! Zip archive writer what deflates the entries concurrently.
+//!
+//! Entries data are deflated by the threads pool into the per entry buffers. Buffers
+//!of the large entries are spilled into the temporary files. The archive is written by
+//!the calling thread in the entries order: local headers with data and the central
+//!directory. ZIP64 records are used for the entries, offsets and counts what don't fit
+//!into the classic zip fields, so the result is a standard archive readable by libzip.
+//!
+//! Entries what don't shrink are stored: the compressed formats (by the name extension)
+//!and the entries with the badly compressible first data block.
+//!
+//! Archive is reproducible: entries are sorted by name, have the fixed modification time
+//!and the attributes given by add() only.
+class ZipWriter: private boost::noncopyable
+{
+public:
+    static const int default_level = -1;   //!< zlib default level.
+    static const int max_level = 9;         //!< Smallest archive.
+
+    //! Constructor.
+    //! \param os Archive output stream. Stream is written sequentially, without seeks.
+    //! \param temp_dir Directory for the spilled entries.
+    ZipWriter(std::ostream& os, const boost::filesystem::path& temp_dir = boost::filesystem::temp_directory_path());
+    ~ZipWriter();
+
+    //! Number of the deflating threads: 1 (default) deflates on the calling thread, 0 uses all CPUs.
+    void set_threads_count(unsigned int threads_count);
+
+    //! Deflate level: 0 stores all entries, 1 (fastest) to 9 (smallest), -1 (default) zlib default.
+    //!Other levels are rejected by unsupported_deflate_level.
+    void set_level(int level);
+
+    //! Add entry. Asset data is read by write().
+    //! \param name Archive entry name.
+    //! \param asset Readable entry data.
+    //! \param mode Unix mode of the entry.
+    void add(const std::string& name, const Asset& asset, int mode);
+
+    //! Deflate all added entries and write the archive.
+    //! \return Number of the written bytes.
+    unsigned long long write();
+
+private:
+    struct Entry {
+        std::string     name;
+        Asset           asset;
+        int             mode;
+    };
+
+    static bool entry_less(const Entry& left, const Entry& right);
+
+    std::ostream&               os_;
+    boost::filesystem::path     temp_dir_;
+    unsigned int                threads_count_;
+    int                         level_;
+    std::vector<Entry>          entries_;
+};
+
+} } // namespace piel::lib
+
+#endif /* PIEL_ZIPWRITER_H_ */
@@ -31,11 +31,15 @@
 
 #include "test_utils.hpp"
 #include <checksumsdigestbuilder.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
 
 #include <asset.h>
 #include <treeindex.h>
 
-//#include <indexesdiff.h>
+#include <indexesdiff.h>
 //#include <memoryobjectsstorage.h>
 //#include <localdirectorystorage.h>
 
@@ -51,6 +55,25 @@ BOOST_AUTO_TEST_CASE(empty_asset)
     BOOST_CHECK(AssetId::not_calculated != AssetId::create(""));
 }
 
+BOOST_AUTO_TEST_CASE(asset_id_string_representation)
+{
+    BOOST_CHECK(AssetId::empty          == AssetId::create(AssetId::empty.string()));
+    BOOST_CHECK(AssetId::not_calculated == AssetId::create(AssetId::not_calculated.string()));
+    BOOST_CHECK(!AssetId::create("not a digest").has_digest());
+
+    for (int i = 0; i < 100; ++i)
+    {
+        AssetId id = Asset::create_for(test_utils::generate_random_string()).id();
+
+        BOOST_CHECK(id.has_digest());
+        BOOST_CHECK_EQUAL(AssetId::str_digest_len, id.string().length());
+        BOOST_CHECK(id == AssetId::create(id.string()));
+        BOOST_CHECK(id == AssetId::create(boost::to_upper_copy(id.string())));
+        BOOST_CHECK(id == AssetId::create(id.data()));
+        BOOST_CHECK_EQUAL(id.hash(), AssetId::create(id.string()).hash());
+    }
+}
+
 BOOST_AUTO_TEST_CASE(not_calculated_asset)
 {
     Asset not_calculated_asset = Asset::create_id(AssetId::not_calculated);
@@ -73,6 +96,133 @@ BOOST_AUTO_TEST_CASE(strings_assets)
     }
 }
 
+BOOST_AUTO_TEST_CASE(digests_set)
+{
+    std::string content = test_utils::generate_random_string();
+
+    ChecksumsDigestBuilder::StrDigests all = ChecksumsDigestBuilder().str_digests_for(content);
+    BOOST_CHECK_EQUAL(3, all.size());
+
+    ChecksumsDigestBuilder::StrDigests sha256 =
+            ChecksumsDigestBuilder(ChecksumsDigestBuilder::Digest_sha256).str_digests_for(content);
+    BOOST_REQUIRE_EQUAL(1, sha256.size());
+    BOOST_CHECK_EQUAL(all[AssetId::digest_algo], sha256[AssetId::digest_algo]);
+
+    ChecksumsDigestBuilder::StrDigests sha1_md5 =
+            ChecksumsDigestBuilder(ChecksumsDigestBuilder::Digest_sha1 | ChecksumsDigestBuilder::Digest_md5).str_digests_for(content);
+    BOOST_CHECK_EQUAL(2, sha1_md5.size());
+    BOOST_CHECK(sha1_md5.find(AssetId::digest_algo) == sha1_md5.end());
+    BOOST_CHECK_EQUAL(all[Md5::t::name()], sha1_md5[Md5::t::name()]);
+}
+
+namespace {
+
+std::string blake3_test_input(std::size_t size)
+{
+    std::string result(size, '\0');
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        result[i] = static_cast<char>(i % 251);
+    }
+    return result;
+}
+
+void blake3_hash(const std::string *input, std::string *out)
+{
+    unsigned char digest[Blake3Hasher::out_len];
+
+    Blake3Hasher hasher(4);
+    hasher.init();
+    hasher.update(input->data(), input->size());
+    hasher.finalize(digest);
+
+    *out = HexCodec::encode(digest, sizeof(digest));
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(blake3_digests)
+{
+    // Reference BLAKE3 test vectors input: bytes i % 251.
+    std::map<std::size_t, std::string> vectors;
+    vectors[0]                      = "af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262";
+    vectors[1]                      = "2d3adedff11b61f14c886e35afa036736dcd87a74d27b5c1510225d0f592e213";
+    vectors[1024]                   = "42214739f095a406f3fc83deb889744ac00df831c10daa55189b5d121c855af7";
+    vectors[1025]                   = "d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444";
+    vectors[3 * 1024 * 1024 + 17]   = "26003c63117013de5d02be76e5e32a2f75bfbc075f17180fd5f9f0b4752d2bfe";
+
+    ChecksumsDigestBuilder builder(ChecksumsDigestBuilder::Digest_blake3);
+    for (std::map<std::size_t, std::string>::const_iterator i = vectors.begin(); i != vectors.end(); ++i)
+    {
+        std::string input = blake3_test_input(i->first);
+
+        ChecksumsDigestBuilder::StrDigests digests = builder.str_digests_for(input);
+        BOOST_REQUIRE_EQUAL(1, digests.size());
+        BOOST_CHECK_EQUAL(i->second, digests[Blake3::t::name()]);
+
+        // Subtrees are hashed concurrently, result must not depend on threads and updates sizes.
+        unsigned char out[Blake3Hasher::out_len];
+        for (unsigned threads = 1; threads <= 4; ++threads)
+        {
+            Blake3Hasher hasher(threads);
+            hasher.init();
+            for (std::size_t offset = 0, step = 1000 * threads + 1; offset < input.size(); offset += step)
+            {
+                hasher.update(input.data() + offset, std::min(step, input.size() - offset));
+            }
+            hasher.finalize(out);
+            BOOST_CHECK_EQUAL(i->second, HexCodec::encode(out, sizeof(out)));
+        }
+
+        // Threads pools workers hash in the calling thread.
+        {
+            Blake3Hasher::SerialScope serial_hashing;
+            Blake3Hasher hasher(4);
+            hasher.init();
+            hasher.update(input.data(), input.size());
+            hasher.finalize(out);
+            BOOST_CHECK_EQUAL(i->second, HexCodec::encode(out, sizeof(out)));
+        }
+    }
+
+    // Hashers of the several threads share the subtrees threads pool.
+    std::string input = blake3_test_input(vectors.rbegin()->first);
+    std::vector<std::string> results(4);
+    boost::thread_group threads;
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        threads.create_thread(boost::bind(&blake3_hash, &input, &results[i]));
+    }
+    threads.join_all();
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(vectors.rbegin()->second, results[i]);
+    }
+
+    // Artifactory checksums set is not affected.
+    BOOST_CHECK(ChecksumsDigestBuilder().str_digests_for(std::string()).count(Blake3::t::name()) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(id_algorithm)
+{
+    BOOST_CHECK_EQUAL(AssetId::Algorithm_sha256, AssetId::algorithm());
+    BOOST_CHECK_EQUAL(AssetId::Algorithm_blake3, AssetId::algorithm_for("blake3"));
+    BOOST_CHECK_EQUAL(AssetId::Algorithm_blake3, AssetId::algorithm_for(Blake3::t::name()));
+    BOOST_CHECK_EQUAL(AssetId::Algorithm_sha256, AssetId::algorithm_for(AssetId::digest_algo));
+    BOOST_CHECK_THROW(AssetId::algorithm_for("md5"), errors::unknown_id_algorithm);
+
+    std::string content = "blake3 repository content";
+
+    AssetId::set_algorithm(AssetId::Algorithm_blake3);
+    AssetId blake3_id = Asset::create_for(content).id();
+    AssetId::set_algorithm(AssetId::Algorithm_sha256);
+    AssetId sha256_id = Asset::create_for(content).id();
+
+    BOOST_CHECK_EQUAL("ae9875cd930f49e4236e2ce1e0900c56c0ff6e33150bd5686f340afa4d08ca64", blake3_id.string());
+    BOOST_CHECK_EQUAL(ChecksumsDigestBuilder().str_digests_for(content)[AssetId::digest_algo], sha256_id.string());
+}
+
 BOOST_AUTO_TEST_CASE(files_assets)
 {
     ChecksumsDigestBuilder digestBuilder;
@@ -176,6 +326,80 @@ BOOST_AUTO_TEST_CASE(index_attributes)
     }
 }
 
+BOOST_AUTO_TEST_CASE(index_self_invalidation)
+{
+    TreeIndex index;
+
+    AssetId initial_id = index.id();
+    BOOST_CHECK(initial_id == index.self().id());
+
+    std::string path = test_utils::generate_random_printable_string();
+    BOOST_CHECK(index.insert_path(path, Asset::create_for(test_utils::generate_random_string())));
+    AssetId inserted_id = index.id();
+    BOOST_CHECK(initial_id != inserted_id);
+
+    // Failed insert doesn't change the index.
+    BOOST_CHECK(!index.insert_path(path, Asset::create_for(test_utils::generate_random_string())));
+    BOOST_CHECK(inserted_id == index.id());
+
+    index.replace_path(path, Asset::create_for(test_utils::generate_random_string()));
+    AssetId replaced_id = index.id();
+    BOOST_CHECK(inserted_id != replaced_id);
+
+    index.set_attr_(path, "attr", "value");
+    AssetId attr_id = index.id();
+    BOOST_CHECK(replaced_id != attr_id);
+
+    index.set_message_("message");
+    AssetId message_id = index.id();
+    BOOST_CHECK(attr_id != message_id);
+
+    index.set_parent(Asset::create_for(test_utils::generate_random_string()));
+    BOOST_CHECK(message_id != index.id());
+
+    std::ostringstream os;
+    index.store(os);
+    BOOST_CHECK(Asset::create_for(os.str()).id() == index.id());
+}
+
+BOOST_AUTO_TEST_CASE(indexes_diff_changes)
+{
+    TreeIndex::Ptr first(new TreeIndex());
+    TreeIndex::Ptr second(new TreeIndex());
+
+    for (int i = 0; i < 10; ++i)
+    {
+        std::string path = "path" + boost::lexical_cast<std::string>(i);
+        Asset asset = Asset::create_for(test_utils::generate_random_string());
+        first->insert_path(path, asset);
+        second->insert_path(path, asset);
+    }
+
+    // Message is not a part of the content.
+    second->set_message_("message");
+    BOOST_CHECK(!IndexesDiff::has_changes(first, second));
+    BOOST_CHECK(IndexesDiff::diff(first, second).empty());
+    BOOST_CHECK(IndexesDiff::diff(first, second).content_diff().empty());
+
+    second->set_attr_("path0", "attr", "value");
+    BOOST_CHECK(IndexesDiff::has_changes(first, second));
+    BOOST_CHECK(IndexesDiff::diff(first, second).content_diff().empty());
+    BOOST_CHECK_EQUAL(1, IndexesDiff::diff(first, second).content_attributes_diff().size());
+    first->set_attr_("path0", "attr", "value");
+    BOOST_CHECK(!IndexesDiff::has_changes(first, second));
+
+    second->replace_path("path1", Asset::create_for(test_utils::generate_random_string()));
+    second->remove_path("path2");
+    second->insert_path("path20", Asset::create_for(test_utils::generate_random_string()));
+    BOOST_CHECK(IndexesDiff::has_changes(first, second));
+
+    IndexesDiff diff = IndexesDiff::diff(first, second);
+    BOOST_REQUIRE_EQUAL(3, diff.content_diff().size());
+    BOOST_CHECK(IndexesDiff::ElementState_modified == diff.content_diff().at("path1").first);
+    BOOST_CHECK(IndexesDiff::ElementState_removed  == diff.content_diff().at("path2").first);
+    BOOST_CHECK(IndexesDiff::ElementState_added    == diff.content_diff().at("path20").first);
+}
+
 BOOST_AUTO_TEST_CASE(index_content)
 {
     TreeIndex index;
@@ -257,3 +481,70 @@ BOOST_AUTO_TEST_CASE(index_content)
         BOOST_CHECK(!index_loaded_from_stream->asset(*i)->istream());
     }
 }
+
+BOOST_AUTO_TEST_CASE(index_binary_and_json_formats)
+{
+    TreeIndex index;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        std::string index_path = "dir/" + test_utils::generate_random_printable_string();
+        index.replace_path(index_path, Asset::create_for(test_utils::generate_random_string()));
+        index.set_attr_(index_path, PredefinedAttributes::asset_type, PredefinedAttributes::asset_type__file);
+        index.set_attr_(index_path, PredefinedAttributes::asset_mode, PredefinedAttributes::format_asset_mode(0644));
+    }
+    index.set_parent(Asset::create_for(test_utils::generate_random_string()));
+    index.set_message_("message");
+
+    std::ostringstream binary_os;
+    index.store(binary_os);
+
+    std::ostringstream json_os;
+    index.store_json(json_os);
+
+    BOOST_CHECK(binary_os.str().size() < json_os.str().size());
+
+    std::istringstream binary_is(binary_os.str());
+    std::istringstream json_is(json_os.str());
+
+    TreeIndex::Ptr from_binary  = TreeIndex::load(binary_is);
+    TreeIndex::Ptr from_json    = TreeIndex::load(json_is);
+
+    const TreeIndex* loaded[] = { from_binary.get(), from_json.get() };
+    for (std::size_t l = 0; l < sizeof(loaded) / sizeof(loaded[0]); ++l)
+    {
+        BOOST_CHECK(index.content() == loaded[l]->content());
+        BOOST_CHECK(index.parent() == loaded[l]->parent());
+        BOOST_CHECK_EQUAL("message", loaded[l]->get_message_());
+
+        for (TreeIndex::Content::const_iterator i = index.content().begin(), end = index.content().end(); i != end; ++i)
+        {
+            BOOST_CHECK(index.get_attrs_(i->first) == loaded[l]->get_attrs_(i->first));
+        }
+    }
+
+    // Loaded index keeps id of the data it was loaded from.
+    BOOST_CHECK(index.id() == from_binary->id());
+    BOOST_CHECK(Asset::create_for(json_os.str()).id() == from_json->id());
+
+    std::ostringstream json_restored_os;
+    from_json->store(json_restored_os);
+    BOOST_CHECK_EQUAL(json_os.str(), json_restored_os.str());
+
+    // Modified index is stored in binary format.
+    from_json->set_message_("other");
+    from_json->set_message_("message");
+    BOOST_CHECK(index.id() == from_json->id());
+
+    // Memory mapped file.
+    test_utils::TempFileHolder::Ptr temp_dir = test_utils::create_temp_dir();
+    boost::filesystem::path index_file = temp_dir->first / "index";
+    index.store(*boost::filesystem::ostream(index_file));
+
+    TreeIndex::Ptr from_file = TreeIndex::load(index_file);
+    BOOST_CHECK(index.id() == from_file->id());
+    BOOST_CHECK(index.content() == from_file->content());
+
+    std::string corrupted = binary_os.str().substr(0, binary_os.str().size() / 2);
+    BOOST_CHECK_THROW(TreeIndex::load(corrupted.data(), corrupted.size()), errors::corrupted_binary_index);
+}
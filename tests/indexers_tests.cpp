@@ -1,8 +1,17 @@
 #define BOOST_TEST_MODULE IndexersTests
 #include <boost/test/unit_test.hpp>
 
+#include "test_utils.hpp"
+
 #include <fsindexer.h>
 #include <zipindexer.h>
+#include <zipimporter.h>
+#include <zipwriter.h>
+#include <localdirectorystorage.h>
+
+#include <boost/format.hpp>
+#include <sys/stat.h>
+#include <fstream>
 
 using namespace piel::lib;
 namespace fs = boost::filesystem;
@@ -15,7 +24,7 @@ BOOST_AUTO_TEST_CASE(FsIndexer_BuildDirectoryIndex)
     //index = fs_indexer.build(fs::path("/home/diakovliev/Gerrit/cache"));
 
     std::ostringstream test_os;
-    index.store(test_os);
+    index.store_json(test_os);
     std::string serialized_index = test_os.str();
 
     std::cout << serialized_index;
@@ -28,6 +37,114 @@ BOOST_AUTO_TEST_CASE(FsIndexer_BuildDirectoryIndex)
 //    BOOST_CHECK_EQUAL("test2", test_map["test"]);
 }
 
+BOOST_AUTO_TEST_CASE(FsIndexer_NestedDirectories)
+{
+    test_utils::TempFileHolder::Ptr temp_dir = test_utils::create_temp_dir();
+
+    test_utils::DirState state;
+    for (int i = 0; i < 20; ++i)
+    {
+        std::ostringstream name;
+        name << "d" << i % 4 << "/s" << i % 3 << "/f" << i;
+        state[name.str()] = test_utils::generate_random_string();
+    }
+    state[".exclude/f"] = test_utils::generate_random_string();
+    test_utils::make_directory_state(temp_dir->first, fs::path(), state);
+    fs::create_symlink("d0/s0/f0", temp_dir->first / "link");
+
+    TreeIndex::Ptr index = FsIndexer::build(temp_dir->first, temp_dir->first / ".exclude");
+
+    BOOST_CHECK_EQUAL(21, index->content().size());
+    for (test_utils::DirState::const_iterator i = state.begin(), end = state.end(); i != end; ++i)
+    {
+        if (i->first == ".exclude/f")
+        {
+            BOOST_CHECK(index->content().find(i->first) == index->content().end());
+            continue;
+        }
+
+        BOOST_REQUIRE(index->content().find(i->first) != index->content().end());
+        BOOST_CHECK(Asset::create_for(i->second) == index->content().find(i->first)->second);
+        BOOST_CHECK_EQUAL(PredefinedAttributes::asset_type__file,
+                index->get_attr_(i->first, PredefinedAttributes::asset_type));
+    }
+
+    BOOST_REQUIRE(index->content().find("link") != index->content().end());
+    BOOST_CHECK(Asset::create_for(std::string("d0/s0/f0")) == index->content().find("link")->second);
+    BOOST_CHECK_EQUAL(PredefinedAttributes::asset_type__symlink,
+            index->get_attr_("link", PredefinedAttributes::asset_type));
+}
+
+BOOST_AUTO_TEST_CASE(FsIndexer_StatCache)
+{
+    test_utils::TempFileHolder::Ptr temp_dir = test_utils::create_temp_dir(10);
+
+    fs::path cache_dir  = temp_dir->first / ".cache";
+    fs::path cache_file = cache_dir / "stat_cache";
+    fs::create_directory(cache_dir);
+
+    // Files what are not older than cache session are racy and never cached.
+    std::time_t past = std::time(0) - 10;
+    for (fs::directory_iterator i(temp_dir->first), end; i != end; ++i)
+    {
+        if (fs::is_regular_file(i->path())) fs::last_write_time(i->path(), past);
+    }
+
+    TreeIndex::Ptr reference = FsIndexer::build(temp_dir->first, cache_dir);
+
+    {
+        StatCache stat_cache(cache_file);
+        stat_cache.load();
+
+        TreeIndex::Ptr index = FsIndexer::build(temp_dir->first, cache_dir, stat_cache);
+        BOOST_CHECK_EQUAL(0, stat_cache.hits());
+        BOOST_CHECK_EQUAL(10, stat_cache.misses());
+        BOOST_CHECK(reference->content() == index->content());
+
+        stat_cache.save();
+    }
+
+    {
+        StatCache stat_cache(cache_file);
+        stat_cache.load();
+
+        TreeIndex::Ptr index = FsIndexer::build(temp_dir->first, cache_dir, stat_cache);
+        BOOST_CHECK_EQUAL(10, stat_cache.hits());
+        BOOST_CHECK_EQUAL(0, stat_cache.misses());
+        BOOST_CHECK(reference->content() == index->content());
+    }
+
+    // Modify one file.
+    std::string modified = reference->content().begin()->first;
+    {
+        boost::shared_ptr<std::ostream> ofs = boost::filesystem::ostream(temp_dir->first / modified);
+        (*ofs) << test_utils::generate_random_string();
+    }
+
+    {
+        StatCache stat_cache(cache_file);
+        stat_cache.load();
+
+        TreeIndex::Ptr index = FsIndexer::build(temp_dir->first, cache_dir, stat_cache);
+        BOOST_CHECK_EQUAL(9, stat_cache.hits());
+        BOOST_CHECK_EQUAL(1, stat_cache.misses());
+        BOOST_CHECK(FsIndexer::build(temp_dir->first, cache_dir)->content() == index->content());
+        BOOST_CHECK(reference->content() != index->content());
+
+        stat_cache.save();
+    }
+
+    // Racy entry is not stored.
+    {
+        StatCache stat_cache(cache_file);
+        stat_cache.load();
+
+        FsIndexer::build(temp_dir->first, cache_dir, stat_cache);
+        BOOST_CHECK_EQUAL(9, stat_cache.hits());
+        BOOST_CHECK_EQUAL(1, stat_cache.misses());
+    }
+}
+
 BOOST_AUTO_TEST_CASE(ZipIndexer_BuildDirectoryIndex)
 {
     ZipIndexer zip_indexer;
@@ -36,8 +153,67 @@ BOOST_AUTO_TEST_CASE(ZipIndexer_BuildDirectoryIndex)
     //index = zip_indexer.build(fs::path("/home/diakovliev/Gerrit/cache/bin-release-local/adk/trunk/adk/67/ADK32419p_Explorer3040hd_OCAP_ATSC_SA_pKey/73ffa846b91bf995384b25afe155e879/ADK32419p_Explorer3040hd_OCAP_ATSC_SA_pKey"));
 
     std::ostringstream test_os;
-    index.store(test_os);
+    index.store_json(test_os);
     std::string serialized_index = test_os.str();
 
     std::cout << serialized_index;
 }
+
+BOOST_AUTO_TEST_CASE(ZipImporter_ImportArchive)
+{
+    test_utils::TempFileHolder::Ptr temp_dir = test_utils::create_temp_dir();
+    fs::path zip_path = temp_dir->first / "archive.zip";
+
+    std::map<std::string, std::string> files;
+    for (int i = 0; i < 20; ++i)
+    {
+        files[(boost::format("dir/file_%02d") % i).str()] = test_utils::generate_random_string();
+    }
+    // Inflated into the temporary file.
+    files["dir/large"] = std::string(5 * 1024 * 1024, 'x') + test_utils::generate_random_string();
+
+    {
+        std::ofstream os(zip_path.c_str(), std::ofstream::out|std::ofstream::binary);
+        ZipWriter writer(os, temp_dir->first);
+        for (std::map<std::string, std::string>::const_iterator i = files.begin(), end = files.end(); i != end; ++i)
+        {
+            writer.add(i->first, Asset::create_for(i->second), 0644);
+        }
+        writer.add("dir/link", Asset::create_for(std::string("file_00")), S_IFLNK|0777);
+        // Directory written without the directory attributes.
+        writer.add("empty/", Asset::create_for(std::string()), 0755);
+        writer.write();
+    }
+
+    fs::path reference_dir = temp_dir->first / "reference";
+    fs::path storage_dir = temp_dir->first / "storage";
+    fs::create_directories(reference_dir);
+    fs::create_directories(storage_dir);
+
+    IObjectsStorage::Ptr reference_storage(new LocalDirectoryStorage(reference_dir));
+    TreeIndex::Ptr reference = ZipIndexer::build(zip_path);
+    reference->ingest_into(reference_storage);
+
+    IObjectsStorage::Ptr storage(new LocalDirectoryStorage(storage_dir));
+    ZipImporter importer(storage, temp_dir->first);
+    importer.set_threads_count(4);
+    TreeIndex::Ptr index = importer.import(zip_path);
+
+    BOOST_CHECK_EQUAL(reference->id().string(), index->id().string());
+    BOOST_CHECK(storage->contains(index->id()));
+    BOOST_CHECK_EQUAL(files.size() + 1, index->content().size());
+    BOOST_CHECK(!index->asset("empty/"));
+
+    for (std::map<std::string, std::string>::const_iterator i = files.begin(), end = files.end(); i != end; ++i)
+    {
+        boost::optional<Asset> asset = index->asset(i->first);
+        BOOST_REQUIRE(asset);
+        BOOST_CHECK(i->second == test_utils::istream_content(storage->istream_for(asset->id())));
+    }
+
+    BOOST_CHECK_EQUAL(PredefinedAttributes::asset_type__symlink,
+            index->get_attr_("dir/link", PredefinedAttributes::asset_type));
+
+    // Temporary files of the large entries are removed: archive and storages are left only.
+    BOOST_CHECK_EQUAL(3, std::distance(fs::directory_iterator(temp_dir->first), fs::directory_iterator()));
+}
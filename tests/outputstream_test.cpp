@@ -57,7 +57,8 @@ BOOST_AUTO_TEST_CASE(outputstream_check_string_pattern1)
     size_t ret_val = 0;
     while( (ret_val = os.putto(buffer.data(), buffer.size())) ) {
         //LOGT << ret_val << ":" << buffer.data() << " pattern:" << pattern << ELOG;
-        BOOST_CHECK(pattern.compare(buffer.data()));
+        // Buffer is not null terminated, so compare exactly the returned data.
+        BOOST_CHECK_EQUAL_COLLECTIONS(pattern.begin(), pattern.end(), buffer.begin(), buffer.begin() + ret_val);
     }
 }
 
@@ -0,0 +1,667 @@
+/*
+ * Copyright (c) 2018, diakovliev
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Dmytro Iakovliev daemondzk@gmail.com ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Dmytro Iakovliev daemondzk@gmail.com BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#define BOOST_TEST_MODULE StoragesTests
+#include <boost/test/unit_test.hpp>
+
+#include "test_utils.hpp"
+
+#include <packeddirectorystorage.h>
+#include <memoryobjectsstorage.h>
+#include <layeredstorage.h>
+#include <objectssync.h>
+#include <remoteobjectsstorage.h>
+#include <indexesdiff.h>
+#include <merkletree.h>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/random/mersenne_twister.hpp>
+
+#include <fstream>
+
+using namespace piel::lib;
+
+namespace fs = boost::filesystem;
+
+BOOST_AUTO_TEST_CASE(packed_storage_put_repack_reopen)
+{
+    test_utils::TempFileHolder::Ptr storage_dir = test_utils::create_temp_dir();
+
+    std::map<AssetId, std::string> content;
+    std::set<Asset> assets;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        std::string data = test_utils::generate_random_string();
+        Asset asset = Asset::create_for(data);
+        content[asset.id()] = data;
+        assets.insert(asset);
+    }
+
+    // Empty object
+    Asset empty_data = Asset::create_for(std::string());
+    content[empty_data.id()] = std::string();
+    assets.insert(empty_data);
+
+    {
+        IObjectsStorage::Ptr storage(new PackedDirectoryStorage(storage_dir->first));
+
+        // Single put goes to the loose objects area.
+        storage->put(*assets.begin());
+        BOOST_CHECK(storage->contains(assets.begin()->id()));
+        BOOST_CHECK_EQUAL(0, boost::dynamic_pointer_cast<PackedDirectoryStorage>(storage)->packed_count());
+
+        // Objects are packed only when the loose objects limit is reached.
+        storage->put(assets);
+        BOOST_CHECK_EQUAL(0, boost::dynamic_pointer_cast<PackedDirectoryStorage>(storage)->packed_count());
+
+        BOOST_CHECK_EQUAL(content.size(), boost::dynamic_pointer_cast<PackedDirectoryStorage>(storage)->repack());
+        BOOST_CHECK_EQUAL(content.size(), boost::dynamic_pointer_cast<PackedDirectoryStorage>(storage)->packed_count());
+    }
+
+    BOOST_CHECK(PackedDirectoryStorage::is_packed(storage_dir->first));
+
+    IObjectsStorage::Ptr storage(new PackedDirectoryStorage(storage_dir->first));
+
+    for (std::map<AssetId, std::string>::const_iterator i = content.begin(), end = content.end(); i != end; ++i)
+    {
+        BOOST_CHECK(storage->contains(i->first));
+
+        Asset asset = storage->asset(storage, i->first);
+        BOOST_CHECK(asset.id() == i->first);
+        BOOST_CHECK_EQUAL(i->second, test_utils::istream_content(asset.istream()));
+    }
+
+    BOOST_CHECK(!storage->contains(Asset::create_for(std::string("not in storage")).id()));
+    BOOST_CHECK(!storage->istream_for(Asset::create_for(std::string("not in storage")).id()));
+
+    // Second pack
+    Asset new_asset = Asset::create_for(std::string("new asset"));
+    std::set<Asset> new_assets;
+    new_assets.insert(new_asset);
+    new_assets.insert(*assets.begin());
+    storage->put(new_assets);
+    boost::dynamic_pointer_cast<PackedDirectoryStorage>(storage)->repack();
+
+    BOOST_CHECK_EQUAL(content.size() + 1, boost::dynamic_pointer_cast<PackedDirectoryStorage>(storage)->packed_count());
+    BOOST_CHECK_EQUAL("new asset", test_utils::istream_content(storage->istream_for(new_asset.id())));
+    BOOST_CHECK(fs::is_empty(storage_dir->first / "objects"));
+}
+
+BOOST_AUTO_TEST_CASE(packed_storage_limits)
+{
+    test_utils::TempFileHolder::Ptr storage_dir = test_utils::create_temp_dir();
+
+    std::vector<Asset> assets;
+    for (int i = 0; i < 40; ++i)
+    {
+        assets.push_back(Asset::create_for(test_utils::generate_random_string()));
+    }
+
+    PackedDirectoryStorage storage(storage_dir->first);
+    storage.set_loose_objects_limit(10);
+    storage.set_packs_limit(3);
+
+    // Each 10 new objects go into the new pack.
+    for (int i = 0; i < 29; ++i)
+    {
+        storage.put(assets[i]);
+        storage.put(assets[i]);
+    }
+    BOOST_CHECK_EQUAL(20, storage.packed_count());
+    BOOST_CHECK(fs::exists(storage_dir->first / "packs" / "pack-00000001.pack"));
+    BOOST_CHECK(fs::exists(storage_dir->first / "packs" / "pack-00000002.pack"));
+
+    // Fourth pack exceeds the limit, so all packs are merged.
+    for (int i = 29; i < 40; ++i)
+    {
+        storage.put(assets[i]);
+    }
+    BOOST_CHECK_EQUAL(40, storage.packed_count());
+    BOOST_CHECK(!fs::exists(storage_dir->first / "packs" / "pack-00000001.pack"));
+    BOOST_CHECK(!fs::exists(storage_dir->first / "packs" / "pack-00000003.pack"));
+    BOOST_CHECK(fs::exists(storage_dir->first / "packs" / "pack-00000004.pack"));
+
+    // Explicit consolidation.
+    Asset last = Asset::create_for(std::string("last object"));
+    storage.put(last);
+    BOOST_CHECK_EQUAL(1, storage.consolidate());
+    BOOST_CHECK_EQUAL(41, storage.packed_count());
+    BOOST_CHECK(!fs::exists(storage_dir->first / "packs" / "pack-00000004.pack"));
+    BOOST_CHECK(fs::exists(storage_dir->first / "packs" / "pack-00000005.pack"));
+
+    PackedDirectoryStorage reopened(storage_dir->first);
+    for (std::vector<Asset>::const_iterator i = assets.begin(), end = assets.end(); i != end; ++i)
+    {
+        BOOST_CHECK_EQUAL(test_utils::istream_content(i->istream()), test_utils::istream_content(reopened.istream_for(i->id())));
+    }
+    BOOST_CHECK_EQUAL("last object", test_utils::istream_content(reopened.istream_for(last.id())));
+}
+
+BOOST_AUTO_TEST_CASE(packed_storage_reads_loose_objects)
+{
+    test_utils::TempFileHolder::Ptr storage_dir = test_utils::create_temp_dir();
+
+    Asset asset = Asset::create_for(std::string("loose object data"));
+
+    {
+        LocalDirectoryStorage storage(storage_dir->first);
+        storage.put(asset);
+    }
+
+    PackedDirectoryStorage storage(storage_dir->first);
+    BOOST_CHECK(storage.contains(asset.id()));
+    BOOST_CHECK_EQUAL("loose object data", test_utils::istream_content(storage.istream_for(asset.id())));
+
+    BOOST_CHECK_EQUAL(1, storage.repack());
+    BOOST_CHECK_EQUAL(1, storage.packed_count());
+    BOOST_CHECK_EQUAL("loose object data", test_utils::istream_content(storage.istream_for(asset.id())));
+}
+
+BOOST_AUTO_TEST_CASE(ingest_calculates_id_while_storing)
+{
+    test_utils::TempFileHolder::Ptr storage_dir = test_utils::create_temp_dir();
+    IObjectsStorage::Ptr storage(new LocalDirectoryStorage(storage_dir->first));
+
+    for (int i = 0; i < 10; ++i)
+    {
+        test_utils::TempFileHolder::Ptr test_file = test_utils::create_random_temp_file();
+
+        Asset file_asset = Asset::create_for(test_file->first);
+        BOOST_CHECK(!file_asset.id_calculated());
+
+        AssetId id = storage->ingest(file_asset);
+
+        BOOST_CHECK(id == Asset::create_for(test_file->second).id());
+        BOOST_CHECK(storage->contains(id));
+        BOOST_CHECK_EQUAL(test_file->second, test_utils::istream_content(storage->istream_for(id)));
+
+        // Second ingest of the same data
+        BOOST_CHECK(id == storage->ingest(Asset::create_for(test_file->first)));
+    }
+
+    BOOST_CHECK(fs::is_empty(storage_dir->first / "tmp"));
+}
+
+BOOST_AUTO_TEST_CASE(compressed_objects)
+{
+    test_utils::TempFileHolder::Ptr storage_dir = test_utils::create_temp_dir();
+
+    std::string text;
+    for (int i = 0; i < 100000; ++i)
+    {
+        text += "compressible line " + boost::lexical_cast<std::string>(i % 100) + "\n";
+    }
+    std::string random;
+    while (random.size() < 4096)
+    {
+        random += test_utils::generate_random_string();
+    }
+    std::string magic  = "PZOB raw data what looks like the compressed object header";
+
+    std::map<AssetId, std::string> content;
+    content[Asset::create_for(text).id()]    = text;
+    content[Asset::create_for(random).id()]  = random;
+    content[Asset::create_for(magic).id()]   = magic;
+
+    {
+        boost::shared_ptr<LocalDirectoryStorage> storage(new LocalDirectoryStorage(storage_dir->first));
+        storage->set_compression(ObjectCompression::Method_zlib);
+
+        for (std::map<AssetId, std::string>::const_iterator i = content.begin(), end = content.end(); i != end; ++i)
+        {
+            BOOST_CHECK(i->first == storage->ingest(Asset::create_for(i->second)));
+        }
+
+        // Compressed object is smaller on disk and can't be linked into the working copy.
+        AssetId text_id = Asset::create_for(text).id();
+        BOOST_CHECK(storage->object_file(text_id).empty());
+        BOOST_CHECK(fs::file_size(fs::path(storage_dir->first / "objects") / text_id.string().substr(0, 2)
+                / text_id.string().substr(2, 2) / text_id.string().substr(4, 2) / text_id.string()) < text.size() / 10);
+
+        // Probe keeps not compressible data raw.
+        BOOST_CHECK(!storage->object_file(Asset::create_for(random).id()).empty());
+        BOOST_CHECK(storage->object_file(Asset::create_for(magic).id()).empty());
+
+        for (std::map<AssetId, std::string>::const_iterator i = content.begin(), end = content.end(); i != end; ++i)
+        {
+            BOOST_CHECK_EQUAL(i->second.size(), storage->size_of(i->first));
+            BOOST_CHECK_EQUAL(i->second, test_utils::istream_content(storage->istream_for(i->first)));
+        }
+    }
+
+    // Packs keep the objects encoding.
+    PackedDirectoryStorage storage(storage_dir->first);
+    BOOST_CHECK_EQUAL(content.size(), storage.repack());
+    for (std::map<AssetId, std::string>::const_iterator i = content.begin(), end = content.end(); i != end; ++i)
+    {
+        BOOST_CHECK_EQUAL(i->second.size(), storage.size_of(i->first));
+        BOOST_CHECK_EQUAL(i->second, test_utils::istream_content(storage.istream_for(i->first)));
+    }
+
+    BOOST_CHECK(ObjectCompression::is_compressed_format("archive.ZIP"));
+    BOOST_CHECK(!ObjectCompression::is_compressed_format("index.json"));
+    BOOST_CHECK_THROW(ObjectCompression::method_for("lzma"), errors::unknown_compression_method);
+}
+
+namespace {
+
+std::size_t objects_count(const fs::path& objects_dir)
+{
+    std::size_t result = 0;
+    for (fs::recursive_directory_iterator i(objects_dir), end; i != end; ++i)
+    {
+        result += fs::is_regular_file(i->path()) ? 1 : 0;
+    }
+    return result;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(chunked_objects)
+{
+    test_utils::TempFileHolder::Ptr storage_dir = test_utils::create_temp_dir();
+
+    boost::random::mt19937 rng(17);
+    std::string data(3 * ObjectChunks::min_file_size, '\0');
+    for (std::string::iterator i = data.begin(), end = data.end(); i != end; ++i)
+    {
+        *i = static_cast<char>(rng());
+    }
+
+    // Small modification and insertion in the middle.
+    std::string modified = data;
+    modified.replace(data.size() / 2, 100, std::string(110, 'x'));
+
+    std::size_t first_count;
+    {
+        boost::shared_ptr<LocalDirectoryStorage> storage(new LocalDirectoryStorage(storage_dir->first));
+        storage->set_chunking(true);
+        storage->set_compression(ObjectCompression::Method_zlib);
+
+        AssetId id = storage->ingest(Asset::create_for(data));
+        BOOST_CHECK(id == Asset::create_for(data).id());
+        BOOST_CHECK(storage->object_file(id).empty());
+        BOOST_CHECK_EQUAL(data.size(), storage->size_of(id));
+        BOOST_CHECK(data == test_utils::istream_content(storage->istream_for(id)));
+
+        first_count = objects_count(storage_dir->first / "objects");
+        BOOST_CHECK(first_count > 4);
+
+        // Only the changed chunks are stored for the new version.
+        AssetId modified_id = storage->ingest(Asset::create_for(modified));
+        BOOST_CHECK(modified == test_utils::istream_content(storage->istream_for(modified_id)));
+        BOOST_CHECK(objects_count(storage_dir->first / "objects") - first_count <= 4);
+
+        // Small files are not chunked.
+        storage->put(Asset::create_for(std::string("small file")));
+        BOOST_CHECK(!storage->object_file(Asset::create_for(std::string("small file")).id()).empty());
+    }
+
+    PackedDirectoryStorage storage(storage_dir->first);
+    storage.repack();
+    BOOST_CHECK_EQUAL(data.size(), storage.size_of(Asset::create_for(data).id()));
+    BOOST_CHECK(data == test_utils::istream_content(storage.istream_for(Asset::create_for(data).id())));
+    BOOST_CHECK(modified == test_utils::istream_content(storage.istream_for(Asset::create_for(modified).id())));
+
+    BOOST_CHECK(ObjectChunks::chunking_for("cdc"));
+    BOOST_CHECK_THROW(ObjectChunks::chunking_for("fixed"), errors::unknown_chunking_method);
+}
+
+BOOST_AUTO_TEST_CASE(tree_layout_index_shares_directories)
+{
+    IObjectsStorage::Ptr storage(new MemoryObjectsStorage());
+
+    TreeIndex::Ptr index(new TreeIndex());
+    index->set_layout(TreeIndex::Layout_tree);
+
+    for (int i = 0; i < 60; ++i)
+    {
+        std::ostringstream path;
+        path << "d" << i % 3 << "/s" << i % 5 << "/f" << i;
+        index->insert_path(path.str(), Asset::create_for(test_utils::generate_random_string()));
+        index->set_attr_(path.str(), PredefinedAttributes::asset_type, PredefinedAttributes::asset_type__file);
+    }
+    index->insert_path("top", Asset::create_for(test_utils::generate_random_string()));
+    index->set_message_("first");
+
+    std::set<Asset> first_assets = index->assets();
+    storage->put(first_assets);
+
+    // root + 3 "dN" + 15 "dN/sM" directories, 61 files and index itself.
+    BOOST_CHECK_EQUAL(1 + 3 + 15 + 61 + 1, first_assets.size());
+
+    TreeIndex::Ptr loaded = TreeIndex::load(storage->asset(storage, index->id()), storage);
+    BOOST_CHECK(TreeIndex::Layout_tree == loaded->layout());
+    BOOST_CHECK(index->content() == loaded->content());
+    BOOST_CHECK_EQUAL("first", loaded->get_message_());
+    BOOST_CHECK(index->get_attrs_("d0/s0/f0") == loaded->get_attrs_("d0/s0/f0"));
+    BOOST_REQUIRE(loaded->directory_ids());
+    BOOST_CHECK(*index->directory_ids() == *loaded->directory_ids());
+
+    // Change one file: only its directories chain is new.
+    TreeIndex::Ptr second = TreeIndex::load(storage->asset(storage, index->id()), storage);
+    second->replace_path("d1/s1/f1", Asset::create_for(test_utils::generate_random_string()));
+    second->set_parent(loaded->self());
+
+    std::set<Asset> second_assets = second->assets();
+    std::size_t new_objects = 0;
+    for (std::set<Asset>::const_iterator i = second_assets.begin(), end = second_assets.end(); i != end; ++i)
+    {
+        if (!storage->contains(i->id())) ++new_objects;
+    }
+    // "d1/s1", "d1", root, new file and index itself.
+    BOOST_CHECK_EQUAL(5, new_objects);
+    storage->put(second_assets);
+
+    // Diff skips equal sub trees.
+    TreeIndex::Ptr second_loaded = TreeIndex::load(storage->asset(storage, second->id()), storage);
+    IndexesDiff diff = IndexesDiff::diff(loaded, second_loaded);
+
+    BOOST_REQUIRE(diff.content_diff().find("d1/s1/f1") != diff.content_diff().end());
+    BOOST_CHECK(IndexesDiff::ElementState_modified == diff.content_diff().find("d1/s1/f1")->second.first);
+    BOOST_CHECK(diff.content_diff().find("d0/s0/f0") == diff.content_diff().end());
+    BOOST_CHECK(diff.content_diff().find("top") == diff.content_diff().end());
+    BOOST_CHECK_EQUAL(1, diff.content_diff().size());
+    BOOST_CHECK(IndexesDiff::has_changes(loaded, second_loaded));
+
+    IndexesDiff flat_diff = IndexesDiff::diff(loaded, TreeIndex::load(storage->asset(storage, loaded->id()), storage));
+    BOOST_CHECK(flat_diff.empty());
+    BOOST_CHECK(flat_diff.content_diff().empty());
+}
+
+BOOST_AUTO_TEST_CASE(references_and_reflog)
+{
+    test_utils::TempFileHolder::Ptr storage_dir = test_utils::create_temp_dir();
+
+    std::vector<AssetId> ids;
+    for (int i = 0; i < 5; ++i)
+    {
+        ids.push_back(Asset::create_for(test_utils::generate_random_string()).id());
+    }
+
+    {
+        LocalDirectoryStorage storage(storage_dir->first);
+        storage.create_reference(std::make_pair(std::string("feature/x:1"), ids[0]));
+        storage.update_reference(std::make_pair(std::string("feature/x:1"), ids[1]));
+        storage.update_reference(std::make_pair(std::string("feature/x:1"), ids[2]));
+        storage.create_reference(std::make_pair(std::string("master"), ids[3]));
+
+        BOOST_CHECK_EQUAL(ids[2].string(), storage.resolve("feature/x:1").string());
+        BOOST_CHECK_THROW(storage.create_reference(std::make_pair(std::string("master"), ids[4])), errors::unable_to_insert_new_reference);
+    }
+
+    {
+        LocalDirectoryStorage storage(storage_dir->first);
+        BOOST_CHECK_EQUAL(2, storage.references().size());
+        BOOST_CHECK_EQUAL(ids[2].string(), storage.resolve("feature/x:1").string());
+        BOOST_CHECK_EQUAL(ids[3].string(), storage.resolve("master").string());
+
+        std::vector<AssetId> log = storage.reference_log("feature/x:1");
+        BOOST_REQUIRE_EQUAL(3, log.size());
+        BOOST_CHECK_EQUAL(ids[2].string(), log[0].string());
+        BOOST_CHECK_EQUAL(ids[0].string(), log[2].string());
+
+        storage.destroy_reference("master");
+        BOOST_CHECK(storage.resolve("master") == AssetId::empty);
+        BOOST_CHECK(storage.reference_log("master").empty());
+    }
+
+    // Storage created before the reference files: history most recent first.
+    test_utils::TempFileHolder::Ptr legacy_dir = test_utils::create_temp_dir();
+    fs::create_directories(legacy_dir->first / "objects");
+    {
+        std::ofstream os((legacy_dir->first / "references.properties").c_str());
+        os << "master=" << ids[1].string() << "," << ids[0].string() << std::endl;
+    }
+
+    LocalDirectoryStorage legacy(legacy_dir->first);
+    BOOST_CHECK(!fs::exists(legacy_dir->first / "references.properties"));
+    BOOST_CHECK_EQUAL(ids[1].string(), legacy.resolve("master").string());
+
+    legacy.update_reference(std::make_pair(std::string("master"), ids[2]));
+    std::vector<AssetId> log = legacy.reference_log("master");
+    BOOST_REQUIRE_EQUAL(3, log.size());
+    BOOST_CHECK_EQUAL(ids[2].string(), log[0].string());
+    BOOST_CHECK_EQUAL(ids[1].string(), log[1].string());
+    BOOST_CHECK_EQUAL(ids[0].string(), log[2].string());
+}
+
+BOOST_AUTO_TEST_CASE(layered_storage)
+{
+    test_utils::TempFileHolder::Ptr local_dir  = test_utils::create_temp_dir();
+    test_utils::TempFileHolder::Ptr shared_dir = test_utils::create_temp_dir();
+
+    IObjectsStorage::Ptr local(new LocalDirectoryStorage(local_dir->first));
+
+    Asset shared_asset = Asset::create_for(std::string("shared object data"));
+    LocalDirectoryStorage(shared_dir->first).put(shared_asset);
+
+    // Legacy references of the shared storage are not converted.
+    *fs::ostream(shared_dir->first / "references.properties") << "shared=" << shared_asset.id().string() << std::endl;
+
+    IObjectsStorage::Ptr shared(new LocalDirectoryStorage(shared_dir->first, true));
+    BOOST_CHECK(fs::exists(shared_dir->first / "references.properties"));
+    BOOST_CHECK_EQUAL(shared_asset.id().string(), shared->resolve("shared").string());
+    BOOST_CHECK_THROW(shared->put(Asset::create_for(std::string("new data"))), errors::attempt_to_modify_read_only_storage);
+    BOOST_CHECK_THROW(shared->create_reference(std::make_pair(std::string("new"), shared_asset.id())), errors::attempt_to_modify_read_only_storage);
+
+    // Read only storage doesn't create the layout.
+    test_utils::TempFileHolder::Ptr empty_dir = test_utils::create_temp_dir(0);
+    PackedDirectoryStorage empty_packed(empty_dir->first, true);
+    BOOST_CHECK(fs::is_empty(empty_dir->first));
+
+    boost::shared_ptr<LayeredStorage> layered(new LayeredStorage(local));
+    layered->add_layer(shared);
+    IObjectsStorage::Ptr storage = layered;
+
+    // Read through the layers.
+    BOOST_CHECK(storage->contains(shared_asset.id()));
+    BOOST_CHECK(!local->contains(shared_asset.id()));
+    BOOST_CHECK_EQUAL(18, storage->size_of(shared_asset.id()));
+    BOOST_CHECK_EQUAL("shared object data", test_utils::istream_content(storage->istream_for(shared_asset.id())));
+    BOOST_CHECK_EQUAL(shared_asset.id().string(), storage->resolve(shared_asset.id().string()).string());
+    BOOST_CHECK(!local->contains(shared_asset.id()));
+
+    // Lower layers files are never linked into the working copy.
+    BOOST_CHECK(storage->object_file(shared_asset.id()).empty());
+
+    // Objects of the lower layers are not stored again.
+    storage->put(shared_asset);
+    BOOST_CHECK(!local->contains(shared_asset.id()));
+
+    // New objects and references go to the local storage only.
+    Asset local_asset = Asset::create_for(std::string("local object data"));
+    storage->put(local_asset);
+    storage->create_reference(std::make_pair(std::string("master"), local_asset.id()));
+    BOOST_CHECK(local->contains(local_asset.id()));
+    BOOST_CHECK(!shared->contains(local_asset.id()));
+    BOOST_CHECK_EQUAL(1, shared->references().size());
+    BOOST_CHECK_EQUAL(local_asset.id().string(), storage->resolve("master").string());
+
+    // Promotion copies objects read from the lower layers.
+    layered->set_promotion(true);
+    BOOST_CHECK_EQUAL("shared object data", test_utils::istream_content(storage->istream_for(shared_asset.id())));
+    BOOST_CHECK(local->contains(shared_asset.id()));
+    BOOST_CHECK_EQUAL("shared object data", test_utils::istream_content(local->istream_for(shared_asset.id())));
+    BOOST_CHECK_EQUAL(local->object_file(shared_asset.id()).string(), storage->object_file(shared_asset.id()).string());
+
+    BOOST_CHECK(!storage->contains(Asset::create_for(std::string("missing")).id()));
+    BOOST_CHECK(!storage->istream_for(Asset::create_for(std::string("missing")).id()));
+}
+
+namespace {
+
+    //! Storage what counts objects checks and reads.
+    class CountingStorage: public LocalDirectoryStorage
+    {
+    public:
+        CountingStorage(const fs::path& root_dir)
+            : LocalDirectoryStorage(root_dir)
+            , checks(0)
+            , reads(0)
+        {
+        }
+
+        bool contains(const AssetId& id) const
+        {
+            ++checks;
+            return LocalDirectoryStorage::contains(id);
+        }
+
+        boost::shared_ptr<std::istream> istream_for(const AssetId& id) const
+        {
+            ++reads;
+            return LocalDirectoryStorage::istream_for(id);
+        }
+
+        mutable std::size_t checks;
+        mutable std::size_t reads;
+    };
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(tree_layout_index_expands_lazily)
+{
+    test_utils::TempFileHolder::Ptr storage_dir = test_utils::create_temp_dir();
+
+    boost::shared_ptr<CountingStorage> counting(new CountingStorage(storage_dir->first));
+    IObjectsStorage::Ptr storage = counting;
+
+    TreeIndex::Ptr index(new TreeIndex());
+    index->set_layout(TreeIndex::Layout_tree);
+    for (int i = 0; i < 20; ++i)
+    {
+        std::ostringstream path;
+        path << "d" << i % 4 << "/f" << i;
+        index->insert_path(path.str(), Asset::create_for(test_utils::generate_random_string()));
+    }
+    storage->put(index->assets());
+
+    TreeIndex::Ptr second = TreeIndex::load(storage->asset(storage, index->id()), storage);
+    second->replace_path("d1/f1", Asset::create_for(test_utils::generate_random_string()));
+    second->set_parent(storage->asset(storage, index->id()));
+    storage->put(second->assets());
+
+    // Only the index objects are read on load and on compare of the equal trees.
+    counting->reads = 0;
+    TreeIndex::Ptr first_loaded = TreeIndex::load(storage->asset(storage, index->id()), storage);
+    TreeIndex::Ptr first_again  = TreeIndex::load(storage->asset(storage, index->id()), storage);
+    BOOST_CHECK_EQUAL(2, counting->reads);
+
+    BOOST_CHECK(!IndexesDiff::has_changes(first_loaded, first_again));
+    BOOST_CHECK(IndexesDiff::diff(first_loaded, first_again).empty());
+    BOOST_CHECK_EQUAL(2, counting->reads);
+
+    // Only the root and "d1" directories of the both trees are read on diff.
+    TreeIndex::Ptr second_loaded = TreeIndex::load(storage->asset(storage, second->id()), storage);
+    BOOST_CHECK(IndexesDiff::has_changes(first_loaded, second_loaded));
+
+    IndexesDiff diff = IndexesDiff::diff(first_loaded, second_loaded);
+    BOOST_CHECK_EQUAL(3 + 4, counting->reads);
+    BOOST_REQUIRE_EQUAL(1, diff.content_diff().size());
+    BOOST_CHECK_EQUAL("d1/f1", diff.content_diff().begin()->first);
+    BOOST_CHECK(IndexesDiff::ElementState_modified == diff.content_diff().begin()->second.first);
+    BOOST_CHECK(diff.content_attributes_diff().empty());
+
+    // Content access expands the whole tree.
+    BOOST_CHECK(index->content() == first_loaded->content());
+    BOOST_CHECK(second->content() == second_loaded->content());
+    BOOST_CHECK_EQUAL(3 + 4 + 5 + 5, counting->reads);
+    BOOST_CHECK(*index->directory_ids() == *first_loaded->directory_ids());
+}
+
+BOOST_AUTO_TEST_CASE(objects_sync)
+{
+    test_utils::TempFileHolder::Ptr local_dir  = test_utils::create_temp_dir();
+    test_utils::TempFileHolder::Ptr remote_dir = test_utils::create_temp_dir();
+    test_utils::TempFileHolder::Ptr clone_dir  = test_utils::create_temp_dir();
+
+    IObjectsStorage::Ptr local(new LocalDirectoryStorage(local_dir->first));
+    boost::shared_ptr<CountingStorage> counting_remote(new CountingStorage(remote_dir->first));
+    IObjectsStorage::Ptr remote = counting_remote;
+    IObjectsStorage::Ptr clone(new LocalDirectoryStorage(clone_dir->first));
+
+    TreeIndex::Ptr index(new TreeIndex());
+    for (int i = 0; i < 20; ++i)
+    {
+        index->insert_path("f" + boost::lexical_cast<std::string>(i), Asset::create_for(test_utils::generate_random_string()));
+    }
+    local->put(index->assets());
+    local->create_reference(std::make_pair(std::string("master"), index->id()));
+
+    // 20 files and index.
+    BOOST_CHECK_EQUAL(21, ObjectsSync::push(local, remote, "master"));
+    BOOST_CHECK_EQUAL(index->id().string(), remote->resolve("master").string());
+    BOOST_CHECK_EQUAL(0, ObjectsSync::push(local, remote, "master"));
+
+    BOOST_CHECK_EQUAL(21, ObjectsSync::pull(remote, clone, "master"));
+    BOOST_CHECK_EQUAL(index->id().string(), clone->resolve("master").string());
+
+    // Only the changed file and index are transferred, files of the previous tree are not checked.
+    TreeIndex::Ptr second = TreeIndex::load(local->asset(local, index->id()), local);
+    second->replace_path("f3", Asset::create_for(test_utils::generate_random_string()));
+    second->set_parent(index->self());
+    local->put(second->assets());
+    local->update_reference(std::make_pair(std::string("master"), second->id()));
+
+    counting_remote->checks = 0;
+    BOOST_CHECK_EQUAL(2, ObjectsSync::push(local, remote, "master"));
+    // Index and changed file are checked by transfer and by put itself.
+    BOOST_CHECK_EQUAL(4, counting_remote->checks);
+    BOOST_CHECK_EQUAL(second->id().string(), remote->resolve("master").string());
+
+    BOOST_CHECK_EQUAL(2, ObjectsSync::pull(remote, clone, "master"));
+    BOOST_CHECK_EQUAL(second->id().string(), clone->resolve("master").string());
+
+    TreeIndex::Ptr cloned = TreeIndex::from_ref(clone, "master");
+    BOOST_CHECK(second->content().size() == cloned->content().size());
+    BOOST_CHECK_EQUAL(test_utils::istream_content(second->asset("f3")->istream()),
+            test_utils::istream_content(cloned->asset("f3")->istream()));
+
+    // Object what data doesn't match its id is not accepted.
+    TreeIndex::Ptr third = TreeIndex::load(local->asset(local, second->id()), local);
+    Asset corrupted = Asset::create_for(test_utils::generate_random_string());
+    third->replace_path("f5", corrupted);
+    third->set_parent(second->self());
+    local->put(third->assets());
+    local->update_reference(std::make_pair(std::string("master"), third->id()));
+    BOOST_CHECK_EQUAL(2, ObjectsSync::push(local, remote, "master"));
+
+    fs::path remote_object = remote->object_file(corrupted.id());
+    BOOST_REQUIRE(!remote_object.empty());
+    *fs::ostream(remote_object) << "truncated";
+
+    BOOST_CHECK_THROW(ObjectsSync::pull(remote, clone, "master"), errors::remote_storage_error);
+    BOOST_CHECK(!clone->contains(corrupted.id()));
+    BOOST_CHECK(!clone->contains(Asset::create_for(std::string("truncated")).id()));
+    BOOST_CHECK_EQUAL(second->id().string(), clone->resolve("master").string());
+    BOOST_CHECK(fs::is_empty(clone_dir->first / "tmp"));
+
+    BOOST_CHECK_THROW(ObjectsSync::push(local, remote, "unknown"), errors::unknown_sync_reference);
+}
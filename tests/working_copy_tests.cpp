@@ -39,6 +39,7 @@
 #include <clean.h>
 #include <checkout.h>
 #include <reset.h>
+#include <status.h>
 
 #include <treeenumerator.h>
 #include <treeindexenumerator.h>
@@ -151,6 +152,229 @@ BOOST_AUTO_TEST_CASE(checkout_tests)
     checkout();
 }
 
+BOOST_AUTO_TEST_CASE(incremental_checkout)
+{
+    lib::test_utils::DirState state_1;
+    state_1["same_file"]            = "same content";
+    state_1["modified_file"]        = "content 1";
+    state_1["removed_file"]         = "removed content";
+    state_1["mode_file"]            = "mode content";
+    state_1["removed_dir/file"]     = "removed dir content";
+
+    lib::test_utils::DirState state_2;
+    state_2["same_file"]            = "same content";
+    state_2["modified_file"]        = "content 2";
+    state_2["mode_file"]            = "mode content";
+    state_2["added_dir/file"]       = "added dir content";
+
+    lib::test_utils::TempFileHolder::Ptr wc_path = lib::test_utils::create_temp_dir();
+
+    lib::WorkingCopy::Ptr wc = lib::WorkingCopy::init(wc_path->first, ref_name_1);
+    lib::test_utils::make_directory_state(wc->working_dir(), wc->metadata_dir(), state_1);
+
+    cmd::Commit commit_1(wc);
+    commit_1.set_message("Commit to " + ref_name_1);
+    commit_1();
+
+    cmd::Create create(wc, ref_name_2);
+    create();
+
+    lib::test_utils::make_directory_state(wc->working_dir(), wc->metadata_dir(), state_2);
+    fs::permissions(wc->working_dir() / "mode_file", fs::owner_read|fs::owner_write|fs::owner_exe);
+
+    cmd::Commit commit_2(wc);
+    commit_2.set_message("Commit to " + ref_name_2);
+    commit_2();
+
+    std::time_t same_file_time = std::time(0) - 3600;
+    fs::last_write_time(wc->working_dir() / "same_file", same_file_time);
+
+    cmd::Checkout checkout_1(wc, ref_name_1);
+    checkout_1();
+
+    BOOST_CHECK(state_1 == lib::test_utils::get_directory_state(wc->working_dir(), wc->metadata_dir()));
+    BOOST_CHECK(!fs::exists(wc->working_dir() / "added_dir"));
+    BOOST_CHECK(!(fs::status(wc->working_dir() / "mode_file").permissions() & fs::owner_exe));
+
+    // Unchanged file is not rewritten.
+    BOOST_CHECK_EQUAL(same_file_time, fs::last_write_time(wc->working_dir() / "same_file"));
+
+    cmd::Checkout checkout_2(wc, ref_name_2);
+    checkout_2();
+
+    BOOST_CHECK(state_2 == lib::test_utils::get_directory_state(wc->working_dir(), wc->metadata_dir()));
+    BOOST_CHECK(!fs::exists(wc->working_dir() / "removed_dir"));
+    BOOST_CHECK(fs::status(wc->working_dir() / "mode_file").permissions() & fs::owner_exe);
+    BOOST_CHECK_EQUAL(same_file_time, fs::last_write_time(wc->working_dir() / "same_file"));
+}
+
+BOOST_AUTO_TEST_CASE(status_attributes_only_change)
+{
+    lib::test_utils::DirState state;
+    state["mode_file"]      = "mode content";
+    state["same_file"]      = "same content";
+
+    lib::test_utils::TempFileHolder::Ptr wc_path = lib::test_utils::create_temp_dir();
+
+    lib::WorkingCopy::Ptr wc = lib::WorkingCopy::init(wc_path->first, ref_name_1);
+    lib::test_utils::make_directory_state(wc->working_dir(), wc->metadata_dir(), state);
+    fs::permissions(wc->working_dir() / "mode_file", fs::owner_read|fs::owner_write);
+
+    cmd::Commit commit(wc);
+    commit.set_message("Commit to " + ref_name_1);
+    commit();
+
+    std::ostringstream clean_out;
+    cmd::Status clean_status(wc);
+    clean_status.setup_iostreams(&clean_out, &std::cerr, &std::cin);
+    BOOST_CHECK_EQUAL(cmd::Status::Status_clean, clean_status());
+    BOOST_CHECK(clean_out.str().empty());
+
+    // Same content, different mode.
+    fs::permissions(wc->working_dir() / "mode_file", fs::owner_read|fs::owner_write|fs::owner_exe);
+
+    std::ostringstream dirty_out;
+    cmd::Status dirty_status(wc);
+    dirty_status.setup_iostreams(&dirty_out, &std::cerr, &std::cin);
+    BOOST_CHECK_EQUAL(cmd::Status::Status_dirty, dirty_status());
+    BOOST_CHECK(dirty_out.str().find("M mode_file") != std::string::npos);
+    BOOST_CHECK(dirty_out.str().find("same_file") == std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_extraction)
+{
+    lib::test_utils::TempFileHolder::Ptr wc_path = lib::test_utils::create_temp_dir(100);
+
+    lib::WorkingCopy::Ptr wc = lib::WorkingCopy::init(wc_path->first, ref_name_1);
+
+    cmd::Commit commit(wc);
+    commit.set_message("Commit to " + ref_name_1);
+    commit();
+
+    lib::test_utils::DirState state = lib::test_utils::get_directory_state(wc->working_dir(), wc->metadata_dir());
+
+    lib::TreeIndex::Ptr index = lib::TreeIndex::from_ref(wc->local_storage(), ref_name_1);
+    BOOST_REQUIRE(index);
+
+    lib::test_utils::TempFileHolder::Ptr serial_path = lib::test_utils::create_temp_dir(0);
+    lib::AssetsExtractor serial(index);
+    serial.extract_into(serial_path->first);
+
+    lib::test_utils::TempFileHolder::Ptr parallel_path = lib::test_utils::create_temp_dir(0);
+    lib::AssetsExtractor parallel(index);
+    parallel.set_threads_count(4);
+    parallel.extract_into(parallel_path->first);
+
+    BOOST_CHECK(state == lib::test_utils::get_directory_state(serial_path->first, fs::path()));
+    BOOST_CHECK(state == lib::test_utils::get_directory_state(parallel_path->first, fs::path()));
+
+    // Non readable asset is reported after all workers are done.
+    lib::TreeIndex::Ptr broken(new lib::TreeIndex());
+    broken->insert_path("a/readable", lib::Asset::create_for(lib::test_utils::generate_random_string()));
+    broken->insert_path("b/non_readable", lib::Asset::create_id(lib::Asset::create_for(std::string("data")).id()));
+    broken->insert_path("c/readable", lib::Asset::create_for(lib::test_utils::generate_random_string()));
+
+    lib::test_utils::TempFileHolder::Ptr broken_path = lib::test_utils::create_temp_dir(0);
+    lib::AssetsExtractor broken_extractor(broken);
+    broken_extractor.set_threads_count(2);
+    BOOST_CHECK_THROW(broken_extractor.extract_into(broken_path->first), lib::errors::attempt_to_export_non_readable_asset);
+    BOOST_CHECK(fs::exists(broken_path->first / "c" / "readable"));
+}
+
+BOOST_AUTO_TEST_CASE(zero_copy_extraction)
+{
+    lib::test_utils::TempFileHolder::Ptr wc_path = lib::test_utils::create_temp_dir(10);
+
+    lib::WorkingCopy::Ptr wc = lib::WorkingCopy::init(wc_path->first, ref_name_1);
+
+    // Executable file has the mode different from the object file one.
+    *fs::ostream(wc->working_dir() / "zz_exe_file") << "executable content";
+    fs::permissions(wc->working_dir() / "zz_exe_file", fs::owner_read|fs::owner_write|fs::owner_exe);
+
+    cmd::Commit commit(wc);
+    commit.set_message("Commit to " + ref_name_1);
+    commit();
+
+    lib::test_utils::DirState state = lib::test_utils::get_directory_state(wc->working_dir(), wc->metadata_dir());
+
+    lib::TreeIndex::Ptr index = lib::TreeIndex::from_ref(wc->local_storage(), ref_name_1);
+    BOOST_REQUIRE(index);
+    BOOST_REQUIRE(!index->content().empty());
+    BOOST_CHECK(!index->content().begin()->second.file_path().empty());
+
+    fs::path exe_object = index->content().find("zz_exe_file")->second.file_path();
+    BOOST_REQUIRE(!exe_object.empty());
+    fs::perms exe_object_mode = fs::status(exe_object).permissions();
+
+    // Clone falls back to the copy if the file system doesn't support it.
+    lib::test_utils::TempFileHolder::Ptr clone_path = lib::test_utils::create_temp_dir(0);
+    lib::AssetsExtractor clone(index, lib::ExtractPolitic(lib::ExtractPolicy__replace_existing | lib::AssetsExtractor::extract_mode("clone")));
+    clone.extract_into(clone_path->first);
+    BOOST_CHECK(state == lib::test_utils::get_directory_state(clone_path->first, fs::path()));
+    BOOST_CHECK_EQUAL(1, fs::hard_link_count(clone_path->first / index->content().begin()->first));
+
+    lib::test_utils::TempFileHolder::Ptr link_path = lib::test_utils::create_temp_dir(0);
+    lib::AssetsExtractor link(index, lib::ExtractPolitic(lib::ExtractPolicy__replace_existing | lib::AssetsExtractor::extract_mode("hardlink")));
+    link.set_threads_count(2);
+    link.extract_into(link_path->first);
+    BOOST_CHECK(state == lib::test_utils::get_directory_state(link_path->first, fs::path()));
+    BOOST_CHECK_EQUAL(2, fs::hard_link_count(link_path->first / index->content().begin()->first));
+
+    // Object file mode is never changed, the item with the different mode is copied.
+    BOOST_CHECK_EQUAL(1, fs::hard_link_count(link_path->first / "zz_exe_file"));
+    BOOST_CHECK(fs::status(link_path->first / "zz_exe_file").permissions() & fs::owner_exe);
+    BOOST_CHECK_EQUAL(exe_object_mode, fs::status(exe_object).permissions());
+
+    BOOST_CHECK_THROW(lib::AssetsExtractor::extract_mode("unknown"), lib::errors::unknown_extract_mode);
+
+    // Corrupted object is not cloned silently.
+    *fs::ostream(exe_object) << "corrupted content";
+
+    lib::test_utils::TempFileHolder::Ptr corrupted_path = lib::test_utils::create_temp_dir(0);
+    lib::AssetsExtractor corrupted(index, lib::ExtractPolitic(lib::ExtractPolicy__replace_existing | lib::AssetsExtractor::extract_mode("clone")));
+    corrupted.set_threads_count(2);
+    BOOST_CHECK_THROW(corrupted.extract_into(corrupted_path->first), lib::errors::exported_data_is_corrupted);
+}
+
+BOOST_AUTO_TEST_CASE(blake3_repository)
+{
+    lib::test_utils::DirState state;
+    state["file"]       = "blake3 repository content";
+    state["dir/file"]   = "dir content";
+
+    lib::test_utils::TempFileHolder::Ptr wc_path = lib::test_utils::create_temp_dir();
+
+    lib::WorkingCopy::Ptr wc = lib::WorkingCopy::init(wc_path->first, ref_name_1, lib::AssetId::Algorithm_blake3);
+    lib::test_utils::make_directory_state(wc->working_dir(), wc->metadata_dir(), state);
+
+    cmd::Commit commit(wc);
+    commit.set_message("Commit to " + ref_name_1);
+    commit();
+
+    BOOST_CHECK_EQUAL("ae9875cd930f49e4236e2ce1e0900c56c0ff6e33150bd5686f340afa4d08ca64",
+            wc->current_tree_state()->asset("file")->id().string());
+
+    // Attach selects the algorithm recorded by the repository.
+    lib::AssetId::set_algorithm(lib::AssetId::Algorithm_sha256);
+    lib::WorkingCopy::Ptr attached = lib::WorkingCopy::attach(wc_path->first);
+    BOOST_CHECK_EQUAL(lib::AssetId::Algorithm_blake3, lib::AssetId::algorithm());
+    BOOST_CHECK_EQUAL(wc->current_tree_state()->id().string(), attached->current_tree_state()->id().string());
+
+    fs::remove_all(attached->working_dir() / "dir");
+    cmd::Checkout checkout(attached, ref_name_1);
+    checkout.set_force(true);
+    checkout();
+    BOOST_CHECK(state == lib::test_utils::get_directory_state(attached->working_dir(), attached->metadata_dir()));
+
+    // Index records the algorithm of its ids.
+    std::ostringstream index_data;
+    attached->current_tree_state()->store(index_data);
+
+    lib::AssetId::set_algorithm(lib::AssetId::Algorithm_sha256);
+    std::istringstream is(index_data.str());
+    BOOST_CHECK_THROW(lib::TreeIndex::load(is), lib::errors::index_id_algorithm_mismatch);
+}
+
 BOOST_AUTO_TEST_CASE(enumerator_test)
 {
     lib::test_utils::DirState init_state;
@@ -4,13 +4,18 @@
 //#include <fsindexer.h>
 //#include <zipindexer.h>
 #include <zip.h>
+#include <algorithm>
 #include <map>
 #include <vector>
 #include <zipfile.h>
+#include <zipwriter.h>
+#include <streampipe.h>
 #include "fstream"
 #include "logging.h"
 
 #include <boost/format.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
 
 
 #include "test_utils.hpp"
@@ -414,6 +419,280 @@ BOOST_AUTO_TEST_CASE(Zip_CxxAPI_buffer_istream)
     LOGI  << "---FINISH Zip_CxxAPI_buffer_istream---" << ELOG;
 }
 
+BOOST_AUTO_TEST_CASE(Zip_Writer_threads)
+{
+    LOGI << "+++START Zip_Writer_threads +++" << ELOG;
+
+    tst::TempFileHolder::Ptr tmp_dir = tst::create_temp_dir();
+    boost::filesystem::path zip_path = tmp_dir->first / zip_name;
+
+    // Pseudo random data is not compressible, so the entry is spilled into the temporary file.
+    std::string large(17 * 1024 * 1024, '\0');
+    unsigned int seed = 1;
+    for (std::string::iterator i = large.begin(), end = large.end(); i != end; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        *i   = static_cast<char>(seed >> 16);
+    }
+
+    std::map<std::string, std::pair<std::string, int> > entries;
+    entries["empty"]                = std::make_pair(std::string(), 0644);
+    entries["dir/executable"]       = std::make_pair(std::string("#!/bin/sh\necho test\n"), 0755);
+    entries["dir/\xd1\x84\xd0\xb0\xd0\xb9\xd0\xbb"] = std::make_pair(std::string(1000, 'a'), 0600);
+    entries["large"]                = std::make_pair(large, 0644);
+    for (int i = 0; i < 20; ++i)
+    {
+        entries[(boost::format("file_%1%") % i).str()] = std::make_pair((boost::format("file %1% content") % i).str(), 0644);
+    }
+
+    {
+        std::ofstream os(zip_path.c_str(), std::ofstream::out|std::ofstream::binary);
+        lib::ZipWriter zip(os, tmp_dir->first);
+        zip.set_threads_count(4);
+
+        for (std::map<std::string, std::pair<std::string, int> >::const_iterator i = entries.begin(), end = entries.end(); i != end; ++i)
+        {
+            zip.add(i->first, lib::Asset::create_for(i->second.first), i->second.second);
+        }
+
+        unsigned long long written = zip.write();
+        os.close();
+
+        BOOST_CHECK_EQUAL(written, fs::file_size(zip_path));
+    }
+
+    lib::ZipFile::FilePtr zip = lib::ZipFile::open(zip_path.string());
+    BOOST_CHECK_EQUAL(zip->num_entries(), static_cast<zip_int64_t>(entries.size()));
+
+    for (zip_int64_t i = 0; i < zip->num_entries(); i++)
+    {
+        lib::ZipFile::EntryPtr entry = zip->entry(i);
+
+        std::map<std::string, std::pair<std::string, int> >::const_iterator it = entries.find(entry->name());
+        BOOST_REQUIRE(it != entries.end());
+
+        BOOST_CHECK_EQUAL(entry->stat().size, it->second.first.size());
+        BOOST_CHECK_EQUAL(static_cast<int>(entry->attributes().mode() & 0777), it->second.second);
+
+        std::vector<char> buffer(it->second.first.size());
+        if (!buffer.empty())
+        {
+            BOOST_CHECK_EQUAL(entry->read(buffer.data(), static_cast<zip_int64_t>(buffer.size())), static_cast<zip_int64_t>(buffer.size()));
+        }
+        BOOST_CHECK(std::string(buffer.begin(), buffer.end()) == it->second.first);
+    }
+
+    // Nothing is left in the temporary directory except the archive.
+    BOOST_CHECK_EQUAL(std::distance(fs::directory_iterator(tmp_dir->first), fs::directory_iterator()), 1);
+
+    LOGI << "---FINISH Zip_Writer_threads ---" << ELOG;
+}
+
+// Reading end of the pipe, runs on the separate thread, so doesn't log.
+static void read_pipe(lib::StreamPipe::Ptr pipe, std::string *data, std::size_t limit)
+{
+    boost::shared_ptr<std::istream> is = pipe->istream();
+    std::vector<char> buffer(4096);
+    while (data->size() < limit && is->read(buffer.data(), buffer.size()).gcount() > 0)
+    {
+        data->append(buffer.data(), static_cast<std::size_t>(is->gcount()));
+    }
+    pipe->close_read();
+}
+
+static void add_pipe_entries(lib::ZipWriter& zip)
+{
+    for (int i = 0; i < 50; ++i)
+    {
+        zip.add((boost::format("dir/file_%02d") % i).str(), lib::Asset::create_for(std::string(10000 + i, static_cast<char>('a' + i % 26))), 0644);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Zip_Writer_pipe)
+{
+    LOGI << "+++START Zip_Writer_pipe +++" << ELOG;
+
+    tst::TempFileHolder::Ptr tmp_dir = tst::create_temp_dir();
+    boost::filesystem::path zip_path = tmp_dir->first / zip_name;
+
+    // Small pipe, so the writer is blocked by the reader.
+    lib::StreamPipe::Ptr pipe = lib::StreamPipe::create(1024);
+    std::string streamed;
+    boost::thread reader(boost::bind(&read_pipe, pipe, &streamed, std::string::npos));
+    unsigned long long written = 0;
+    {
+        boost::shared_ptr<std::ostream> os = pipe->ostream();
+        lib::ZipWriter zip(*os, tmp_dir->first);
+        zip.set_threads_count(2);
+        add_pipe_entries(zip);
+        written = zip.write();
+    }
+    pipe->close();
+    reader.join();
+
+    BOOST_CHECK_EQUAL(written, streamed.size());
+
+    {
+        std::ofstream os(zip_path.c_str(), std::ofstream::out|std::ofstream::binary);
+        os.write(streamed.data(), streamed.size());
+    }
+
+    lib::ZipFile::FilePtr zip = lib::ZipFile::open(zip_path.string());
+    BOOST_CHECK_EQUAL(zip->num_entries(), 50);
+    for (zip_int64_t i = 0; i < zip->num_entries(); i++)
+    {
+        lib::ZipFile::EntryPtr entry = zip->entry(i);
+        std::vector<char> buffer(static_cast<std::size_t>(entry->stat().size));
+        BOOST_CHECK_EQUAL(entry->read(buffer.data(), static_cast<zip_int64_t>(buffer.size())), static_cast<zip_int64_t>(buffer.size()));
+        BOOST_CHECK_EQUAL(buffer.size(), static_cast<std::size_t>(10000 + i));
+    }
+
+    // Writing fails when the reader has stopped.
+    lib::StreamPipe::Ptr broken_pipe = lib::StreamPipe::create(1024);
+    std::string partial;
+    boost::thread partial_reader(boost::bind(&read_pipe, broken_pipe, &partial, 4096));
+    {
+        boost::shared_ptr<std::ostream> os = broken_pipe->ostream();
+        lib::ZipWriter zip(*os, tmp_dir->first);
+        add_pipe_entries(zip);
+
+        BOOST_CHECK_THROW(zip.write(), lib::errors::unable_to_write_zip);
+    }
+    broken_pipe->abort();
+    partial_reader.join();
+
+    LOGI << "---FINISH Zip_Writer_pipe ---" << ELOG;
+}
+
+static std::string write_zip_with_threads(const boost::filesystem::path& temp_dir, unsigned int threads, bool reverse)
+{
+    std::vector<std::string> names;
+    for (int i = 0; i < 30; ++i)
+    {
+        names.push_back((boost::format("dir_%1%/file_%2%") % (i % 3) % i).str());
+    }
+    if (reverse)
+    {
+        std::reverse(names.begin(), names.end());
+    }
+
+    std::ostringstream os;
+    lib::ZipWriter zip(os, temp_dir);
+    zip.set_threads_count(threads);
+    for (std::vector<std::string>::const_iterator i = names.begin(), end = names.end(); i != end; ++i)
+    {
+        zip.add(*i, lib::Asset::create_for(*i + " content"), 0644);
+    }
+    zip.write();
+    return os.str();
+}
+
+BOOST_AUTO_TEST_CASE(Zip_Writer_reproducible)
+{
+    LOGI << "+++START Zip_Writer_reproducible +++" << ELOG;
+
+    tst::TempFileHolder::Ptr tmp_dir = tst::create_temp_dir();
+
+    std::string first = write_zip_with_threads(tmp_dir->first, 1, false);
+
+    // Archive doesn't depend on the time, threads count and entries order.
+    boost::this_thread::sleep(boost::posix_time::milliseconds(2100));
+    BOOST_CHECK(first == write_zip_with_threads(tmp_dir->first, 4, true));
+
+    boost::filesystem::path zip_path = tmp_dir->first / zip_name;
+    {
+        std::ofstream os(zip_path.c_str(), std::ofstream::out|std::ofstream::binary);
+        os.write(first.data(), first.size());
+    }
+
+    lib::ZipFile::FilePtr zip = lib::ZipFile::open(zip_path.string());
+    std::string previous;
+    for (zip_int64_t i = 0; i < zip->num_entries(); i++)
+    {
+        std::string name = zip->entry(i)->name();
+        BOOST_CHECK(previous < name);
+        previous = name;
+    }
+
+    LOGI << "---FINISH Zip_Writer_reproducible ---" << ELOG;
+}
+
+static std::map<std::string, zip_uint16_t> write_zip_with_level(const boost::filesystem::path& temp_dir, int level, const std::map<std::string, std::string>& files)
+{
+    boost::filesystem::path zip_path = temp_dir / zip_name;
+    {
+        std::ofstream os(zip_path.c_str(), std::ofstream::out|std::ofstream::binary|std::ofstream::trunc);
+        lib::ZipWriter zip(os, temp_dir);
+        zip.set_level(level);
+        for (std::map<std::string, std::string>::const_iterator i = files.begin(), end = files.end(); i != end; ++i)
+        {
+            zip.add(i->first, lib::Asset::create_for(i->second), 0644);
+        }
+        zip.write();
+    }
+
+    std::map<std::string, zip_uint16_t> methods;
+    lib::ZipFile::FilePtr zip = lib::ZipFile::open(zip_path.string());
+    for (zip_int64_t i = 0; i < zip->num_entries(); i++)
+    {
+        lib::ZipFile::EntryPtr entry = zip->entry(i);
+        BOOST_CHECK(files.at(entry->name()) == lib::test_utils::istream_content(entry->istream()));
+        methods[entry->name()] = entry->stat().comp_method;
+    }
+    return methods;
+}
+
+BOOST_AUTO_TEST_CASE(Zip_Writer_store_policy)
+{
+    LOGI << "+++START Zip_Writer_store_policy +++" << ELOG;
+
+    tst::TempFileHolder::Ptr tmp_dir = tst::create_temp_dir();
+
+    std::string text;
+    for (int i = 0; i < 1000; ++i)
+    {
+        text += (boost::format("line %1%\n") % i).str();
+    }
+
+    std::string noise(100 * 1024, 0);
+    boost::uint32_t seed = 1;
+    for (std::string::iterator i = noise.begin(), end = noise.end(); i != end; ++i)
+    {
+        seed = seed * 1664525 + 1013904223;
+        *i = static_cast<char>(seed >> 24);
+    }
+
+    std::map<std::string, std::string> files;
+    files["empty"]          = std::string();
+    files["text.txt"]       = text;
+    files["noise.bin"]      = noise;
+    files["image.PNG"]      = text;
+
+    // Compressed formats and badly compressible data are stored.
+    std::map<std::string, zip_uint16_t> methods = write_zip_with_level(tmp_dir->first, -1, files);
+    BOOST_CHECK_EQUAL(ZIP_CM_STORE,     methods["empty"]);
+    BOOST_CHECK_EQUAL(ZIP_CM_DEFLATE,   methods["text.txt"]);
+    BOOST_CHECK_EQUAL(ZIP_CM_STORE,     methods["noise.bin"]);
+    BOOST_CHECK_EQUAL(ZIP_CM_STORE,     methods["image.PNG"]);
+
+    methods = write_zip_with_level(tmp_dir->first, 1, files);
+    BOOST_CHECK_EQUAL(ZIP_CM_DEFLATE,   methods["text.txt"]);
+    BOOST_CHECK_EQUAL(ZIP_CM_STORE,     methods["noise.bin"]);
+
+    // Level 0 stores everything.
+    methods = write_zip_with_level(tmp_dir->first, 0, files);
+    BOOST_CHECK_EQUAL(ZIP_CM_STORE,     methods["text.txt"]);
+
+    // Levels out of the zlib range are rejected before any entry is deflated.
+    std::ostringstream os;
+    lib::ZipWriter zip(os, tmp_dir->first);
+    BOOST_CHECK_THROW(zip.set_level(10), lib::errors::unsupported_deflate_level);
+    BOOST_CHECK_THROW(zip.set_level(-2), lib::errors::unsupported_deflate_level);
+    BOOST_CHECK_NO_THROW(zip.set_level(9));
+
+    LOGI << "---FINISH Zip_Writer_store_policy ---" << ELOG;
+}
+
 DBOOST_AUTO_TEST_CASE(Zip_created)
 {
     // Create archive